@@ -23,6 +23,7 @@ set includes= /I src ^
               /I dependencies\miniz\include
 
 set libs= shell32.lib                     ^
+          ws2_32.lib                      ^
           user32.lib                      ^
           gdi32.lib                       ^
           openGL32.lib                    ^
@@ -0,0 +1,381 @@
+#include "autodiff.h"
+
+#include <cmath>
+#include <cstdio>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/float_format.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "compiled.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+constexpr u32 NO_NODE = 0xFFFFFFFF;
+
+void operator_partials(OperatorCode code, const f64 operands[], f64 result, f64 partials[])
+{
+    const f64 a = operands[0];
+    const f64 b = operands[1];
+
+    switch (code)
+    {
+        case OperatorCode::NEG:
+            partials[0] = -1.0;
+            break;
+
+        case OperatorCode::MULTIPLY:
+            partials[0] = b;
+            partials[1] = a;
+            break;
+
+        case OperatorCode::DIVIDE:
+            partials[0] = 1.0 / b;
+            partials[1] = -a / (b * b);
+            break;
+
+        // fmod(a, b) = a - trunc(a / b) * b
+        case OperatorCode::REMAINDER:
+            partials[0] = 1.0;
+            partials[1] = -trunc(a / b);
+            break;
+
+        case OperatorCode::ADD:
+            partials[0] = 1.0;
+            partials[1] = 1.0;
+            break;
+
+        case OperatorCode::SUBTRACT:
+            partials[0] = 1.0;
+            partials[1] = -1.0;
+            break;
+
+        // The exponent only has a derivative where the logarithm of the base exists
+        case OperatorCode::POW:
+            partials[0] = (b == 0.0) ? 0.0 : b * pow(a, b - 1.0);
+            partials[1] = (a > 0.0) ? result * log(a) : 0.0;
+            break;
+
+        case OperatorCode::AND:
+        case OperatorCode::OR:
+        case OperatorCode::GREATER:
+        case OperatorCode::LESSER:
+        case OperatorCode::GREATER_EQUAL:
+        case OperatorCode::LESSER_EQUAL:
+        case OperatorCode::EQUAL:
+        case OperatorCode::NOT_EQUAL:
+            partials[0] = 0.0;
+            partials[1] = 0.0;
+            break;
+
+        case OperatorCode::NOT:
+            partials[0] = 0.0;
+            break;
+
+        case OperatorCode::NATURAL_LOG:
+            partials[0] = 1.0 / a;
+            break;
+
+        // log(a, b) = ln(b) / ln(a)
+        case OperatorCode::LOG:
+            partials[0] = -result / (a * log(a));
+            partials[1] = 1.0 / (b * log(a));
+            break;
+
+        case OperatorCode::SIN:
+            partials[0] = cos(a);
+            break;
+
+        case OperatorCode::COS:
+            partials[0] = -sin(a);
+            break;
+
+        case OperatorCode::TAN:
+            partials[0] = 1.0 + result * result;
+            break;
+
+        case OperatorCode::SEC:
+            partials[0] = result * tan(a);
+            break;
+
+        case OperatorCode::COSEC:
+            partials[0] = -result / tan(a);
+            break;
+
+        case OperatorCode::COT:
+            partials[0] = -(1.0 + result * result);
+            break;
+
+        case OperatorCode::SINH:
+            partials[0] = cosh(a);
+            break;
+
+        case OperatorCode::COSH:
+            partials[0] = sinh(a);
+            break;
+
+        case OperatorCode::TANH:
+            partials[0] = 1.0 - result * result;
+            break;
+
+        case OperatorCode::SQRT:
+            partials[0] = 0.5 / result;
+            break;
+
+        case OperatorCode::EXP:
+            partials[0] = result;
+            break;
+
+        // Same choice of operand as the operators
+        case OperatorCode::MAX:
+            partials[0] = (a > b) ? 1.0 : 0.0;
+            partials[1] = (a > b) ? 0.0 : 1.0;
+            break;
+
+        case OperatorCode::MIN:
+            partials[0] = (a < b) ? 1.0 : 0.0;
+            partials[1] = (a < b) ? 0.0 : 1.0;
+            break;
+
+        case OperatorCode::COND:
+            partials[0] = 0.0;
+            partials[1] = a ? 1.0 : 0.0;
+            partials[2] = a ? 0.0 : 1.0;
+            break;
+
+        default:
+            gn_assert_with_message(false, "Operator doesn't have a derivative! (code: %)", (u32) code);
+            break;
+    }
+}
+
+Dual apply_operator(const Operator& op, const Dual operands[])
+{
+    f64 values[3];
+    for (u32 i = 0; i < op.operand_count; i++)
+        values[i] = operands[i].value;
+
+    Dual result;
+    result.value = op.operation(values);
+
+    f64 partials[3];
+    operator_partials(op.code, values, result.value, partials);
+
+    // Operands that don't depend on the variable are skipped so infinite partials don't turn into NaN
+    result.derivative = 0.0;
+    for (u32 i = 0; i < op.operand_count; i++)
+    {
+        if (operands[i].derivative != 0.0)
+            result.derivative += partials[i] * operands[i].derivative;
+    }
+
+    return result;
+}
+
+f64 evaluate_derivative(const CompiledExpression& compiled, const f64 variables[], u32 variable_index, f64& derivative,
+                        DynamicArray<Dual>& dual_stack)
+{
+    const DynamicArray<ExpressionElement>& expression = compiled.elements;
+    clear(dual_stack);
+
+    Dual operands[3];   // Max operand count in functions is 3
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        switch (expression[i].type)
+        {
+            case ExpressionElement::Type::NUMBER:
+            {
+                append(dual_stack, Dual { expression[i].value, 0.0 });
+            } break;
+
+            case ExpressionElement::Type::VARIABLE:
+            {
+                const u32 index = expression[i].variable.index;
+                append(dual_stack, Dual { variables[index], (index == variable_index) ? 1.0 : 0.0 });
+            } break;
+
+            case ExpressionElement::Type::OPERATOR:
+            {
+                const Operator& op = get_operator(expression[i].op_code);
+
+                dual_stack.size -= op.operand_count;
+                for (u32 j = 0; j < op.operand_count; j++)
+                    operands[j] = dual_stack.data[dual_stack.size + j];
+
+                append(dual_stack, apply_operator(op, operands));
+            } break;
+        }
+    }
+
+    gn_assert_with_message(dual_stack.size == 1, "Number stack has extra values! (numbers left: %)", dual_stack.size);
+
+    derivative = dual_stack[0].derivative;
+    return dual_stack[0].value;
+}
+
+GradientTape make_gradient_tape(u64 node_capacity)
+{
+    GradientTape tape;
+    tape.nodes       = make<DynamicArray<TapeNode>>(node_capacity);
+    tape.adjoints    = make<DynamicArray<f64>>(node_capacity);
+    tape.values      = make<DynamicArray<f64>>(16Ui64);
+    tape.value_nodes = make<DynamicArray<u32>>(16Ui64);
+
+    return tape;
+}
+
+void free(GradientTape& tape)
+{
+    free(tape.value_nodes);
+    free(tape.values);
+    free(tape.adjoints);
+    free(tape.nodes);
+}
+
+f64 evaluate_gradient(const CompiledExpression& compiled, const f64 variables[], f64 gradient[], GradientTape& tape)
+{
+    const DynamicArray<ExpressionElement>& expression = compiled.elements;
+
+    clear(tape.nodes);
+    clear(tape.values);
+    clear(tape.value_nodes);
+
+    // Forward pass, every value on the stack remembers the node it came from
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        switch (expression[i].type)
+        {
+            case ExpressionElement::Type::NUMBER:
+            {
+                append(tape.values, expression[i].value);
+                append(tape.value_nodes, NO_NODE);
+            } break;
+
+            case ExpressionElement::Type::VARIABLE:
+            {
+                TapeNode node;
+                node.operand_count = 0;
+                node.variable = expression[i].variable.index;
+
+                append(tape.values, variables[node.variable]);
+                append(tape.value_nodes, (u32) tape.nodes.size);
+                append(tape.nodes, node);
+            } break;
+
+            case ExpressionElement::Type::OPERATOR:
+            {
+                const Operator& op = get_operator(expression[i].op_code);
+
+                tape.values.size -= op.operand_count;
+                tape.value_nodes.size -= op.operand_count;
+
+                const f64* operands = tape.values.data + tape.values.size;
+                const u32* operand_nodes = tape.value_nodes.data + tape.value_nodes.size;
+
+                const f64 result = op.operation((f64*) operands);
+
+                // Operators on constants are constants too
+                u32 node_index = NO_NODE;
+                for (u32 j = 0; j < op.operand_count; j++)
+                {
+                    if (operand_nodes[j] != NO_NODE)
+                    {
+                        node_index = (u32) tape.nodes.size;
+                        break;
+                    }
+                }
+
+                if (node_index != NO_NODE)
+                {
+                    TapeNode node;
+                    node.operand_count = op.operand_count;
+                    node.variable = NO_NODE;
+
+                    operator_partials(op.code, operands, result, node.partials);
+                    for (u32 j = 0; j < op.operand_count; j++)
+                        node.operands[j] = operand_nodes[j];
+
+                    append(tape.nodes, node);
+                }
+
+                append(tape.values, result);
+                append(tape.value_nodes, node_index);
+            } break;
+        }
+    }
+
+    gn_assert_with_message(tape.values.size == 1, "Number stack has extra values! (numbers left: %)", tape.values.size);
+
+    for (u32 i = 0; i < compiled.variable_count; i++)
+        gradient[i] = 0.0;
+
+    const u32 result_node = tape.value_nodes[0];
+    if (result_node == NO_NODE)
+        return tape.values[0];
+
+    // Backward pass, nodes only point to nodes before them
+    if (tape.adjoints.capacity < tape.nodes.size)
+        resize(tape.adjoints, tape.nodes.size);
+
+    tape.adjoints.size = tape.nodes.size;
+    for (u64 i = 0; i < tape.adjoints.size; i++)
+        tape.adjoints[i] = 0.0;
+
+    tape.adjoints[result_node] = 1.0;
+
+    for (u64 i = tape.nodes.size; i > 0; i--)
+    {
+        const TapeNode& node = tape.nodes[i - 1];
+        const f64 adjoint = tape.adjoints[i - 1];
+
+        // Nodes that don't affect the result are skipped so infinite partials don't turn into NaN
+        if (adjoint == 0.0)
+            continue;
+
+        if (node.variable != NO_NODE)
+        {
+            gradient[node.variable] += adjoint;
+            continue;
+        }
+
+        for (u32 j = 0; j < node.operand_count; j++)
+        {
+            if (node.operands[j] != NO_NODE)
+                tape.adjoints[node.operands[j]] += node.partials[j] * adjoint;
+        }
+    }
+
+    return tape.values[0];
+}
+
+bool solve_gradient(const String expression, const String variable_names[], const f64 values[], u32 variable_count, FILE* output)
+{
+    CompiledExpression compiled = {};
+    if (!compile_expression(expression, variable_names, variable_count, compiled))
+    {
+        print_error("Could not compile expression \"%\"!\n", expression);
+        free(compiled);
+        return false;
+    }
+
+    GradientTape tape = make_gradient_tape(compiled.elements.size);
+    DynamicArray<f64> gradient = make<DynamicArray<f64>>(max((u64) variable_count, 1Ui64));
+    gradient.size = variable_count;
+
+    const f64 result = evaluate_gradient(compiled, values, gradient.data, tape);
+
+    print_to_file(output, "Result: %\n", ShortestF64 { result });
+    for (u32 i = 0; i < variable_count; i++)
+        print_to_file(output, "d/d%: %\n", variable_names[i], ShortestF64 { gradient[i] });
+
+    free(gradient);
+    free(tape);
+    free(compiled);
+
+    return true;
+}
+
+} // namespace Calculator
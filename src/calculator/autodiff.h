@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdio>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/types.h"
+#include "compiled.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Value and its derivative with respect to one variable (forward mode)
+struct Dual
+{
+    f64 value;
+    f64 derivative;
+};
+
+// Writes the derivative of the operator's result with respect to each of its operands.
+// Comparisons and logic operators have a derivative of 0 everywhere.
+void operator_partials(OperatorCode code, const f64 operands[], f64 result, f64 partials[]);
+
+Dual apply_operator(const Operator& op, const Dual operands[]);
+
+// Forward mode: returns the value of the expression and writes its derivative with respect to one variable.
+// A gradient needs one call per variable.
+f64 evaluate_derivative(const CompiledExpression& compiled, const f64 variables[], u32 variable_index, f64& derivative,
+                        DynamicArray<Dual>& dual_stack);
+
+// Reverse mode records one node per operator and variable while solving, the adjoints are then
+// propagated back through the nodes in a single pass
+struct TapeNode
+{
+    f64 partials[3];    // Of the result with respect to each operand
+    u32 operands[3];    // Nodes of the operands, constants don't have one
+    u32 operand_count;
+    u32 variable;       // Index of the variable for variable nodes
+};
+
+// The arrays only grow so the tape doesn't allocate anything once it has been used for the expression
+struct GradientTape
+{
+    DynamicArray<TapeNode> nodes;
+    DynamicArray<f64> adjoints;
+    DynamicArray<f64> values;       // Number stack while solving
+    DynamicArray<u32> value_nodes;  // Node of each value on the number stack
+};
+
+GradientTape make_gradient_tape(u64 node_capacity = 64);
+void free(GradientTape& tape);
+
+// Reverse mode: returns the value of the expression and writes the derivative with respect to
+// every variable to gradient (compiled.variable_count values)
+f64 evaluate_gradient(const CompiledExpression& compiled, const f64 variables[], f64 gradient[], GradientTape& tape);
+
+// Solves the expression with the variables set to the given values and prints the result
+// and its derivative with respect to each of the variables
+bool solve_gradient(const String expression, const String variable_names[], const f64 values[], u32 variable_count, FILE* output);
+
+} // namespace Calculator
@@ -0,0 +1,821 @@
+#include "batch.h"
+
+#include <atomic>
+#include <cstring>
+#include <new>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/float_format.h"
+#include "core/logger.h"
+#include "core/thread_pool.h"
+#include "core/types.h"
+#include "core/utils.h"
+#include "platform/platform.h"
+#include "column_solver.h"
+#include "compiled.h"
+#include "cse.h"
+#include "error.h"
+#include "float_parser.h"
+#include "interval.h"
+#include "keywords.h"
+#include "solver.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+bool read_line(FILE* input, DynamicArray<char>& line)
+{
+    clear(line);
+
+    while (true)
+    {
+        // Always keep some space to read into
+        if (line.capacity - line.size < 64)
+            resize(line, 2 * line.capacity);
+
+        char* read_start = line.data + line.size;
+        if (!fgets(read_start, (int) (line.capacity - line.size), input))
+            return line.size > 0;
+
+        line.size += strlen(read_start);
+
+        if (line.data[line.size - 1] == '\n')
+        {
+            line.size--;
+            return true;
+        }
+    }
+}
+
+inline static bool is_whitespace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+static String trim(String str)
+{
+    while (str.size > 0 && is_whitespace(str.data[0]))
+    {
+        str.data++;
+        str.size--;
+    }
+
+    while (str.size > 0 && is_whitespace(str.data[str.size - 1]))
+        str.size--;
+
+    return str;
+}
+
+BatchScratch make_batch_scratch(ExpressionCache* cache)
+{
+    BatchScratch scratch;
+    scratch.elements     = make<DynamicArray<ExpressionElement>>(64Ui64);
+    scratch.op_stack     = make<DynamicArray<OperatorOrBracket>>(32Ui64);
+    scratch.number_stack = make<DynamicArray<f64>>(32Ui64);
+    scratch.cache        = cache;
+    scratch.profile      = nullptr;
+    scratch.normalized   = make<DynamicArray<char>>(256Ui64);
+
+    return scratch;
+}
+
+void free(BatchScratch& scratch)
+{
+    free(scratch.normalized);
+    free(scratch.number_stack);
+    free(scratch.op_stack);
+    free(scratch.elements);
+}
+
+LineResult solve_line(const String expression, BatchScratch& scratch, f64& result, ExpressionError& error)
+{
+    // Skip empty lines
+    bool is_empty = true;
+    for (u64 i = 0; is_empty && i < expression.size; i++)
+        is_empty = is_whitespace(expression.data[i]);
+
+    if (is_empty)
+        return LineResult::EMPTY;
+
+    if (scratch.cache)
+    {
+        // Errors are rare so the line is only tokenized again to find out why
+        if (!cached_infix_to_postfix(*scratch.cache, expression, scratch.elements, scratch.op_stack, scratch.normalized))
+        {
+            infix_expression_to_postfix(expression, scratch.elements, scratch.op_stack, error);
+            return LineResult::ERROR;
+        }
+    }
+    else if (!infix_expression_to_postfix(expression, scratch.elements, scratch.op_stack, error))
+    {
+        return LineResult::ERROR;
+    }
+
+    if (scratch.profile)
+        result = solve_postfix_data(scratch.elements, scratch.number_stack, nullptr, error, *scratch.profile);
+    else
+        result = solve_postfix_data(scratch.elements, scratch.number_stack, nullptr, error);
+
+    return (error.code == ErrorCode::NONE) ? LineResult::SOLVED : LineResult::ERROR;
+}
+
+// Appends something like "error: missing operand for sqrt at 4"
+static void append_error(DynamicArray<char>& output, const ExpressionError& error)
+{
+    const auto append_cstr = [&](const char* cstr) { append_many(output, cstr, strlen(cstr)); };
+
+    append_cstr("error: ");
+    append_cstr(error_message(error.code));
+
+    if (error.op != OperatorCode::COUNT)
+    {
+        const String name = operator_name(error.op);
+        append_cstr(" for ");
+        append_many(output, name.data, name.size);
+    }
+
+    char digits[24];
+    String offset = ref(digits, 24Ui64);
+    to_string(offset, (u64) error.offset);
+
+    append_cstr(" at ");
+    append_many(output, offset.data, offset.size);
+}
+
+void append_result(DynamicArray<char>& output, LineResult line_result, f64 result, u32 precision, const ExpressionError* error)
+{
+    switch (line_result)
+    {
+        case LineResult::EMPTY:
+            break;
+
+        case LineResult::ERROR:
+        {
+            if (error)
+                append_error(output, *error);
+            else
+                append_many(output, "error", 5);
+        } break;
+
+        case LineResult::SOLVED:
+        {
+            if (output.capacity - output.size < SHORTEST_F64_MAX_CHARS)
+                resize(output, 2 * output.capacity + SHORTEST_F64_MAX_CHARS);
+
+            output.size += to_shortest_chars(result, output.data + output.size, SHORTEST_F64_MAX_CHARS, precision);
+        } break;
+    }
+}
+
+// Output is written in blocks of about this many bytes
+constexpr u64 BATCH_OUTPUT_BLOCK_SIZE = 64 * 1024;
+
+BatchStats solve_batch(FILE* input, FILE* output, const BatchOptions& options)
+{
+    BatchStats stats = {};
+
+    ExpressionCache cache;
+    if (options.cache_memory > 0)
+        init_expression_cache(cache, options.cache_memory);
+
+    DynamicArray<char> line = make<DynamicArray<char>>(1024Ui64);
+    DynamicArray<char> output_block = make<DynamicArray<char>>(BATCH_OUTPUT_BLOCK_SIZE + 1024);
+    BatchScratch scratch = make_batch_scratch((options.cache_memory > 0) ? &cache : nullptr);
+    scratch.profile = options.profile;
+
+    const f64 start_time = platform_get_time_absolute();
+
+    while (read_line(input, line))
+    {
+        stats.byte_count += line.size + 1;
+
+        f64 result;
+        ExpressionError error;
+        const LineResult line_result = solve_line(ref(line.data, line.size), scratch, result, error);
+
+        stats.expression_count += (line_result != LineResult::EMPTY);
+        stats.error_count      += (line_result == LineResult::ERROR);
+
+        append_result(output_block, line_result, result, options.precision, options.diagnostics ? &error : nullptr);
+        append(output_block, '\n');
+
+        if (output_block.size >= BATCH_OUTPUT_BLOCK_SIZE)
+        {
+            fwrite(output_block.data, 1, output_block.size, output);
+            clear(output_block);
+        }
+    }
+
+    fwrite(output_block.data, 1, output_block.size, output);
+
+    stats.seconds = platform_get_time_absolute() - start_time;
+
+    if (options.cache_memory > 0)
+    {
+        stats.cache_hit_count  = cache.hit_count;
+        stats.cache_miss_count = cache.miss_count;
+        free(cache);
+    }
+
+    free(scratch);
+    free(output_block);
+    free(line);
+
+    return stats;
+}
+
+// Lines are read in chunks of about this many bytes and each chunk is solved by one thread
+constexpr u64 BATCH_CHUNK_SIZE = 64 * 1024;
+
+// Chunks in flight per thread, the reader stops once all of them are waiting to be written
+constexpr u32 BATCH_CHUNKS_PER_THREAD = 4;
+
+struct BatchChunk
+{
+    DynamicArray<char> input;       // Whole lines, the last one might not end with a newline
+    DynamicArray<char> output;
+    BatchStats stats;
+    BatchScratch* scratch;          // One per thread, indexed by the worker index
+    u32 precision;
+    bool diagnostics;
+
+    std::atomic<bool> done;
+};
+
+static void solve_chunk(void* data, u32 worker_index)
+{
+    BatchChunk& chunk = *(BatchChunk*) data;
+    BatchScratch& scratch = chunk.scratch[worker_index];
+
+    clear(chunk.output);
+    chunk.stats = {};
+
+    u64 start = 0;
+    while (start < chunk.input.size)
+    {
+        u64 end = start;
+        while (end < chunk.input.size && chunk.input[end] != '\n')
+            end++;
+
+        chunk.stats.byte_count += end - start + 1;
+
+        f64 result;
+        ExpressionError error;
+        const LineResult line_result = solve_line(ref(chunk.input.data + start, end - start), scratch, result, error);
+
+        chunk.stats.expression_count += (line_result != LineResult::EMPTY);
+        chunk.stats.error_count      += (line_result == LineResult::ERROR);
+
+        append_result(chunk.output, line_result, result, chunk.precision, chunk.diagnostics ? &error : nullptr);
+        append(chunk.output, '\n');
+
+        start = end + 1;
+    }
+
+    chunk.done.store(true, std::memory_order_release);
+}
+
+// Fills the chunk with whole lines. Whatever comes after the last newline is carried over to the next chunk.
+static bool read_chunk(FILE* input, BatchChunk& chunk, DynamicArray<char>& carry)
+{
+    clear(chunk.input);
+    append_many(chunk.input, carry.data, carry.size);
+    clear(carry);
+
+    while (true)
+    {
+        if (chunk.input.capacity - chunk.input.size < BATCH_CHUNK_SIZE)
+            resize(chunk.input, chunk.input.size + BATCH_CHUNK_SIZE);
+
+        const u64 read_start = chunk.input.size;
+        chunk.input.size += fread(chunk.input.data + read_start, 1, BATCH_CHUNK_SIZE, input);
+
+        if (chunk.input.size == read_start)
+            return chunk.input.size > 0;    // End of input, the last line doesn't need a newline
+
+        u64 line_end = chunk.input.size;
+        while (line_end > read_start && chunk.input[line_end - 1] != '\n')
+            line_end--;
+
+        // Keep reading if a single line is longer than the chunk
+        if (line_end == read_start)
+            continue;
+
+        append_many(carry, chunk.input.data + line_end, chunk.input.size - line_end);
+        chunk.input.size = line_end;
+        return true;
+    }
+}
+
+BatchStats solve_batch_parallel(FILE* input, FILE* output, const BatchOptions& options)
+{
+    ThreadPool pool = {};
+    if (!start_thread_pool(pool, options.thread_count))
+    {
+        print_error("Could not start the thread pool, solving on a single thread.\n");
+        return solve_batch(input, output, options);
+    }
+
+    BatchStats stats = {};
+
+    // The thread writing the output helps solve chunks too, it gets the last scratch
+    const u32 scratch_count = pool.worker_count + 1;
+    BatchScratch* scratch = (BatchScratch*) platform_allocate(scratch_count * sizeof(BatchScratch));
+    ExpressionCache* caches = nullptr;
+
+    if (options.cache_memory > 0)
+    {
+        caches = (ExpressionCache*) platform_allocate(scratch_count * sizeof(ExpressionCache));
+        for (u32 i = 0; i < scratch_count; i++)
+        {
+            new (caches + i) ExpressionCache();
+            init_expression_cache(caches[i], options.cache_memory / scratch_count);
+        }
+    }
+
+    // Every thread times its operators on its own, they are added to the options' profile at the end
+    OperatorProfile* profiles = nullptr;
+    if (options.profile)
+    {
+        profiles = (OperatorProfile*) platform_allocate(scratch_count * sizeof(OperatorProfile));
+        memset(profiles, 0, scratch_count * sizeof(OperatorProfile));
+    }
+
+    for (u32 i = 0; i < scratch_count; i++)
+    {
+        scratch[i] = make_batch_scratch(caches ? caches + i : nullptr);
+        scratch[i].profile = profiles ? profiles + i : nullptr;
+    }
+
+    // Chunks are written out in the order they were read (a ring used as a reorder buffer)
+    const u64 chunk_count = BATCH_CHUNKS_PER_THREAD * scratch_count;
+    BatchChunk* chunks = (BatchChunk*) platform_allocate(chunk_count * sizeof(BatchChunk));
+    for (u64 i = 0; i < chunk_count; i++)
+    {
+        new (chunks + i) BatchChunk();
+        chunks[i].input   = make<DynamicArray<char>>(BATCH_CHUNK_SIZE);
+        chunks[i].output  = make<DynamicArray<char>>(BATCH_CHUNK_SIZE);
+        chunks[i].scratch = scratch;
+        chunks[i].precision = options.precision;
+        chunks[i].diagnostics = options.diagnostics;
+    }
+
+    DynamicArray<char> carry = make<DynamicArray<char>>(1024Ui64);
+
+    const f64 start_time = platform_get_time_absolute();
+
+    u64 read_count = 0;
+    u64 write_count = 0;
+    bool has_input = true;
+
+    while (true)
+    {
+        while (has_input && read_count - write_count < chunk_count)
+        {
+            BatchChunk& chunk = chunks[read_count % chunk_count];
+            has_input = read_chunk(input, chunk, carry);
+
+            if (!has_input)
+                break;
+
+            chunk.done.store(false, std::memory_order_relaxed);
+            submit_task(pool, { solve_chunk, &chunk });
+            read_count++;
+        }
+
+        if (write_count == read_count)
+            break;
+
+        BatchChunk& chunk = chunks[write_count % chunk_count];
+        while (!chunk.done.load(std::memory_order_acquire))
+        {
+            if (!run_pending_task(pool))
+                platform_yield_thread();
+        }
+
+        fwrite(chunk.output.data, 1, chunk.output.size, output);
+
+        stats.expression_count += chunk.stats.expression_count;
+        stats.error_count      += chunk.stats.error_count;
+        stats.byte_count       += chunk.stats.byte_count;
+
+        write_count++;
+    }
+
+    stop_thread_pool(pool);
+
+    stats.seconds = platform_get_time_absolute() - start_time;
+
+    free(carry);
+
+    for (u64 i = 0; i < chunk_count; i++)
+    {
+        free(chunks[i].output);
+        free(chunks[i].input);
+    }
+
+    for (u32 i = 0; i < scratch_count; i++)
+        free(scratch[i]);
+
+    if (caches)
+    {
+        for (u32 i = 0; i < scratch_count; i++)
+        {
+            stats.cache_hit_count  += caches[i].hit_count;
+            stats.cache_miss_count += caches[i].miss_count;
+            free(caches[i]);
+        }
+
+        platform_free(caches);
+    }
+
+    if (profiles)
+    {
+        for (u32 i = 0; i < scratch_count; i++)
+            add(*options.profile, profiles[i]);
+
+        platform_free(profiles);
+    }
+
+    platform_free(chunks);
+    platform_free(scratch);
+
+    return stats;
+}
+
+// Values that aren't numbers are 0, same as atof
+static f64 parse_csv_value(String value)
+{
+    value = trim(value);
+
+    const bool negative = value.size > 0 && value.data[0] == '-';
+    if (value.size > 0 && (value.data[0] == '-' || value.data[0] == '+'))
+    {
+        value.data++;
+        value.size--;
+    }
+
+    f64 result;
+    if (parse_f64(value.data, value.size, result) == 0)
+        return 0.0;
+
+    return negative ? -result : result;
+}
+
+// Column names point into the header buffer
+static bool read_csv_header(FILE* input, DynamicArray<char>& header, DynamicArray<String>& column_names)
+{
+    if (!read_line(input, header))
+    {
+        print_error("CSV input is empty! Expected a header with the column names.\n");
+        return false;
+    }
+
+    u64 start = 0;
+    for (u64 i = 0; i <= header.size; i++)
+    {
+        if (i < header.size && header.data[i] != ',')
+            continue;
+
+        append(column_names, trim(ref(header.data + start, i - start)));
+        start = i + 1;
+    }
+
+    return true;
+}
+
+// Writes the values of the line to row of the columns (stored one after another, stride values apart).
+// Missing values are 0, returns false if the line doesn't have a value for every column.
+static bool read_csv_row(DynamicArray<char>& line, f64 columns[], u64 column_count, u64 stride, u64 row)
+{
+    // Marks the end of the last value
+    append(line, '\0');
+
+    u64 column = 0;
+    u64 start = 0;
+    for (u64 i = 0; i < line.size; i++)
+    {
+        if (line.data[i] != ',' && line.data[i] != '\0')
+            continue;
+
+        if (column < column_count)
+            columns[column * stride + row] = parse_csv_value(ref(line.data + start, i - start));
+
+        column++;
+        start = i + 1;
+    }
+
+    const bool complete = (column == column_count);
+    for (; column < column_count; column++)
+        columns[column * stride + row] = 0.0;
+
+    return complete;
+}
+
+BatchStats solve_csv(const String expression, FILE* input, FILE* output, const BatchOptions& options)
+{
+    BatchStats stats = {};
+
+    DynamicArray<char> header = make<DynamicArray<char>>(1024Ui64);
+    DynamicArray<String> column_names = make<DynamicArray<String>>(16Ui64);
+    if (!read_csv_header(input, header, column_names))
+    {
+        free(column_names);
+        free(header);
+
+        stats.error_count++;
+        return stats;
+    }
+
+    stats.byte_count += header.size + 1;
+
+    CompiledExpression compiled = {};
+    if (!compile_expression(expression, column_names.data, (u32) column_names.size, compiled))
+    {
+        print_error("Could not compile expression \"%\"!\n", expression);
+        free(compiled);
+        free(column_names);
+        free(header);
+
+        stats.error_count++;
+        return stats;
+    }
+
+    const u64 column_count = column_names.size;
+
+    const RowReduction reduction = options.reduction;
+    const bool reduce_rows = reduction == RowReduction::SUM || reduction == RowReduction::MEAN;
+
+    ColumnSum total = {};
+    u64 total_rows = 0;
+
+    f64 prefix_sum = 0.0;
+    f64 prefix_compensation = 0.0;
+
+    // Subexpressions that show up more than once are only solved once per row
+    CseProgram program = {};
+    eliminate_common_subexpressions(compiled.elements, (u32) column_count, program);
+
+    // Rows are gathered into columns and solved a block at a time
+    DynamicArray<f64> columns = make<DynamicArray<f64>>(column_count * COLUMN_BLOCK_SIZE);
+    DynamicArray<const f64*> column_pointers = make<DynamicArray<const f64*>>(column_count);
+    for (u64 i = 0; i < column_count; i++)
+        append(column_pointers, (const f64*) (columns.data + i * COLUMN_BLOCK_SIZE));
+
+    DynamicArray<char> line = make<DynamicArray<char>>(1024Ui64);
+    CseScratch scratch = {};
+    scratch.column_scratch.vector_math = options.fast_math;
+
+    bool row_valid[COLUMN_BLOCK_SIZE];
+    f64  results[COLUMN_BLOCK_SIZE];
+    u64  block_rows = 0;
+
+    const f64 start_time = platform_get_time_absolute();
+
+    while (true)
+    {
+        const bool has_line = read_line(input, line);
+
+        if (has_line)
+        {
+            stats.byte_count += line.size + 1;
+            stats.expression_count++;
+
+            // Rows with missing values are still solved (with zeros) but reported as errors
+            row_valid[block_rows] = read_csv_row(line, columns.data, column_count, COLUMN_BLOCK_SIZE, block_rows);
+            block_rows++;
+        }
+
+        if (block_rows == COLUMN_BLOCK_SIZE || (!has_line && block_rows > 0))
+        {
+            if (!solve_cse_columns(program, column_pointers.data, block_rows, results, scratch))
+            {
+                stats.error_count += block_rows;
+                break;
+            }
+
+            if (reduction != RowReduction::NONE)
+            {
+                // Rows with missing values are left out of the reduction
+                for (u64 i = 0; i < block_rows; i++)
+                {
+                    results[i] = row_valid[i] ? results[i] : 0.0;
+                    total_rows += row_valid[i];
+                }
+
+                if (reduce_rows)
+                    add_column(total, results, block_rows);
+                else
+                    prefix_sum_column(results, results, block_rows, prefix_sum, prefix_compensation);
+            }
+
+            for (u64 i = 0; i < block_rows; i++)
+            {
+                stats.error_count += !row_valid[i];
+
+                // Only a single result is written for all rows
+                if (reduce_rows)
+                    continue;
+
+                if (row_valid[i])
+                    print_to_file(output, "%\n", ShortestF64 { results[i], options.precision });
+                else
+                    print_to_file(output, "error\n");
+            }
+
+            block_rows = 0;
+        }
+
+        if (!has_line)
+            break;
+    }
+
+    if (reduce_rows)
+    {
+        const f64 result = column_sum_total(total);
+        print_to_file(output, "%\n", ShortestF64 { (reduction == RowReduction::MEAN) ? result / total_rows : result, options.precision });
+    }
+
+    stats.seconds = platform_get_time_absolute() - start_time;
+
+    free(scratch);
+    free(line);
+    free(column_pointers);
+    free(columns);
+    free(program);
+    free(compiled);
+    free(column_names);
+    free(header);
+
+    return stats;
+}
+
+// Index of the column named variable followed by suffix (like x_low), or the column count if there is none
+static u64 find_bound_column(const DynamicArray<String>& column_names, const String variable, const String suffix)
+{
+    for (u64 i = 0; i < column_names.size; i++)
+    {
+        const String column = column_names[i];
+        if (column.size == variable.size + suffix.size && ref(column.data, variable.size) == variable &&
+            ref(column.data + variable.size, suffix.size) == suffix)
+            return i;
+    }
+
+    return column_names.size;
+}
+
+// Whether the name ends with suffix, variable is set to the part before it
+static bool split_suffix(const String name, const String suffix, String& variable)
+{
+    if (name.size <= suffix.size || ref(name.data + name.size - suffix.size, suffix.size) != suffix)
+        return false;
+
+    variable = ref(name.data, name.size - suffix.size);
+    return true;
+}
+
+BatchStats solve_csv_bounds(const String expression, FILE* input, FILE* output)
+{
+    BatchStats stats = {};
+
+    DynamicArray<char> header = make<DynamicArray<char>>(1024Ui64);
+    DynamicArray<String> column_names = make<DynamicArray<String>>(16Ui64);
+    if (!read_csv_header(input, header, column_names))
+    {
+        free(column_names);
+        free(header);
+
+        stats.error_count++;
+        return stats;
+    }
+
+    stats.byte_count += header.size + 1;
+
+    const u64 column_count = column_names.size;
+    const String low_suffix  = ref("_low", 4);
+    const String high_suffix = ref("_high", 5);
+
+    // Every variable reads its low and high bounds from a column, which is the same one for single values
+    DynamicArray<String> variable_names = make<DynamicArray<String>>(column_count);
+    DynamicArray<u64>    low_columns    = make<DynamicArray<u64>>(column_count);
+    DynamicArray<u64>    high_columns   = make<DynamicArray<u64>>(column_count);
+
+    for (u64 i = 0; i < column_count; i++)
+    {
+        String variable;
+        u64 high_column = i;
+
+        // x_low goes with x_high, the x_high column is skipped when it comes up
+        if (split_suffix(column_names[i], low_suffix, variable))
+            high_column = find_bound_column(column_names, variable, high_suffix);
+        else if (split_suffix(column_names[i], high_suffix, variable) &&
+                 find_bound_column(column_names, variable, low_suffix) < column_count)
+            continue;
+
+        if (high_column == column_count)
+            high_column = i;
+
+        append(variable_names, (high_column == i) ? column_names[i] : variable);
+        append(low_columns, i);
+        append(high_columns, high_column);
+    }
+
+    // Not optimized, folding constants would round them to the nearest f64 instead of outwards
+    DynamicArray<ExpressionElement> elements = make<DynamicArray<ExpressionElement>>(16Ui64);
+    DynamicArray<OperatorOrBracket> op_stack = make<DynamicArray<OperatorOrBracket>>(16Ui64);
+    DynamicArray<Interval> constants = {};
+
+    ExpressionError error;
+    if (!infix_expression_to_postfix(expression, elements, op_stack, error, variable_names.data, (u32) variable_names.size, true))
+    {
+        print_error("Could not compile expression \"%\"!\n", expression);
+        stats.error_count++;
+    }
+    else
+    {
+        constants = make<DynamicArray<Interval>>(elements.size);
+        convert_interval_constants(elements, expression, constants);
+
+        // Rows are gathered into columns and bounded a block at a time
+        DynamicArray<f64> columns = make<DynamicArray<f64>>(column_count * INTERVAL_BLOCK_SIZE);
+        DynamicArray<const f64*> variable_lows  = make<DynamicArray<const f64*>>(variable_names.size);
+        DynamicArray<const f64*> variable_highs = make<DynamicArray<const f64*>>(variable_names.size);
+        for (u64 i = 0; i < variable_names.size; i++)
+        {
+            append(variable_lows,  (const f64*) (columns.data + low_columns[i] * INTERVAL_BLOCK_SIZE));
+            append(variable_highs, (const f64*) (columns.data + high_columns[i] * INTERVAL_BLOCK_SIZE));
+        }
+
+        DynamicArray<char> line = make<DynamicArray<char>>(1024Ui64);
+        IntervalScratch scratch = {};
+
+        bool row_valid[INTERVAL_BLOCK_SIZE];
+        f64  result_lows[INTERVAL_BLOCK_SIZE];
+        f64  result_highs[INTERVAL_BLOCK_SIZE];
+        u64  block_rows = 0;
+
+        const f64 start_time = platform_get_time_absolute();
+
+        while (true)
+        {
+            const bool has_line = read_line(input, line);
+
+            if (has_line)
+            {
+                stats.byte_count += line.size + 1;
+                stats.expression_count++;
+
+                row_valid[block_rows] = read_csv_row(line, columns.data, column_count, INTERVAL_BLOCK_SIZE, block_rows);
+
+                // Ranges with the bounds the wrong way around are errors too
+                for (u64 i = 0; i < variable_names.size; i++)
+                    row_valid[block_rows] &= variable_lows[i][block_rows] <= variable_highs[i][block_rows];
+
+                block_rows++;
+            }
+
+            if (block_rows == INTERVAL_BLOCK_SIZE || (!has_line && block_rows > 0))
+            {
+                solve_postfix_intervals(elements, constants, variable_lows.data, variable_highs.data, block_rows,
+                                        result_lows, result_highs, scratch);
+
+                for (u64 i = 0; i < block_rows; i++)
+                {
+                    stats.error_count += !row_valid[i];
+
+                    if (row_valid[i])
+                        print_to_file(output, "%,%\n", ShortestF64 { result_lows[i] }, ShortestF64 { result_highs[i] });
+                    else
+                        print_to_file(output, "error\n");
+                }
+
+                block_rows = 0;
+            }
+
+            if (!has_line)
+                break;
+        }
+
+        stats.seconds = platform_get_time_absolute() - start_time;
+
+        free(scratch);
+        free(line);
+        free(variable_highs);
+        free(variable_lows);
+        free(columns);
+    }
+
+    free(constants);
+    free(op_stack);
+    free(elements);
+    free(high_columns);
+    free(low_columns);
+    free(variable_names);
+    free(column_names);
+    free(header);
+
+    return stats;
+}
+
+} // namespace Calculator
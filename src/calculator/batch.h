@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdio>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/types.h"
+#include "error.h"
+#include "expression_cache.h"
+#include "profile.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+struct BatchStats
+{
+    u64 expression_count;
+    u64 error_count;
+    u64 byte_count;
+    u64 cache_hit_count;
+    u64 cache_miss_count;
+    f64 seconds;
+};
+
+// How solve_csv combines the results of the rows
+enum struct RowReduction
+{
+    NONE,           // One result per row
+    SUM,            // Compensated sum of the rows (see add_column)
+    MEAN,
+    PREFIX_SUM,     // Running sum, one result per row
+};
+
+struct BatchOptions
+{
+    u64 cache_memory;   // Expressions are cached (up to this many bytes) if it isn't 0
+    u32 thread_count;   // Only used by solve_batch_parallel, 0 for one thread per processor
+    u32 precision;      // Significant digits of the results, 0 for the fewest that convert back to the same number
+    bool diagnostics;   // Lines that fail say why instead of just "error"
+    bool fast_math;     // CSV columns use vector_math.h for transcendental functions (results can be off by a few ulp)
+    RowReduction reduction;     // Only used for CSV
+    OperatorProfile* profile;   // Calls and cycles of the operators are added to it if not null (not used for CSV)
+};
+
+// Scratch memory for solving lines, reused across lines so the steady state doesn't allocate
+struct BatchScratch
+{
+    DynamicArray<ExpressionElement> elements;
+    DynamicArray<OperatorOrBracket> op_stack;
+    DynamicArray<f64> number_stack;
+
+    ExpressionCache* cache;         // Lines are tokenized every time if null
+    OperatorProfile* profile;       // Operators are timed if not null
+    DynamicArray<char> normalized;
+};
+
+BatchScratch make_batch_scratch(ExpressionCache* cache = nullptr);
+void free(BatchScratch& scratch);
+
+enum struct LineResult
+{
+    EMPTY,      // Only whitespace
+    ERROR,
+    SOLVED,
+};
+
+// Solves a single expression, result is only set if the line was solved and error only if it wasn't
+LineResult solve_line(const String expression, BatchScratch& scratch, f64& result, ExpressionError& error);
+
+// Appends the result the way batch mode prints it (without the newline). Empty lines append nothing.
+// Errors are written as "error", or with the code, operator and offset if error isn't null.
+void append_result(DynamicArray<char>& output, LineResult line_result, f64 result, u32 precision, const ExpressionError* error = nullptr);
+
+// Solves newline separated expressions from input and writes one result per line to output.
+// Lines that fail to parse are written out as "error" so line numbers stay aligned.
+BatchStats solve_batch(FILE* input, FILE* output, const BatchOptions& options);
+
+// Same as solve_batch, but the input is split into chunks of lines that are solved on a work stealing
+// thread pool. Results are written in input order. Every thread gets its own cache with an equal share
+// of the cache memory.
+BatchStats solve_batch_parallel(FILE* input, FILE* output, const BatchOptions& options);
+
+// Evaluates the expression once for every row of a CSV file. The first row is the header and
+// its column names can be used as variables in the expression. Writes one result per row, or a single
+// result if the rows are reduced to their sum or mean (see RowReduction). Aggregates in the expression
+// (sum, mean and dot) are always over their arguments in one row.
+BatchStats solve_csv(const String expression, FILE* input, FILE* output, const BatchOptions& options);
+
+// Same as solve_csv, but writes a range that contains the result of every row for any values of its variables
+// (see interval.h) as "low,high". A pair of columns named <name>_low and <name>_high is the range of the
+// variable name, the other columns are variables with a single value. The bounds are printed with all their
+// digits so they stay outside of the results.
+BatchStats solve_csv_bounds(const String expression, FILE* input, FILE* output);
+
+// Reads a line (without the newline) into the buffer. Returns false once the input is exhausted.
+bool read_line(FILE* input, DynamicArray<char>& line);
+
+} // namespace Calculator
@@ -0,0 +1,1492 @@
+#include "benchmark.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/float_format.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "core/utils.h"
+#include "platform/platform.h"
+#include "autodiff.h"
+#include "bytecode.h"
+#include "column_solver.h"
+#include "compiled.h"
+#include "cse.h"
+#include "error.h"
+#include "float_parser.h"
+#include "interval.h"
+#include "jit.h"
+#include "keywords.h"
+#include "numeric_solver.h"
+#include "solver.h"
+#include "token.h"
+#include "vector_math.h"
+
+namespace Calculator
+{
+
+constexpr u32 BENCHMARK_VARIABLE_COUNT = 3;
+
+static const String variable_names[BENCHMARK_VARIABLE_COUNT] = { ref("x"), ref("y"), ref("z") };
+
+static void print_benchmark_row(const char* name, f64 seconds, u64 row_count, f64 baseline_seconds)
+{
+    const f64 rows_per_second = (seconds > 0) ? row_count / seconds : 0.0;
+    const f64 speedup = (seconds > 0) ? baseline_seconds / seconds : 0.0;
+
+    print("%: % ms (% Mrows/s, %x)\n", name, seconds * 1000.0, rows_per_second / 1000000.0, speedup);
+}
+
+// Reports the rows where results differ from the postfix solver (NaNs are considered equal to each other)
+static void report_mismatches(const char* name, const f64 expected[], const f64 actual[], u64 row_count)
+{
+    u64 mismatches = 0;
+
+    for (u64 i = 0; i < row_count; i++)
+    {
+        const bool both_nan = (expected[i] != expected[i]) && (actual[i] != actual[i]);
+        mismatches += !both_nan && (expected[i] != actual[i]);
+    }
+
+    if (mismatches > 0)
+        print_error("% results differ from the postfix solver in % rows!\n", name, mismatches);
+}
+
+// Distance between two doubles in representable numbers (0 if they're the same or both NaN)
+static u64 ulp_difference(f64 a, f64 b)
+{
+    if (a != a || b != b)
+        return (a != a && b != b) ? 0 : _UI64_MAX;
+
+    s64 a_bits, b_bits;
+    memcpy(&a_bits, &a, sizeof(f64));
+    memcpy(&b_bits, &b, sizeof(f64));
+
+    // Negative numbers are flipped so the integers are in the same order as the doubles
+    if (a_bits < 0) a_bits = (s64) (0x8000000000000000Ui64 - (u64) a_bits);
+    if (b_bits < 0) b_bits = (s64) (0x8000000000000000Ui64 - (u64) b_bits);
+
+    return (a_bits > b_bits) ? (u64) a_bits - (u64) b_bits : (u64) b_bits - (u64) a_bits;
+}
+
+// rand() only has 15 bits on some platforms
+static u64 random_u64(u64& state)
+{
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DUi64;
+}
+
+// Random number in [low, high)
+static f64 random_in_range(u64& state, f64 low, f64 high)
+{
+    return low + (high - low) * ((random_u64(state) >> 11) * 0x1.0p-53);
+}
+
+// Compiles an expression of x, y and z, prints an error if it can't be compiled
+static bool compile_benchmark_expression(const String expression, CompiledExpression& compiled, bool optimize = true)
+{
+    if (!compile_expression(expression, variable_names, BENCHMARK_VARIABLE_COUNT, compiled, optimize))
+    {
+        print_error("Could not compile expression \"%\"!\n", expression);
+        free(compiled);
+        return false;
+    }
+
+    return true;
+}
+
+// Values of x, y and z in [-1, 1) for every row. They are stored as columns (variable i starts at i * row_count,
+// see columns), the callers that want rows read them as BENCHMARK_VARIABLE_COUNT values per row instead.
+// Always the same values so runs can be compared.
+static DynamicArray<f64> make_benchmark_inputs(u64 row_count, const f64* columns[BENCHMARK_VARIABLE_COUNT] = nullptr)
+{
+    DynamicArray<f64> inputs = make<DynamicArray<f64>>(BENCHMARK_VARIABLE_COUNT * row_count);
+    inputs.size = inputs.capacity;
+
+    u64 state = 0x9E3779B97F4A7C15Ui64;
+    for (u64 i = 0; i < inputs.size; i++)
+        inputs[i] = random_in_range(state, -1.0, 1.0);
+
+    if (columns)
+    {
+        for (u32 i = 0; i < BENCHMARK_VARIABLE_COUNT; i++)
+            columns[i] = inputs.data + i * row_count;
+    }
+
+    return inputs;
+}
+
+bool run_benchmark(const String expression, u64 row_count)
+{
+    CompiledExpression compiled = {};
+    if (!compile_benchmark_expression(expression, compiled))
+        return false;
+
+    const f64* variable_columns[BENCHMARK_VARIABLE_COUNT];
+    DynamicArray<f64> inputs = make_benchmark_inputs(row_count, variable_columns);
+
+    DynamicArray<f64> expected = make<DynamicArray<f64>>(row_count);
+    DynamicArray<f64> results  = make<DynamicArray<f64>>(row_count);
+    expected.size = results.size = row_count;
+
+    print("Benchmarking \"%\" over % rows\n", expression, row_count);
+    print("Optimizer removed % elements (% elements left)\n", compiled.elements_removed, compiled.elements.size);
+
+    {   // Tokenizer throughput
+        const u64 iterations = max(1Ui64, row_count / 10);
+
+        DynamicArray<ExpressionElement> elements = make<DynamicArray<ExpressionElement>>(64Ui64);
+        DynamicArray<OperatorOrBracket> op_stack = make<DynamicArray<OperatorOrBracket>>(32Ui64);
+
+        const f64 start_time = platform_get_time_absolute();
+
+        for (u64 i = 0; i < iterations; i++)
+            infix_expression_to_postfix(expression, elements, op_stack, variable_names, BENCHMARK_VARIABLE_COUNT);
+
+        const f64 seconds = platform_get_time_absolute() - start_time;
+        const f64 megabytes = (f64) (iterations * expression.size) / (1024.0 * 1024.0);
+
+        print("tokenizer: % MB/s (% expressions/s)\n", megabytes / seconds, iterations / seconds);
+
+        free(op_stack);
+        free(elements);
+    }
+
+    f64 postfix_seconds;
+    {   // Postfix solver, one row at a time
+        const f64 start_time = platform_get_time_absolute();
+
+        f64 row[BENCHMARK_VARIABLE_COUNT];
+        for (u64 i = 0; i < row_count; i++)
+        {
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+                row[j] = variable_columns[j][i];
+
+            expected[i] = solve_postfix_data(compiled.elements, compiled.number_stack, row);
+        }
+
+        postfix_seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("postfix ", postfix_seconds, row_count, postfix_seconds);
+    }
+
+    {   // Bytecode, one row at a time
+        const f64 start_time = platform_get_time_absolute();
+
+        f64 row[BENCHMARK_VARIABLE_COUNT];
+        for (u64 i = 0; i < row_count; i++)
+        {
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+                row[j] = variable_columns[j][i];
+
+            results[i] = evaluate(compiled, row);
+        }
+
+        const f64 seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("bytecode", seconds, row_count, postfix_seconds);
+        report_mismatches("Bytecode", expected.data, results.data, row_count);
+    }
+
+    {   // Machine code, one row at a time
+        JitExpression jit;
+        if (compile_jit(compiled.elements, jit))
+        {
+            const f64 start_time = platform_get_time_absolute();
+
+            f64 row[BENCHMARK_VARIABLE_COUNT];
+            for (u64 i = 0; i < row_count; i++)
+            {
+                for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+                    row[j] = variable_columns[j][i];
+
+                results[i] = jit.function(row, compiled.number_stack.data);
+            }
+
+            const f64 seconds = platform_get_time_absolute() - start_time;
+            print_benchmark_row("jit     ", seconds, row_count, postfix_seconds);
+            report_mismatches("JIT", expected.data, results.data, row_count);
+        }
+        else
+        {
+            print("jit     : not supported on this platform\n");
+        }
+
+        free(jit);
+    }
+
+    {   // Column solver, a block of rows at a time
+        ColumnScratch scratch = {};
+
+        const f64 start_time = platform_get_time_absolute();
+        solve_postfix_columns(compiled.elements, variable_columns, row_count, results.data, scratch);
+        const f64 seconds = platform_get_time_absolute() - start_time;
+
+        print_benchmark_row("columns ", seconds, row_count, postfix_seconds);
+        report_mismatches("Column solver", expected.data, results.data, row_count);
+
+        free(scratch);
+    }
+
+    {   // Column solver with vector_math.h, which can be a few ulp off from libm
+        ColumnScratch scratch = {};
+        scratch.vector_math = true;
+
+        const f64 start_time = platform_get_time_absolute();
+        solve_postfix_columns(compiled.elements, variable_columns, row_count, results.data, scratch);
+        const f64 seconds = platform_get_time_absolute() - start_time;
+
+        u64 max_error = 0;
+        for (u64 i = 0; i < row_count; i++)
+            max_error = max(max_error, ulp_difference(expected[i], results[i]));
+
+        print_benchmark_row("vec math", seconds, row_count, postfix_seconds);
+        print("vec math is off by % ulp at most (more where terms cancel out)\n", max_error);
+
+        free(scratch);
+    }
+
+    {   // Common subexpressions solved once, one row at a time and a block of rows at a time
+        CseProgram program = {};
+        CseScratch scratch = {};
+
+        eliminate_common_subexpressions(compiled.elements, BENCHMARK_VARIABLE_COUNT, program);
+        print("CSE found % temporaries (% operators removed)\n", program.temporary_count, program.operators_removed);
+
+        f64 start_time = platform_get_time_absolute();
+
+        f64 row[BENCHMARK_VARIABLE_COUNT];
+        for (u64 i = 0; i < row_count; i++)
+        {
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+                row[j] = variable_columns[j][i];
+
+            results[i] = solve_cse_program(program, row, scratch);
+        }
+
+        f64 seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("cse     ", seconds, row_count, postfix_seconds);
+        report_mismatches("CSE", expected.data, results.data, row_count);
+
+        start_time = platform_get_time_absolute();
+        solve_cse_columns(program, variable_columns, row_count, results.data, scratch);
+        seconds = platform_get_time_absolute() - start_time;
+
+        print_benchmark_row("cse cols", seconds, row_count, postfix_seconds);
+        report_mismatches("CSE column solver", expected.data, results.data, row_count);
+
+        free(scratch);
+        free(program);
+    }
+
+    {   // Adding up the results (like sum around the whole expression in CSV mode)
+        f64 start_time = platform_get_time_absolute();
+
+        f64 naive_sum = 0.0;
+        for (u64 i = 0; i < row_count; i++)
+            naive_sum += results[i];
+
+        const f64 naive_seconds = platform_get_time_absolute() - start_time;
+
+        start_time = platform_get_time_absolute();
+
+        ColumnSum sum = {};
+        for (u64 i = 0; i < row_count; i += COLUMN_BLOCK_SIZE)
+            add_column(sum, results.data + i, min(COLUMN_BLOCK_SIZE, row_count - i));
+
+        const f64 column_seconds = platform_get_time_absolute() - start_time;
+
+        print("sum of results: % (compensated), % (one at a time)\n", column_sum_total(sum), naive_sum);
+        print_benchmark_row("sum loop", naive_seconds, row_count, naive_seconds);
+        print_benchmark_row("sum cols", column_seconds, row_count, naive_seconds);
+    }
+
+    free(results);
+    free(expected);
+    free(inputs);
+    free(compiled);
+
+    return true;
+}
+
+// Solves every row with the numeric type, returns the time it took and the result of the first row
+template <typename T>
+static f64 time_numeric_type(const DynamicArray<ExpressionElement>& elements, const f64* const variable_columns[], u64 row_count, T& first_result)
+{
+    DynamicArray<T> constants    = make<DynamicArray<T>>(elements.size);
+    DynamicArray<T> number_stack = make<DynamicArray<T>>(16Ui64);
+    convert_constants(elements, constants);
+
+    // Inputs are converted up front so only the solving is timed
+    DynamicArray<T> inputs = make<DynamicArray<T>>(BENCHMARK_VARIABLE_COUNT * row_count);
+    for (u64 i = 0; i < row_count; i++)
+    {
+        for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+            append(inputs, numeric_from_f64<T>(variable_columns[j][i]));
+    }
+
+    ExpressionError error;
+    const f64 start_time = platform_get_time_absolute();
+
+    for (u64 i = 0; i < row_count; i++)
+    {
+        const T result = solve_postfix_numeric(elements, constants, number_stack, inputs.data + i * BENCHMARK_VARIABLE_COUNT, error);
+        if (i == 0)
+            first_result = result;
+    }
+
+    const f64 seconds = platform_get_time_absolute() - start_time;
+
+    free(inputs);
+    free(number_stack);
+    free(constants);
+
+    return seconds;
+}
+
+static void print_numeric_row(const char* name, u32 digits, f64 seconds, u64 row_count, f64 f64_seconds)
+{
+    const f64 rows_per_second = (seconds > 0) ? row_count / seconds : 0.0;
+    const f64 cost = (f64_seconds > 0) ? seconds / f64_seconds : 0.0;
+
+    print("% | % | % ms | % rows/s | %x | ", name, digits, seconds * 1000.0, rows_per_second, cost);
+}
+
+bool run_numeric_benchmark(const String expression, u64 row_count)
+{
+    static const u32 decimal_precisions[] = { 20, 50, 100, 300 };
+
+    CompiledExpression compiled = {};
+    if (row_count == 0 || !compile_benchmark_expression(expression, compiled))
+        return false;
+
+    const f64* variable_columns[BENCHMARK_VARIABLE_COUNT];
+    DynamicArray<f64> inputs = make_benchmark_inputs(row_count, variable_columns);
+
+    print("Benchmarking \"%\" over % rows\n", expression, row_count);
+    print("type          | digits | time | throughput | cost | first row\n");
+
+    f64 f64_seconds;
+    {
+        f64 result;
+        f64_seconds = time_numeric_type(compiled.elements, variable_columns, row_count, result);
+
+        char buffer[32];
+        to_shortest_chars(result, buffer, sizeof(buffer));
+
+        print_numeric_row("f64          ", 17, f64_seconds, row_count, f64_seconds);
+        print("%\n", buffer);
+    }
+
+    {
+        DoubleDouble result;
+        const f64 seconds = time_numeric_type(compiled.elements, variable_columns, row_count, result);
+
+        print_numeric_row("double-double", 32, seconds, row_count, f64_seconds);
+        print("%\n", result);
+    }
+
+    const u32 previous_digits = get_decimal_precision();
+
+    for (u32 digits : decimal_precisions)
+    {
+        set_decimal_precision(digits);
+
+        Decimal result;
+        const f64 seconds = time_numeric_type(compiled.elements, variable_columns, row_count, result);
+
+        print_numeric_row("decimal      ", digits, seconds, row_count, f64_seconds);
+        print("%\n", result);
+    }
+
+    set_decimal_precision(previous_digits);
+
+    free(inputs);
+    free(compiled);
+
+    return true;
+}
+
+// Appends a random expression using x, y, z, small integers and every operator to the builder
+static void append_random_expression(DynamicArray<char>& builder, u32 depth, u64& state)
+{
+    static const char* const leaves[] = { "x", "y", "z", "1", "2", "3", "10", "pi", "e" };
+    static const char* const binary_operators[] = { " + ", " - ", " * ", " / ", " % ", " ^ ", " > ", " < ", " >= ", " <= ", " == ", " != ", " and ", " or " };
+    static const char* const unary_functions[] = { "-", "!", "sqrt", "exp", "ln", "sin", "cos", "tan", "sec", "cosec", "cot", "sinh", "cosh", "tanh" };
+    static const char* const binary_functions[] = { "max", "min", "log" };
+
+    const auto append_cstr = [&](const char* cstr) { append_many(builder, cstr, strlen(cstr)); };
+    const auto pick = [&](u32 count) { return (u32) (random_u64(state) % count); };
+
+    if (depth == 0)
+    {
+        append_cstr(leaves[pick(sizeof(leaves) / sizeof(leaves[0]))]);
+        return;
+    }
+
+    switch (pick(4))
+    {
+        case 0:
+        {
+            append(builder, '(');
+            append_random_expression(builder, depth - 1, state);
+            append_cstr(binary_operators[pick(sizeof(binary_operators) / sizeof(binary_operators[0]))]);
+            append_random_expression(builder, depth - 1, state);
+            append(builder, ')');
+        } break;
+
+        case 1:
+        {
+            append_cstr(unary_functions[pick(sizeof(unary_functions) / sizeof(unary_functions[0]))]);
+            append(builder, '(');
+            append_random_expression(builder, depth - 1, state);
+            append(builder, ')');
+        } break;
+
+        case 2:
+        {
+            append_cstr(binary_functions[pick(sizeof(binary_functions) / sizeof(binary_functions[0]))]);
+            append(builder, '(');
+            append_random_expression(builder, depth - 1, state);
+            append_cstr(", ");
+            append_random_expression(builder, depth - 1, state);
+            append(builder, ')');
+        } break;
+
+        case 3:
+        {
+            append_cstr("if(");
+            append_random_expression(builder, depth - 1, state);
+            append_cstr(", ");
+            append_random_expression(builder, depth - 1, state);
+            append_cstr(", ");
+            append_random_expression(builder, depth - 1, state);
+            append(builder, ')');
+        } break;
+    }
+}
+
+bool run_jit_check(u64 expression_count)
+{
+    constexpr u32 ROWS_PER_EXPRESSION = 64;
+
+    DynamicArray<char> builder = make<DynamicArray<char>>(256Ui64);
+    CompiledExpression compiled = {};
+
+    u64 state = 0x9E3779B97F4A7C15Ui64;
+    u64 failures = 0;
+
+    for (u64 i = 0; i < expression_count; i++)
+    {
+        clear(builder);
+        append_random_expression(builder, 1 + (u32) (random_u64(state) % 5), state);
+
+        const String expression = ref(builder.data, builder.size);
+
+        // Not optimizing so the machine code is generated for every operator
+        if (!compile_expression(expression, variable_names, BENCHMARK_VARIABLE_COUNT, compiled, false))
+        {
+            print_error("Could not compile random expression \"%\"!\n", expression);
+            failures++;
+            continue;
+        }
+
+        JitExpression jit;
+        if (!compile_jit(compiled.elements, jit))
+        {
+            print("JIT not supported on this platform\n");
+            break;
+        }
+
+        for (u32 j = 0; j < ROWS_PER_EXPRESSION; j++)
+        {
+            f64 row[BENCHMARK_VARIABLE_COUNT];
+            for (u32 k = 0; k < BENCHMARK_VARIABLE_COUNT; k++)
+                row[k] = random_in_range(state, -4.0, 4.0);
+
+            const f64 expected = solve_postfix_data(compiled.elements, compiled.number_stack, row);
+            const f64 actual   = jit.function(row, compiled.number_stack.data);
+            const f64 bytecode = run_bytecode(compiled.bytecode, row, compiled.number_stack.data);
+
+            // NaNs can differ in sign and payload depending on how the compiler ordered the operands
+            const bool both_nan = (expected != expected) && (actual != actual);
+
+            if (!both_nan && !platform_compare_memory(&expected, &actual, sizeof(f64)))
+            {
+                print_error("JIT result differs for \"%\" (x: %, y: %, z: %)\n", expression, row[0], row[1], row[2]);
+                failures++;
+                break;
+            }
+
+            // The bytecode skips the operands of if, and and or that aren't needed but should still give the same result
+            const bool bytecode_nan = (expected != expected) && (bytecode != bytecode);
+            if (!bytecode_nan && !platform_compare_memory(&expected, &bytecode, sizeof(f64)))
+            {
+                print_error("Bytecode result differs for \"%\" (x: %, y: %, z: %)\n", expression, row[0], row[1], row[2]);
+                failures++;
+                break;
+            }
+        }
+
+        free(jit);
+    }
+
+    print("Checked % random expressions, % failed\n", expression_count, failures);
+
+    free(compiled);
+    free(builder);
+
+    return failures == 0;
+}
+
+// Appends a random positive number in one of the formats the tokenizer has to handle
+static void append_random_number(DynamicArray<char>& text, u64& state)
+{
+    char buffer[512];
+    int length = 0;
+
+    const u64 bits = random_u64(state);
+    f64 value;
+    memcpy(&value, &bits, sizeof(f64));
+    value = fabs(value);
+
+    if (!std::isfinite(value))
+        value = 1.0;
+
+    switch (random_u64(state) % 5)
+    {
+        case 0:     // All the digits needed to round trip
+            length = snprintf(buffer, sizeof(buffer), "%.17g", value);
+            break;
+
+        case 1:     // Fewer digits, these are usually not exactly representable
+            length = snprintf(buffer, sizeof(buffer), "%.*g", 1 + (int) (random_u64(state) % 17), value);
+            break;
+
+        case 2:     // Hex float
+            length = snprintf(buffer, sizeof(buffer), "%a", value);
+            break;
+
+        case 3:     // Large integers, including the ones halfway between two f64s
+            length = snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long) (random_u64(state) >> (random_u64(state) % 64)));
+            break;
+
+        case 4:     // Random digits, long enough that some are dropped, with an exponent that can be out of range
+        {
+            const u32 integer_digits  = (u32) (random_u64(state) % 25) + 1;
+            const u32 fraction_digits = (u32) (random_u64(state) % 25);
+
+            for (u32 i = 0; i < integer_digits; i++)
+                buffer[length++] = '0' + (char) (random_u64(state) % 10);
+
+            if (fraction_digits > 0)
+            {
+                buffer[length++] = '.';
+                for (u32 i = 0; i < fraction_digits; i++)
+                    buffer[length++] = '0' + (char) (random_u64(state) % 10);
+            }
+
+            if (random_u64(state) % 2)
+                length += snprintf(buffer + length, sizeof(buffer) - length, "e%d", (int) (random_u64(state) % 701) - 350);
+        } break;
+    }
+
+    append_many(text, buffer, (u64) length);
+    append(text, '\0');
+}
+
+bool run_parser_check(u64 number_count)
+{
+    u64 state = 0x9E3779B97F4A7C15Ui64;
+
+    // Numbers are stored one after the other with null terminators for strtod
+    DynamicArray<char> text = make<DynamicArray<char>>(number_count * 24);
+    DynamicArray<u64> offsets = make<DynamicArray<u64>>(number_count);
+
+    for (u64 i = 0; i < number_count; i++)
+    {
+        append(offsets, text.size);
+        append_random_number(text, state);
+    }
+
+    u64 failures = 0;
+
+    for (u64 i = 0; i < number_count; i++)
+    {
+        const char* number = text.data + offsets[i];
+        const u64 length = strlen(number);
+
+        f64 actual;
+        const u64 used = parse_f64(number, length, actual);
+        const f64 expected = strtod(number, nullptr);
+
+        if (used != length || !platform_compare_memory(&expected, &actual, sizeof(f64)))
+        {
+            if (failures < 10)
+                print_error("Parsed \"%\" as % instead of % (used % of % characters)\n", number, actual, expected, used, length);
+
+            failures++;
+        }
+    }
+
+    print("Checked % random numbers against strtod, % failed\n", number_count, failures);
+
+    // Checksums of the bits are printed so the compiler can't skip the parsing
+    u64 parser_checksum = 0;
+    u64 atof_checksum = 0;
+
+    f64 start_time = platform_get_time();
+    for (u64 i = 0; i < number_count; i++)
+    {
+        f64 value;
+        const char* number = text.data + offsets[i];
+        parse_f64(number, text.size - offsets[i], value);
+
+        u64 bits;
+        memcpy(&bits, &value, sizeof(f64));
+        parser_checksum ^= bits;
+    }
+    const f64 parser_seconds = platform_get_time() - start_time;
+
+    start_time = platform_get_time();
+    for (u64 i = 0; i < number_count; i++)
+    {
+        const f64 value = atof(text.data + offsets[i]);
+
+        u64 bits;
+        memcpy(&bits, &value, sizeof(f64));
+        atof_checksum ^= bits;
+    }
+    const f64 atof_seconds = platform_get_time() - start_time;
+
+    print("parse_f64: % ns per number (checksum %)\n", parser_seconds * 1e9 / number_count, parser_checksum);
+    print("atof:      % ns per number (checksum %)\n", atof_seconds * 1e9 / number_count, atof_checksum);
+    print("Speedup:   %x\n", (parser_seconds > 0) ? atof_seconds / parser_seconds : 0.0);
+
+    free(offsets);
+    free(text);
+
+    return failures == 0;
+}
+
+bool run_format_benchmark(u64 number_count)
+{
+    u64 state = 0x2545F4914F6CDD1DUi64;
+
+    // Half of the numbers are random bit patterns (any exponent), the rest are the kind of results
+    // expressions usually have
+    DynamicArray<f64> numbers = make<DynamicArray<f64>>(number_count);
+    while (numbers.size < number_count)
+    {
+        f64 number;
+        if (numbers.size & 1)
+        {
+            number = (f64) (s64) (random_u64(state) % 2000000) / 1000.0 - 1000.0;
+        }
+        else
+        {
+            const u64 bits = random_u64(state);
+            memcpy(&number, &bits, sizeof(f64));
+        }
+
+        if (number == number)     // Skips NaN
+            append(numbers, number);
+    }
+
+    u64 failures = 0;
+    u64 shortest_length = 0;
+    u64 printf_length = 0;
+
+    for (u64 i = 0; i < number_count; i++)
+    {
+        char shortest[SHORTEST_F64_MAX_CHARS];
+        char printed[SHORTEST_F64_MAX_CHARS];
+
+        const u64 length = to_shortest_chars(numbers[i], shortest, SHORTEST_F64_MAX_CHARS);
+        shortest[length] = '\0';
+
+        shortest_length += length;
+        printf_length += snprintf(printed, sizeof(printed), "%.17g", numbers[i]);
+
+        const f64 parsed = strtod(shortest, nullptr);
+        if (!platform_compare_memory(&parsed, &numbers[i], sizeof(f64)))
+        {
+            if (failures < 10)
+                print_error("Formatted % as \"%\" which reads back as %\n", numbers[i], shortest, parsed);
+
+            failures++;
+        }
+    }
+
+    print("Checked % random numbers, % didn't read back the same\n", number_count, failures);
+    print("Average length: % characters (snprintf: %)\n", (f64) shortest_length / number_count, (f64) printf_length / number_count);
+
+    // Sums of the lengths are printed so the compiler can't skip the formatting
+    char buffer[SHORTEST_F64_MAX_CHARS];
+
+    u64 shortest_checksum = 0;
+    f64 start_time = platform_get_time();
+    for (u64 i = 0; i < number_count; i++)
+        shortest_checksum += to_shortest_chars(numbers[i], buffer, SHORTEST_F64_MAX_CHARS);
+    const f64 shortest_seconds = platform_get_time() - start_time;
+
+    u64 printf_checksum = 0;
+    start_time = platform_get_time();
+    for (u64 i = 0; i < number_count; i++)
+        printf_checksum += snprintf(buffer, sizeof(buffer), "%.17g", numbers[i]);
+    const f64 printf_seconds = platform_get_time() - start_time;
+
+    u64 to_string_checksum = 0;
+    start_time = platform_get_time();
+    for (u64 i = 0; i < number_count; i++)
+    {
+        String str = ref(buffer, 0Ui64);
+        to_string(str, numbers[i]);
+        to_string_checksum += str.size;
+    }
+    const f64 to_string_seconds = platform_get_time() - start_time;
+
+    print("to_shortest_chars: % ns per number (checksum %)\n", shortest_seconds * 1e9 / number_count, shortest_checksum);
+    print("snprintf:          % ns per number (checksum %)\n", printf_seconds * 1e9 / number_count, printf_checksum);
+    print("to_string:         % ns per number (checksum %)\n", to_string_seconds * 1e9 / number_count, to_string_checksum);
+    print("Speedup:           %x over snprintf\n", (shortest_seconds > 0) ? printf_seconds / shortest_seconds : 0.0);
+
+    free(numbers);
+
+    return failures == 0;
+}
+
+bool run_gradient_benchmark(const String expression, u64 row_count)
+{
+    CompiledExpression compiled = {};
+    if (!compile_benchmark_expression(expression, compiled))
+        return false;
+
+    // Inputs and gradients are stored as rows
+    DynamicArray<f64> inputs = make_benchmark_inputs(row_count);
+
+    DynamicArray<f64> expected = make<DynamicArray<f64>>(BENCHMARK_VARIABLE_COUNT * row_count);
+    DynamicArray<f64> results  = make<DynamicArray<f64>>(BENCHMARK_VARIABLE_COUNT * row_count);
+    expected.size = results.size = expected.capacity;
+
+    print("Differentiating \"%\" with respect to x, y and z over % rows\n", expression, row_count);
+
+    f64 evaluate_seconds;
+    {   // One evaluation per row for comparison
+        f64 checksum = 0.0;
+        const f64 start_time = platform_get_time_absolute();
+
+        for (u64 i = 0; i < row_count; i++)
+            checksum += evaluate(compiled, inputs.data + i * BENCHMARK_VARIABLE_COUNT);
+
+        evaluate_seconds = platform_get_time_absolute() - start_time;
+        print("evaluate : % ms (checksum %)\n", evaluate_seconds * 1000.0, checksum);
+    }
+
+    f64 difference_seconds;
+    {   // Central differences, two evaluations per variable
+        const f64 start_time = platform_get_time_absolute();
+
+        f64 row[BENCHMARK_VARIABLE_COUNT];
+        for (u64 i = 0; i < row_count; i++)
+        {
+            const f64* input = inputs.data + i * BENCHMARK_VARIABLE_COUNT;
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+                row[j] = input[j];
+
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+            {
+                const f64 step = 1e-6 * max(1.0, fabs(input[j]));
+
+                row[j] = input[j] + step;
+                const f64 above = evaluate(compiled, row);
+                row[j] = input[j] - step;
+                const f64 below = evaluate(compiled, row);
+                row[j] = input[j];
+
+                results[i * BENCHMARK_VARIABLE_COUNT + j] = (above - below) / (2.0 * step);
+            }
+        }
+
+        difference_seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("finite differences", difference_seconds, row_count, difference_seconds);
+    }
+
+    {   // Reverse mode, one pass over the tape per row
+        GradientTape tape = make_gradient_tape(compiled.elements.size);
+
+        const f64 start_time = platform_get_time_absolute();
+
+        for (u64 i = 0; i < row_count; i++)
+            evaluate_gradient(compiled, inputs.data + i * BENCHMARK_VARIABLE_COUNT, expected.data + i * BENCHMARK_VARIABLE_COUNT, tape);
+
+        const f64 seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("reverse mode      ", seconds, row_count, difference_seconds);
+        print("Reverse mode costs %x an evaluation\n", (evaluate_seconds > 0) ? seconds / evaluate_seconds : 0.0);
+
+        free(tape);
+    }
+
+    // Finite differences are only approximations, the largest difference is shown to catch wrong derivative rules
+    f64 largest_difference = 0.0;
+    for (u64 i = 0; i < results.size; i++)
+    {
+        const f64 difference = fabs(results[i] - expected[i]) / max(1.0, fabs(expected[i]));
+        if (difference > largest_difference)
+            largest_difference = difference;
+    }
+
+    print("Largest relative difference from finite differences: %\n", largest_difference);
+
+    {   // Forward mode, one pass per variable
+        DynamicArray<Dual> dual_stack = make<DynamicArray<Dual>>(16Ui64);
+
+        const f64 start_time = platform_get_time_absolute();
+
+        for (u64 i = 0; i < row_count; i++)
+        {
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+            {
+                evaluate_derivative(compiled, inputs.data + i * BENCHMARK_VARIABLE_COUNT, j,
+                                    results[i * BENCHMARK_VARIABLE_COUNT + j], dual_stack);
+            }
+        }
+
+        const f64 seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("forward mode      ", seconds, row_count, difference_seconds);
+
+        free(dual_stack);
+    }
+
+    // Both modes apply the same rules so they should only differ by rounding
+    u64 mismatches = 0;
+    for (u64 i = 0; i < results.size; i++)
+    {
+        const bool both_nan = (expected[i] != expected[i]) && (results[i] != results[i]);
+        mismatches += !both_nan && fabs(results[i] - expected[i]) > 1e-9 * max(1.0, fabs(expected[i]));
+    }
+
+    if (mismatches > 0)
+        print_error("Forward and reverse mode differ in % derivatives!\n", mismatches);
+
+    free(results);
+    free(expected);
+    free(inputs);
+    free(compiled);
+
+    return mismatches == 0;
+}
+
+bool run_interval_check(const String expression, u64 box_count)
+{
+    CompiledExpression compiled = {};
+    if (!compile_benchmark_expression(expression, compiled, false))
+        return false;
+
+    // Boxes are stored as columns of low and high bounds, widths are up to 1
+    u64 state = 0x9E3779B97F4A7C15Ui64;
+    DynamicArray<f64> bounds = make<DynamicArray<f64>>(2 * BENCHMARK_VARIABLE_COUNT * box_count);
+    bounds.size = bounds.capacity;
+
+    const f64* variable_lows[BENCHMARK_VARIABLE_COUNT];
+    const f64* variable_highs[BENCHMARK_VARIABLE_COUNT];
+
+    for (u32 i = 0; i < BENCHMARK_VARIABLE_COUNT; i++)
+    {
+        f64* lows  = bounds.data + (2 * i) * box_count;
+        f64* highs = bounds.data + (2 * i + 1) * box_count;
+
+        for (u64 j = 0; j < box_count; j++)
+        {
+            lows[j]  = random_in_range(state, -2.0, 2.0);
+            highs[j] = lows[j] + random_in_range(state, 0.0, 1.0);
+        }
+
+        variable_lows[i]  = lows;
+        variable_highs[i] = highs;
+    }
+
+    DynamicArray<f64> result_lows  = make<DynamicArray<f64>>(box_count);
+    DynamicArray<f64> result_highs = make<DynamicArray<f64>>(box_count);
+    result_lows.size = result_highs.size = box_count;
+
+    print("Bounding \"%\" over % boxes\n", expression, box_count);
+
+    // The numbers of the compiled expression have no source, so only integers are exact
+    DynamicArray<Interval> constants      = make<DynamicArray<Interval>>(compiled.elements.size);
+    DynamicArray<Interval> interval_stack = make<DynamicArray<Interval>>(16Ui64);
+    convert_interval_constants(compiled.elements, expression, constants);
+
+    u64 mismatches = 0;
+
+    f64 single_seconds;
+    {   // One box at a time
+        const f64 start_time = platform_get_time_absolute();
+
+        Interval box[BENCHMARK_VARIABLE_COUNT];
+        for (u64 i = 0; i < box_count; i++)
+        {
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+                box[j] = Interval { variable_lows[j][i], variable_highs[j][i] };
+
+            const Interval result = solve_postfix_interval(compiled.elements, constants, interval_stack, box);
+            result_lows[i]  = result.low;
+            result_highs[i] = result.high;
+        }
+
+        single_seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("single ", single_seconds, box_count, single_seconds);
+    }
+
+    {   // A block of boxes at a time, has to give the same bounds
+        DynamicArray<f64> column_lows  = make<DynamicArray<f64>>(box_count);
+        DynamicArray<f64> column_highs = make<DynamicArray<f64>>(box_count);
+        column_lows.size = column_highs.size = box_count;
+
+        IntervalScratch scratch = {};
+
+        const f64 start_time = platform_get_time_absolute();
+        solve_postfix_intervals(compiled.elements, constants, variable_lows, variable_highs, box_count, column_lows.data, column_highs.data, scratch);
+        const f64 seconds = platform_get_time_absolute() - start_time;
+
+        print_benchmark_row("columns", seconds, box_count, single_seconds);
+        report_mismatches("Interval columns (low bounds)", result_lows.data, column_lows.data, box_count);
+        report_mismatches("Interval columns (high bounds)", result_highs.data, column_highs.data, box_count);
+
+        free(scratch);
+        free(column_highs);
+        free(column_lows);
+    }
+
+    // Corners and random points in every box have to be inside the bounds (undefined points are skipped)
+    constexpr u32 SAMPLES_PER_BOX = 16;
+
+    f64 row[BENCHMARK_VARIABLE_COUNT];
+    f64 total_width = 0.0;
+
+    for (u64 i = 0; i < box_count; i++)
+    {
+        for (u32 sample = 0; sample < SAMPLES_PER_BOX; sample++)
+        {
+            for (u32 j = 0; j < BENCHMARK_VARIABLE_COUNT; j++)
+            {
+                const f64 t = (sample < (1u << BENCHMARK_VARIABLE_COUNT)) ? (f64) ((sample >> j) & 1) : random_in_range(state, 0.0, 1.0);
+                row[j] = fmin(variable_lows[j][i] + t * (variable_highs[j][i] - variable_lows[j][i]), variable_highs[j][i]);
+            }
+
+            const f64 value = solve_postfix_data(compiled.elements, compiled.number_stack, row);
+            if (value == value && (value < result_lows[i] || value > result_highs[i]))
+            {
+                if (mismatches < 10)
+                    print_error("Value % at (%, %, %) is outside of [%, %]!\n", value, row[0], row[1], row[2], result_lows[i], result_highs[i]);
+
+                mismatches++;
+            }
+        }
+
+        if (result_highs[i] - result_lows[i] < INFINITY)
+            total_width += result_highs[i] - result_lows[i];
+    }
+
+    print("Checked % samples, % outside of the bounds\n", box_count * SAMPLES_PER_BOX, mismatches);
+    print("Average finite width: %\n", total_width / box_count);
+
+    free(interval_stack);
+    free(constants);
+    free(result_highs);
+    free(result_lows);
+    free(bounds);
+    free(compiled);
+
+    return mismatches == 0;
+}
+
+static bool same_elements(const ExpressionElement expected[], u64 expected_count, const ExpressionElement actual[], u64 actual_count)
+{
+    if (expected_count != actual_count)
+        return false;
+
+    for (u64 i = 0; i < expected_count; i++)
+    {
+        if (expected[i].type != actual[i].type)
+            return false;
+
+        switch (expected[i].type)
+        {
+            case ExpressionElement::Type::NUMBER:
+            {
+                if (!platform_compare_memory(&expected[i].value, &actual[i].value, sizeof(f64)))
+                    return false;
+            } break;
+
+            case ExpressionElement::Type::OPERATOR:
+            {
+                if (expected[i].op_code != actual[i].op_code)
+                    return false;
+            } break;
+
+            case ExpressionElement::Type::VARIABLE:
+            {
+                if (expected[i].variable.index != actual[i].variable.index)
+                    return false;
+            } break;
+        }
+    }
+
+    return true;
+}
+
+bool run_allocation_check(u64 expression_count)
+{
+    constexpr u64 ELEMENT_CAPACITY  = 4096;
+    constexpr u64 OP_STACK_CAPACITY = 256;
+
+    // Calls to a user function have to be inlined without allocating too
+    if (!find_user_function(ref("twice")))
+        define_function(ref("twice(a) = 2 * a"));
+
+    // Every expression is generated up front so only the tokenizer runs while counting allocations
+    DynamicArray<char> text = make<DynamicArray<char>>(256 * expression_count);
+    DynamicArray<u64> text_ends = make<DynamicArray<u64>>(expression_count);
+    u64 state = 0x9E3779B97F4A7C15Ui64;
+
+    for (u64 i = 0; i < expression_count; i++)
+    {
+        const bool call_function = (random_u64(state) % 4) == 0;
+        if (call_function)
+            append_many(text, "twice(", 6);
+
+        append_random_expression(text, 1 + (u32) (random_u64(state) % 5), state);
+
+        if (call_function)
+            append(text, ')');
+
+        append(text_ends, text.size);
+    }
+
+    DynamicArray<ExpressionElement> element_buffer = make<DynamicArray<ExpressionElement>>(ELEMENT_CAPACITY);
+    DynamicArray<OperatorOrBracket> op_buffer = make<DynamicArray<OperatorOrBracket>>(OP_STACK_CAPACITY);
+
+    TokenBuffers buffers;
+    buffers.elements          = element_buffer.data;
+    buffers.element_capacity  = element_buffer.capacity;
+    buffers.element_count     = 0;
+    buffers.op_stack          = op_buffer.data;
+    buffers.op_stack_capacity = op_buffer.capacity;
+
+    DynamicArray<ExpressionElement> expected = make<DynamicArray<ExpressionElement>>(64Ui64);
+    DynamicArray<OperatorOrBracket> temp_op_stack = make<DynamicArray<OperatorOrBracket>>(32Ui64);
+
+    print("Tokenizing % random expressions into fixed buffers\n", expression_count);
+
+    ExpressionError error;
+    u64 allocations = 0;
+    u64 failures = 0;
+
+    for (u64 i = 0; i < expression_count; i++)
+    {
+        const u64 start = (i > 0) ? text_ends[i - 1] : 0;
+        const String expression = ref(text.data + start, text_ends[i] - start);
+
+        const u64 allocations_before = platform_get_allocation_count();
+        const bool success = infix_expression_to_postfix(expression, buffers, error, variable_names, BENCHMARK_VARIABLE_COUNT);
+        allocations += platform_get_allocation_count() - allocations_before;
+
+        const bool expected_success = infix_expression_to_postfix(expression, expected, temp_op_stack, variable_names, BENCHMARK_VARIABLE_COUNT);
+
+        if (success != expected_success || (success && !same_elements(expected.data, expected.size, buffers.elements, buffers.element_count)))
+        {
+            if (failures < 10)
+                print_error("Fixed buffers give a different result for \"%\"!\n", expression);
+
+            failures++;
+        }
+    }
+
+    print("Checked % expressions, % differ, % allocations\n", expression_count, failures, allocations);
+
+    {   // Timing, same expressions with reused arrays and with fixed buffers
+        f64 start_time = platform_get_time_absolute();
+        for (u64 i = 0; i < expression_count; i++)
+        {
+            const u64 start = (i > 0) ? text_ends[i - 1] : 0;
+            infix_expression_to_postfix(ref(text.data + start, text_ends[i] - start), expected, temp_op_stack, variable_names, BENCHMARK_VARIABLE_COUNT);
+        }
+        const f64 reused_seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("reused arrays", reused_seconds, expression_count, reused_seconds);
+
+        start_time = platform_get_time_absolute();
+        for (u64 i = 0; i < expression_count; i++)
+        {
+            const u64 start = (i > 0) ? text_ends[i - 1] : 0;
+            infix_expression_to_postfix(ref(text.data + start, text_ends[i] - start), buffers, error, variable_names, BENCHMARK_VARIABLE_COUNT);
+        }
+        const f64 fixed_seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("fixed buffers", fixed_seconds, expression_count, reused_seconds);
+    }
+
+    // Buffers that are too small have to be rejected instead of overflowing
+    TokenBuffers small_buffers = buffers;
+    small_buffers.element_capacity = 2;
+
+    if (infix_expression_to_postfix(ref("twice(1 + 2 * 3)"), small_buffers, error) || error.code != ErrorCode::BUFFER_FULL)
+    {
+        print_error("Expression didn't fit in the buffers but tokenizing succeeded!\n");
+        failures++;
+    }
+
+    free(temp_op_stack);
+    free(expected);
+    free(op_buffer);
+    free(element_buffer);
+    free(text_ends);
+    free(text);
+
+    return failures == 0 && allocations == 0;
+}
+
+bool run_error_check(u64 expression_count)
+{
+    const f64 row[BENCHMARK_VARIABLE_COUNT] = { 0.25, -0.5, 0.75 };
+
+    // Every fourth expression is broken by appending something, the rest are valid
+    static const char* const suffixes[] = { " *", " .", " 4", " + * 2", " # 1" };
+    static const ErrorCode suffix_errors[] = { ErrorCode::MISSING_OPERAND, ErrorCode::INVALID_NUMBER, ErrorCode::EXTRA_VALUES,
+                                               ErrorCode::MISSING_OPERAND, ErrorCode::UNKNOWN_SYMBOL };
+    constexpr u32 SUFFIX_COUNT = sizeof(suffixes) / sizeof(suffixes[0]);
+
+    DynamicArray<char> text = make<DynamicArray<char>>(256 * expression_count);
+    DynamicArray<u64> text_ends = make<DynamicArray<u64>>(expression_count);
+    DynamicArray<ErrorCode> expected_errors = make<DynamicArray<ErrorCode>>(expression_count);
+    u64 state = 0x9E3779B97F4A7C15Ui64;
+
+    for (u64 i = 0; i < expression_count; i++)
+    {
+        append_random_expression(text, 1 + (u32) (random_u64(state) % 5), state);
+
+        ErrorCode expected_error = ErrorCode::NONE;
+        if ((i % 4) == 3)
+        {
+            const u32 pick = (u32) (random_u64(state) % SUFFIX_COUNT);
+            append_many(text, suffixes[pick], strlen(suffixes[pick]));
+            expected_error = suffix_errors[pick];
+        }
+
+        append(text_ends, text.size);
+        append(expected_errors, expected_error);
+    }
+
+    DynamicArray<ExpressionElement> elements = make<DynamicArray<ExpressionElement>>(64Ui64);
+    DynamicArray<OperatorOrBracket> op_stack = make<DynamicArray<OperatorOrBracket>>(32Ui64);
+    DynamicArray<f64> number_stack = make<DynamicArray<f64>>(32Ui64);
+
+    print("Checking the errors of % random expressions\n", expression_count);
+
+    ExpressionError error;
+    u64 failures = 0;
+
+    for (u64 i = 0; i < expression_count; i++)
+    {
+        const u64 start = (i > 0) ? text_ends[i - 1] : 0;
+        const String expression = ref(text.data + start, text_ends[i] - start);
+
+        if (infix_expression_to_postfix(expression, elements, op_stack, error, variable_names, BENCHMARK_VARIABLE_COUNT))
+            solve_postfix_data(elements, number_stack, row, error);
+
+        // Errors have to point inside the expression (or at its end)
+        const bool offset_valid = (error.code == ErrorCode::NONE) || error.offset <= max(expression.size, elements.size);
+        if (error.code != expected_errors[i] || !offset_valid)
+        {
+            if (failures < 10)
+                print_error("Expected \"%\" for \"%\" but got \"%\" at %!\n",
+                            error_message(expected_errors[i]), expression, error_message(error.code), error.offset);
+
+            failures++;
+        }
+    }
+
+    print("Checked % expressions, % reported the wrong error\n", expression_count, failures);
+
+    {   // Timing, only the valid expressions since those are the ones that shouldn't get slower
+        f64 start_time = platform_get_time_absolute();
+        for (u64 i = 0; i < expression_count; i++)
+        {
+            if (expected_errors[i] != ErrorCode::NONE)
+                continue;
+
+            const u64 start = (i > 0) ? text_ends[i - 1] : 0;
+            infix_expression_to_postfix(ref(text.data + start, text_ends[i] - start), elements, op_stack, variable_names, BENCHMARK_VARIABLE_COUNT);
+            solve_postfix_data(elements, number_stack, row);
+        }
+        const f64 plain_seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("without errors", plain_seconds, expression_count, plain_seconds);
+
+        start_time = platform_get_time_absolute();
+        for (u64 i = 0; i < expression_count; i++)
+        {
+            if (expected_errors[i] != ErrorCode::NONE)
+                continue;
+
+            const u64 start = (i > 0) ? text_ends[i - 1] : 0;
+            infix_expression_to_postfix(ref(text.data + start, text_ends[i] - start), elements, op_stack, error, variable_names, BENCHMARK_VARIABLE_COUNT);
+            solve_postfix_data(elements, number_stack, row, error);
+        }
+        const f64 error_seconds = platform_get_time_absolute() - start_time;
+        print_benchmark_row("with errors   ", error_seconds, expression_count, plain_seconds);
+    }
+
+    {   // Every call doubles the size of its argument, nesting them has to fail instead of growing exponentially
+        if (!find_user_function(ref("square")))
+            define_function(ref("square(a) = a * a"));
+
+        clear(text);
+        for (u32 i = 0; i < 24; i++)
+            append_many(text, "square(", 7);
+
+        append(text, 'x');
+        for (u32 i = 0; i < 24; i++)
+            append(text, ')');
+
+        if (infix_expression_to_postfix(ref(text.data, text.size), elements, op_stack, error, variable_names, BENCHMARK_VARIABLE_COUNT) ||
+            error.code != ErrorCode::TOO_LARGE)
+        {
+            print_error("Nested calls to square weren't rejected as too large!\n");
+            failures++;
+        }
+    }
+
+    free(number_stack);
+    free(op_stack);
+    free(elements);
+    free(expected_errors);
+    free(text_ends);
+    free(text);
+
+    return failures == 0;
+}
+
+struct MathCheck
+{
+    const char* name;
+    void (*vector_function)(const f64[], f64[], u64);
+    f64  (*libm_function)(f64);
+    f64 low, high;      // Arguments are uniform in the range, or their log2 is if spread is set
+    bool spread;
+    u64 bound;          // Most ulp the results can be off by, as documented in vector_math.h
+};
+
+bool run_math_check(u64 count)
+{
+    constexpr MathCheck checks[] = {
+        { "exp ", vector_exp,  exp,  -1.0,    1.0,    false, 1 },
+        { "exp ", vector_exp,  exp,  -745.0,  710.0,  false, 1 },
+        { "log ", vector_log,  log,   0.5,    2.0,    false, 1 },
+        { "log ", vector_log,  log,  -1074.0, 1024.0, true,  1 },
+        { "sin ", vector_sin,  sin,  -10.0,   10.0,   false, 1 },
+        { "sin ", vector_sin,  sin,  -1e6,    1e6,    false, 1 },
+        { "cos ", vector_cos,  cos,  -10.0,   10.0,   false, 1 },
+        { "cos ", vector_cos,  cos,  -1e6,    1e6,    false, 1 },
+        { "tan ", vector_tan,  tan,  -10.0,   10.0,   false, 3 },
+        { "tan ", vector_tan,  tan,  -1e6,    1e6,    false, 3 },
+        { "sinh", vector_sinh, sinh, -1.0,    1.0,    false, 3 },
+        { "sinh", vector_sinh, sinh, -720.0,  720.0,  false, 3 },
+        { "cosh", vector_cosh, cosh, -1.0,    1.0,    false, 2 },
+        { "cosh", vector_cosh, cosh, -720.0,  720.0,  false, 2 },
+        { "tanh", vector_tanh, tanh, -1.0,    1.0,    false, 4 },
+        { "tanh", vector_tanh, tanh, -30.0,   30.0,   false, 4 },
+    };
+
+    u64 state = 0x2545F4914F6CDD1DUi64;
+
+    DynamicArray<f64> inputs    = make<DynamicArray<f64>>(count);
+    DynamicArray<f64> exponents = make<DynamicArray<f64>>(count);
+    DynamicArray<f64> expected  = make<DynamicArray<f64>>(count);
+    DynamicArray<f64> actual    = make<DynamicArray<f64>>(count);
+    inputs.size = exponents.size = expected.size = actual.size = count;
+
+    u64 failures = 0;
+
+    for (const MathCheck& check : checks)
+    {
+        for (u64 i = 0; i < count; i++)
+        {
+            const f64 value = random_in_range(state, check.low, check.high);
+            inputs[i] = check.spread ? exp2(value) : value;
+        }
+
+        f64 start_time = platform_get_time_absolute();
+        for (u64 i = 0; i < count; i++)
+            expected[i] = check.libm_function(inputs[i]);
+        const f64 libm_seconds = platform_get_time_absolute() - start_time;
+
+        start_time = platform_get_time_absolute();
+        check.vector_function(inputs.data, actual.data, count);
+        const f64 vector_seconds = platform_get_time_absolute() - start_time;
+
+        u64 max_error = 0;
+        u64 worst = 0;
+        for (u64 i = 0; i < count; i++)
+        {
+            const u64 error = ulp_difference(expected[i], actual[i]);
+            if (error > max_error)
+            {
+                max_error = error;
+                worst = i;
+            }
+        }
+
+        if (check.spread)
+            print("% in [2^%, 2^%]: % ulp at most\n", check.name, check.low, check.high, max_error);
+        else
+            print("% in [%, %]: % ulp at most\n", check.name, check.low, check.high, max_error);
+
+        if (max_error > check.bound)
+        {
+            print_error("% is off by % ulp for % (% instead of %)!\n", check.name, max_error, ShortestF64 { inputs[worst] },
+                        ShortestF64 { actual[worst] }, ShortestF64 { expected[worst] });
+            failures++;
+        }
+
+        print_benchmark_row("   libm  ", libm_seconds, count, libm_seconds);
+        print_benchmark_row("   vector", vector_seconds, count, libm_seconds);
+    }
+
+    {   // pow, the error grows with the size of the result's exponent
+        struct { f64 base_low, base_high, exponent_low, exponent_high; u64 bound; } pow_checks[] = {
+            { 0.0,  10.0, -10.0,    10.0,    1 },
+            { 0.9,  1.1,  -5000.0,  5000.0,  4 },
+            { -4.0, 4.0,  -10.0,    10.0,    1 },
+        };
+
+        for (const auto& check : pow_checks)
+        {
+            for (u64 i = 0; i < count; i++)
+            {
+                inputs[i] = random_in_range(state, check.base_low, check.base_high);
+                exponents[i] = random_in_range(state, check.exponent_low, check.exponent_high);
+
+                // Negative bases only have real powers for integer exponents
+                if (inputs[i] < 0.0)
+                    exponents[i] = round(exponents[i]);
+            }
+
+            f64 start_time = platform_get_time_absolute();
+            for (u64 i = 0; i < count; i++)
+                expected[i] = pow(inputs[i], exponents[i]);
+            const f64 libm_seconds = platform_get_time_absolute() - start_time;
+
+            start_time = platform_get_time_absolute();
+            vector_pow(inputs.data, exponents.data, actual.data, count);
+            const f64 vector_seconds = platform_get_time_absolute() - start_time;
+
+            u64 max_error = 0;
+            u64 worst = 0;
+            for (u64 i = 0; i < count; i++)
+            {
+                const u64 error = ulp_difference(expected[i], actual[i]);
+                if (error > max_error)
+                {
+                    max_error = error;
+                    worst = i;
+                }
+            }
+
+            print("pow  in [%, %]^[%, %]: % ulp at most\n", check.base_low, check.base_high, check.exponent_low, check.exponent_high, max_error);
+
+            if (max_error > check.bound)
+            {
+                print_error("pow is off by % ulp for %^% (% instead of %)!\n", max_error, ShortestF64 { inputs[worst] }, ShortestF64 { exponents[worst] },
+                            ShortestF64 { actual[worst] }, ShortestF64 { expected[worst] });
+                failures++;
+            }
+
+            print_benchmark_row("   libm  ", libm_seconds, count, libm_seconds);
+            print_benchmark_row("   vector", vector_seconds, count, libm_seconds);
+        }
+    }
+
+    free(actual);
+    free(expected);
+    free(exponents);
+    free(inputs);
+
+    return failures == 0;
+}
+
+bool run_branch_benchmark(u64 row_count)
+{
+    static const char* const formulas[] = {
+        "if(x > 0, sin(x) * cos(y) + exp(z) * tanh(x), sqrt(y * y + 1) * ln(z + 2) - cosh(x))",
+        "if(x < -0.5, sin(y), if(x < 0, cos(y), if(x < 0.5, exp(y), ln(y + 2))))",
+        "x > 0.5 and sin(y)^2 + cos(z)^2 > exp(x) / 3 or y < -0.5 and sinh(z) > tanh(x)",
+        "if(x * y > 0, y^z + sinh(y) * cos(z), 0) + if(z > 0.8, ln(x * x + 1) / sin(z), 1)",
+    };
+
+    // Inputs are stored as rows
+    DynamicArray<f64> inputs = make_benchmark_inputs(row_count);
+
+    DynamicArray<f64> expected = make<DynamicArray<f64>>(row_count);
+    DynamicArray<f64> results  = make<DynamicArray<f64>>(row_count);
+    expected.size = results.size = row_count;
+
+    CompiledExpression compiled = {};
+    Bytecode eager = {};
+    Bytecode lazy = {};
+    DynamicArray<f64> stack = make<DynamicArray<f64>>(16Ui64);
+
+    u64 failures = 0;
+
+    for (const char* formula : formulas)
+    {
+        const String expression = ref((char*) formula);
+
+        if (!compile_expression(expression, variable_names, BENCHMARK_VARIABLE_COUNT, compiled) ||
+            !compile_bytecode(compiled.elements, eager, false) || !compile_bytecode(compiled.elements, lazy))
+        {
+            print_error("Could not compile expression \"%\"!\n", expression);
+            failures++;
+            continue;
+        }
+
+        if (stack.capacity < eager.stack_size)
+            resize(stack, eager.stack_size);
+
+        print("\"%\" over % rows\n", expression, row_count);
+
+        f64 start_time = platform_get_time_absolute();
+        for (u64 i = 0; i < row_count; i++)
+            expected[i] = run_bytecode(eager, inputs.data + i * BENCHMARK_VARIABLE_COUNT, stack.data);
+        const f64 eager_seconds = platform_get_time_absolute() - start_time;
+
+        start_time = platform_get_time_absolute();
+        for (u64 i = 0; i < row_count; i++)
+            results[i] = run_bytecode(lazy, inputs.data + i * BENCHMARK_VARIABLE_COUNT, stack.data);
+        const f64 lazy_seconds = platform_get_time_absolute() - start_time;
+
+        print_benchmark_row("   every operand", eager_seconds, row_count, eager_seconds);
+        print_benchmark_row("   short circuit", lazy_seconds, row_count, eager_seconds);
+
+        if (memcmp(expected.data, results.data, row_count * sizeof(f64)) != 0)
+        {
+            print_error("Short circuit results differ for \"%\"!\n", expression);
+            failures++;
+        }
+    }
+
+    free(stack);
+    free(lazy);
+    free(eager);
+    free(compiled);
+    free(results);
+    free(expected);
+    free(inputs);
+
+    return failures == 0;
+}
+
+} // namespace Calculator
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "containers/string.h"
+#include "core/types.h"
+
+namespace Calculator
+{
+
+// Solves the expression for row_count rows with the variables x, y and z set to random values
+// in [-1, 1) using every evaluator, and prints how long each of them took.
+bool run_benchmark(const String expression, u64 row_count);
+
+// Solves the expression for row_count rows with every numeric type (decimal with a few precisions)
+// and prints a table with the time each of them took and the result of the first row.
+bool run_numeric_benchmark(const String expression, u64 row_count);
+
+// Compiles random expressions to machine code and bytecode and checks that the results are bit for bit
+// the same as the postfix solver on random inputs (any NaN is considered the same as any other NaN).
+bool run_jit_check(u64 expression_count);
+
+// Parses random numbers (decimal, hex, long and out of range ones) and checks that the results are bit
+// for bit the same as strtod. Also prints how long parsing took compared to atof.
+bool run_parser_check(u64 number_count);
+
+// Formats random numbers with to_shortest_chars and checks that strtod reads them back bit for bit.
+// Also prints how long formatting took compared to printf("%.17g") and to_string.
+bool run_format_benchmark(u64 number_count);
+
+// Computes the gradient of the expression with respect to x, y and z for row_count random rows with
+// finite differences, reverse mode and forward mode, and prints how long each of them took.
+bool run_gradient_benchmark(const String expression, u64 row_count);
+
+// Bounds the expression over box_count random boxes of x, y and z one box at a time and a block at a time,
+// and checks that the corners and random points of every box are inside the bounds.
+bool run_interval_check(const String expression, u64 box_count);
+
+// Tokenizes random expressions (some calling a user function) into caller owned buffers, checks that
+// no memory was allocated and that the results are the same as with growing arrays.
+bool run_allocation_check(u64 expression_count);
+
+// Breaks some random expressions (missing operands, invalid numbers, extra values) and checks that tokenizing
+// and solving report the right error. Also prints how long the valid ones take with and without errors.
+bool run_error_check(u64 expression_count);
+
+// Compares the functions in vector_math.h with libm for count random arguments in a few ranges each, and checks
+// that they are within the documented number of ulp. Also prints how long each of them took compared to libm.
+bool run_math_check(u64 count);
+
+// Solves a few formulas full of if, and and or for row_count rows with random x, y and z using bytecode that
+// evaluates every operand and bytecode that skips the ones that aren't needed, and prints how long each took.
+bool run_branch_benchmark(u64 row_count);
+
+} // namespace Calculator
@@ -0,0 +1,350 @@
+#include "bytecode.h"
+
+#include <cstring>
+#include "containers/darray.h"
+#include "core/types.h"
+#include "math/common.h"
+#include "solver.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+inline static void emit_opcode(Bytecode& bytecode, Opcode opcode)
+{
+    append(bytecode.code, (u8) opcode);
+}
+
+inline static void emit_f64(Bytecode& bytecode, f64 value)
+{
+    append_many(bytecode.code, (const u8*) &value, sizeof(f64));
+}
+
+inline static void emit_u16(Bytecode& bytecode, u16 value)
+{
+    append_many(bytecode.code, (const u8*) &value, sizeof(u16));
+}
+
+// Emits a jump with a target that is filled in by patch_jump, returns where the target goes
+inline static u32 emit_jump(Bytecode& bytecode, Opcode opcode)
+{
+    emit_opcode(bytecode, opcode);
+
+    const u32 target_offset = (u32) bytecode.code.size;
+    const u32 placeholder = 0;
+    append_many(bytecode.code, (const u8*) &placeholder, sizeof(u32));
+
+    return target_offset;
+}
+
+// Makes the jump go to the end of the code emitted so far
+inline static void patch_jump(Bytecode& bytecode, u32 target_offset)
+{
+    const u32 target = (u32) bytecode.code.size;
+    memcpy(bytecode.code.data + target_offset, &target, sizeof(u32));
+}
+
+// Inline operands aren't aligned, memcpy turns into a plain load
+inline static f64 read_f64(const u8* ip)
+{
+    f64 value;
+    memcpy(&value, ip, sizeof(f64));
+    return value;
+}
+
+inline static u16 read_u16(const u8* ip)
+{
+    u16 value;
+    memcpy(&value, ip, sizeof(u16));
+    return value;
+}
+
+inline static u32 read_u32(const u8* ip)
+{
+    u32 value;
+    memcpy(&value, ip, sizeof(u32));
+    return value;
+}
+
+// Returns the fused opcode for applying the operator to an inline operand (END if it can't be fused)
+static Opcode fused_opcode(OperatorCode code, bool is_constant)
+{
+    switch (code)
+    {
+        case OperatorCode::ADD:      return is_constant ? Opcode::ADD_CONST      : Opcode::ADD_VAR;
+        case OperatorCode::SUBTRACT: return is_constant ? Opcode::SUBTRACT_CONST : Opcode::SUBTRACT_VAR;
+        case OperatorCode::MULTIPLY: return is_constant ? Opcode::MULTIPLY_CONST : Opcode::MULTIPLY_VAR;
+        case OperatorCode::DIVIDE:   return is_constant ? Opcode::DIVIDE_CONST   : Opcode::DIVIDE_VAR;
+    }
+
+    return Opcode::END;
+}
+
+constexpr u32 NO_JUMP = ~0u;
+
+static bool is_short_circuit(OperatorCode code)
+{
+    return code == OperatorCode::AND || code == OperatorCode::OR || code == OperatorCode::COND;
+}
+
+// Jumps are emitted where an operand of if, and or or starts (other than the first one). Sets jump_owner[i] to
+// the index of the operator if its second or third operand starts at element i, NO_JUMP everywhere else.
+static void find_jumps(const DynamicArray<ExpressionElement>& expression, DynamicArray<u32>& jump_owner)
+{
+    // Where the operand ending at each element starts, and the elements on top of the stack while solving
+    DynamicArray<u32> starts = make<DynamicArray<u32>>(expression.size);
+    DynamicArray<u32> stack  = make<DynamicArray<u32>>(32Ui64);
+    starts.size = expression.size;
+
+    for (u32 i = 0; i < expression.size; i++)
+    {
+        jump_owner[i] = NO_JUMP;
+        starts[i] = i;
+
+        if (expression[i].type == ExpressionElement::Type::OPERATOR)
+        {
+            const u32 operand_count = get_operator(expression[i].op_code).operand_count;
+            const u32* operands = stack.data + stack.size - operand_count;
+
+            if (operand_count > 0)
+                starts[i] = starts[operands[0]];
+
+            if (is_short_circuit(expression[i].op_code))
+            {
+                for (u32 j = 1; j < operand_count; j++)
+                    jump_owner[starts[operands[j]]] = i;
+            }
+
+            stack.size -= operand_count;
+        }
+
+        append(stack, i);
+    }
+
+    free(stack);
+    free(starts);
+}
+
+bool compile_bytecode(const DynamicArray<ExpressionElement>& expression, Bytecode& bytecode, bool short_circuit)
+{
+    bytecode.stack_size = max_stack_depth(expression);
+    if (bytecode.stack_size == 0)
+        return false;
+
+    if (!bytecode.code.data)
+        bytecode.code = make<DynamicArray<u8>>(max(16Ui64, expression.size * 2));
+
+    clear(bytecode.code);
+
+    // Indexed by element: the operator a jump is emitted for in front of the element (see find_jumps),
+    // and for short circuit operators where their last jump is waiting for its target
+    DynamicArray<u32> jump_owner = make<DynamicArray<u32>>(expression.size);
+    DynamicArray<u32> pending_jump = make<DynamicArray<u32>>(expression.size);
+    jump_owner.size = pending_jump.size = expression.size;
+    memset(pending_jump.data, 0xFF, pending_jump.size * sizeof(u32));
+
+    if (short_circuit)
+        find_jumps(expression, jump_owner);
+    else
+        memset(jump_owner.data, 0xFF, jump_owner.size * sizeof(u32));
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        const ExpressionElement& element = expression[i];
+
+        // Operators never start an operand, so a jump is never emitted between a value and an operator it's fused with
+        const u32 owner = jump_owner[i];
+        if (owner != NO_JUMP)
+        {
+            switch (expression[owner].op_code)
+            {
+                case OperatorCode::AND: pending_jump[owner] = emit_jump(bytecode, Opcode::AND_JUMP); break;
+                case OperatorCode::OR:  pending_jump[owner] = emit_jump(bytecode, Opcode::OR_JUMP); break;
+
+                // The condition is followed by the then branch and the else branch
+                case OperatorCode::COND:
+                {
+                    if (pending_jump[owner] == NO_JUMP)
+                        pending_jump[owner] = emit_jump(bytecode, Opcode::JUMP_IF_FALSE);
+                    else
+                    {
+                        const u32 skip_else = emit_jump(bytecode, Opcode::JUMP);
+                        patch_jump(bytecode, pending_jump[owner]);
+                        pending_jump[owner] = skip_else;
+                    }
+                } break;
+            }
+        }
+
+        if (element.type == ExpressionElement::Type::OPERATOR)
+        {
+            if (short_circuit && is_short_circuit(element.op_code))
+            {
+                if (element.op_code != OperatorCode::COND)
+                    emit_opcode(bytecode, Opcode::BOOL);
+
+                patch_jump(bytecode, pending_jump[i]);
+            }
+            else
+                emit_opcode(bytecode, (Opcode) element.op_code);
+
+            continue;
+        }
+
+        const bool is_constant = (element.type == ExpressionElement::Type::NUMBER);
+
+        // A value that is immediately used as the second operand of a binary operator is fused with it
+        if (i + 1 < expression.size && expression[i + 1].type == ExpressionElement::Type::OPERATOR)
+        {
+            const Opcode fused = fused_opcode(expression[i + 1].op_code, is_constant);
+            if (fused != Opcode::END)
+            {
+                emit_opcode(bytecode, fused);
+
+                if (is_constant)
+                    emit_f64(bytecode, element.value);
+                else
+                    emit_u16(bytecode, (u16) element.variable.index);
+
+                i++;
+                continue;
+            }
+        }
+
+        if (is_constant)
+        {
+            emit_opcode(bytecode, Opcode::PUSH_CONST);
+            emit_f64(bytecode, element.value);
+        }
+        else
+        {
+            emit_opcode(bytecode, Opcode::LOAD_VAR);
+            emit_u16(bytecode, (u16) element.variable.index);
+        }
+    }
+
+    emit_opcode(bytecode, Opcode::END);
+
+    free(pending_jump);
+    free(jump_owner);
+
+    return true;
+}
+
+// Operators are implemented inline here instead of calling the functions in opdef.h.
+// They have to give the exact same results.
+f64 run_bytecode(const Bytecode& bytecode, const f64 variables[], f64 stack[])
+{
+    const u8* ip = bytecode.code.data;
+
+    // Points to the slot after the top of the stack
+    f64* top = stack;
+
+    while (true)
+    {
+        const Opcode opcode = (Opcode) *ip++;
+
+        switch (opcode)
+        {
+            case Opcode::PUSH_CONST: { *top++ = read_f64(ip); ip += sizeof(f64); } break;
+            case Opcode::LOAD_VAR:   { *top++ = variables[read_u16(ip)]; ip += sizeof(u16); } break;
+
+            case Opcode::ADD_CONST:      { top[-1] += read_f64(ip); ip += sizeof(f64); } break;
+            case Opcode::SUBTRACT_CONST: { top[-1] -= read_f64(ip); ip += sizeof(f64); } break;
+            case Opcode::MULTIPLY_CONST: { top[-1] *= read_f64(ip); ip += sizeof(f64); } break;
+            case Opcode::DIVIDE_CONST:   { top[-1] /= read_f64(ip); ip += sizeof(f64); } break;
+
+            case Opcode::ADD_VAR:      { top[-1] += variables[read_u16(ip)]; ip += sizeof(u16); } break;
+            case Opcode::SUBTRACT_VAR: { top[-1] -= variables[read_u16(ip)]; ip += sizeof(u16); } break;
+            case Opcode::MULTIPLY_VAR: { top[-1] *= variables[read_u16(ip)]; ip += sizeof(u16); } break;
+            case Opcode::DIVIDE_VAR:   { top[-1] /= variables[read_u16(ip)]; ip += sizeof(u16); } break;
+
+            case Opcode::JUMP: { ip = bytecode.code.data + read_u32(ip); } break;
+
+            case Opcode::JUMP_IF_FALSE:
+            {
+                top--;
+                ip = top[0] ? ip + sizeof(u32) : bytecode.code.data + read_u32(ip);
+            } break;
+
+            case Opcode::AND_JUMP:
+            {
+                if (!top[-1])
+                {
+                    top[-1] = 0.0;
+                    ip = bytecode.code.data + read_u32(ip);
+                }
+                else
+                {
+                    top--;
+                    ip += sizeof(u32);
+                }
+            } break;
+
+            case Opcode::OR_JUMP:
+            {
+                if (top[-1])
+                {
+                    top[-1] = 1.0;
+                    ip = bytecode.code.data + read_u32(ip);
+                }
+                else
+                {
+                    top--;
+                    ip += sizeof(u32);
+                }
+            } break;
+
+            case Opcode::BOOL: { top[-1] = (top[-1] != 0); } break;
+
+            // Unary operators
+            case (Opcode) OperatorCode::NEG:         { top[-1] = -1 * top[-1]; } break;
+            case (Opcode) OperatorCode::NOT:         { top[-1] = !top[-1]; } break;
+            case (Opcode) OperatorCode::NATURAL_LOG: { top[-1] = log(top[-1]); } break;
+            case (Opcode) OperatorCode::SIN:         { top[-1] = sin(top[-1]); } break;
+            case (Opcode) OperatorCode::COS:         { top[-1] = cos(top[-1]); } break;
+            case (Opcode) OperatorCode::TAN:         { top[-1] = tan(top[-1]); } break;
+            case (Opcode) OperatorCode::SEC:         { top[-1] = 1 / cos(top[-1]); } break;
+            case (Opcode) OperatorCode::COSEC:       { top[-1] = 1 / sin(top[-1]); } break;
+            case (Opcode) OperatorCode::COT:         { top[-1] = 1 / tan(top[-1]); } break;
+            case (Opcode) OperatorCode::SINH:        { top[-1] = sinh(top[-1]); } break;
+            case (Opcode) OperatorCode::COSH:        { top[-1] = cosh(top[-1]); } break;
+            case (Opcode) OperatorCode::TANH:        { top[-1] = tanh(top[-1]); } break;
+            case (Opcode) OperatorCode::SQRT:        { top[-1] = sqrt(top[-1]); } break;
+            case (Opcode) OperatorCode::EXP:         { top[-1] = exp(top[-1]); } break;
+
+            // Binary operators
+            case (Opcode) OperatorCode::MULTIPLY:      { top--; top[-1] = top[-1] * top[0]; } break;
+            case (Opcode) OperatorCode::DIVIDE:        { top--; top[-1] = top[-1] / top[0]; } break;
+            case (Opcode) OperatorCode::REMAINDER:     { top--; top[-1] = fmod(top[-1], top[0]); } break;
+            case (Opcode) OperatorCode::ADD:           { top--; top[-1] = top[-1] + top[0]; } break;
+            case (Opcode) OperatorCode::SUBTRACT:      { top--; top[-1] = top[-1] - top[0]; } break;
+            case (Opcode) OperatorCode::POW:           { top--; top[-1] = pow(top[-1], top[0]); } break;
+            case (Opcode) OperatorCode::AND:           { top--; top[-1] = top[-1] && top[0]; } break;
+            case (Opcode) OperatorCode::OR:            { top--; top[-1] = top[-1] || top[0]; } break;
+            case (Opcode) OperatorCode::GREATER:       { top--; top[-1] = top[-1] > top[0]; } break;
+            case (Opcode) OperatorCode::LESSER:        { top--; top[-1] = top[-1] < top[0]; } break;
+            case (Opcode) OperatorCode::GREATER_EQUAL: { top--; top[-1] = top[-1] >= top[0]; } break;
+            case (Opcode) OperatorCode::LESSER_EQUAL:  { top--; top[-1] = top[-1] <= top[0]; } break;
+            case (Opcode) OperatorCode::EQUAL:         { top--; top[-1] = top[-1] == top[0]; } break;
+            case (Opcode) OperatorCode::NOT_EQUAL:     { top--; top[-1] = top[-1] != top[0]; } break;
+            case (Opcode) OperatorCode::LOG:           { top--; top[-1] = log(top[0]) / log(top[-1]); } break;
+            case (Opcode) OperatorCode::MAX:           { top--; top[-1] = (top[-1] > top[0]) ? top[-1] : top[0]; } break;
+            case (Opcode) OperatorCode::MIN:           { top--; top[-1] = (top[-1] < top[0]) ? top[-1] : top[0]; } break;
+
+            // Ternary operators
+            case (Opcode) OperatorCode::COND: { top -= 2; top[-1] = top[-1] ? top[0] : top[1]; } break;
+
+            case Opcode::END:
+                return top[-1];
+        }
+    }
+}
+
+void free(Bytecode& bytecode)
+{
+    free(bytecode.code);
+    bytecode.stack_size = 0;
+}
+
+} // namespace Calculator
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "containers/darray.h"
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Opcodes are a single byte. The first ones match OperatorCode (one for each operator in opdef.h),
+// the rest push values, are fused instructions that apply an operator to the top of the stack
+// and an inline operand, or jump over the operands of if, and and or that aren't needed.
+enum struct Opcode : u8
+{
+    // Operators (same values as OperatorCode)
+
+    PUSH_CONST = (u8) OperatorCode::COUNT,  // f64 constant follows
+    LOAD_VAR,                               // u16 variable index follows
+
+    // Fused instructions (top = top op operand)
+    ADD_CONST,                              // f64 constant follows
+    SUBTRACT_CONST,
+    MULTIPLY_CONST,
+    DIVIDE_CONST,
+
+    ADD_VAR,                                // u16 variable index follows
+    SUBTRACT_VAR,
+    MULTIPLY_VAR,
+    DIVIDE_VAR,
+
+    // Jumps (u32 offset of the target in the code follows)
+    JUMP,
+    JUMP_IF_FALSE,                          // Pops the condition of an if, jumps to the else branch if it's 0
+    AND_JUMP,                               // Jumps with 0 on the stack if the top is 0, pops it otherwise
+    OR_JUMP,                                // Jumps with 1 on the stack if the top isn't 0, pops it otherwise
+    BOOL,                                   // top = (top != 0), the second operand of and/or is turned into 0 or 1
+
+    END
+};
+
+struct Bytecode
+{
+    DynamicArray<u8> code;
+    u32 stack_size;     // Number of values needed on the stack to run the code
+};
+
+// Returns false if the expression is malformed. Only the branch of an if that is taken is evaluated, and the
+// second operand of and/or only if the first one doesn't decide the result, unless short_circuit is false
+// (everything is evaluated in postfix order then, like the postfix solver does).
+bool compile_bytecode(const DynamicArray<ExpressionElement>& expression, Bytecode& bytecode, bool short_circuit = true);
+
+// The stack needs space for at least bytecode.stack_size values
+f64 run_bytecode(const Bytecode& bytecode, const f64 variables[], f64 stack[]);
+
+void free(Bytecode& bytecode);
+
+} // namespace Calculator
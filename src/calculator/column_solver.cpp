@@ -0,0 +1,344 @@
+#include "column_solver.h"
+
+#include <cmath>
+#include "containers/darray.h"
+#include "core/compiler_utils.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "lanes.h"
+#include "math/common.h"
+#include "platform/platform.h"
+#include "solver.h"
+#include "token.h"
+#include "vector_math.h"
+
+namespace Calculator
+{
+
+// Kernels have a lane version and a scalar version (for the rows that don't fill up a lane).
+// The scalar versions match the functions in opdef.h.
+
+struct NegKernel          { static Lane apply(Lane a) { return lane_mul(lane_set(-1.0), a); }
+                            static f64  apply(f64 a)  { return -1 * a; } };
+struct NotKernel          { static Lane apply(Lane a) { return lane_mask_to_bool(lane_equal(a, lane_set(0.0))); }
+                            static f64  apply(f64 a)  { return !a; } };
+struct SqrtKernel         { static Lane apply(Lane a) { return lane_sqrt(a); }
+                            static f64  apply(f64 a)  { return sqrt(a); } };
+
+struct AddKernel          { static Lane apply(Lane a, Lane b) { return lane_add(a, b); }
+                            static f64  apply(f64 a, f64 b)   { return a + b; } };
+struct SubtractKernel     { static Lane apply(Lane a, Lane b) { return lane_sub(a, b); }
+                            static f64  apply(f64 a, f64 b)   { return a - b; } };
+struct MultiplyKernel     { static Lane apply(Lane a, Lane b) { return lane_mul(a, b); }
+                            static f64  apply(f64 a, f64 b)   { return a * b; } };
+struct DivideKernel       { static Lane apply(Lane a, Lane b) { return lane_div(a, b); }
+                            static f64  apply(f64 a, f64 b)   { return a / b; } };
+struct MaxKernel          { static Lane apply(Lane a, Lane b) { return lane_max(a, b); }
+                            static f64  apply(f64 a, f64 b)   { return (a > b) ? a : b; } };
+struct MinKernel          { static Lane apply(Lane a, Lane b) { return lane_min(a, b); }
+                            static f64  apply(f64 a, f64 b)   { return (a < b) ? a : b; } };
+struct AndKernel          { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_and(lane_not_equal(a, lane_set(0.0)), lane_not_equal(b, lane_set(0.0)))); }
+                            static f64  apply(f64 a, f64 b)   { return a && b; } };
+struct OrKernel           { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_select(lane_not_equal(a, lane_set(0.0)), lane_set(1.0), lane_not_equal(b, lane_set(0.0)))); }
+                            static f64  apply(f64 a, f64 b)   { return a || b; } };
+struct GreaterKernel      { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_greater(a, b)); }
+                            static f64  apply(f64 a, f64 b)   { return a > b; } };
+struct LesserKernel       { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_lesser(a, b)); }
+                            static f64  apply(f64 a, f64 b)   { return a < b; } };
+struct GreaterEqualKernel { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_greater_equal(a, b)); }
+                            static f64  apply(f64 a, f64 b)   { return a >= b; } };
+struct LesserEqualKernel  { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_lesser_equal(a, b)); }
+                            static f64  apply(f64 a, f64 b)   { return a <= b; } };
+struct EqualKernel        { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_equal(a, b)); }
+                            static f64  apply(f64 a, f64 b)   { return a == b; } };
+struct NotEqualKernel     { static Lane apply(Lane a, Lane b) { return lane_mask_to_bool(lane_not_equal(a, b)); }
+                            static f64  apply(f64 a, f64 b)   { return a != b; } };
+
+struct CondKernel         { static Lane apply(Lane c, Lane a, Lane b) { return lane_select(lane_not_equal(c, lane_set(0.0)), a, b); }
+                            static f64  apply(f64 c, f64 a, f64 b)    { return c ? a : b; } };
+
+template <u32 operand_count, typename Kernel>
+static void run_kernel(f64* out, const f64* const in[], u64 count)
+{
+    u64 i = 0;
+
+    if constexpr (operand_count == 1)
+    {
+        for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+            lane_store(out + i, Kernel::apply(lane_load(in[0] + i)));
+
+        for (; i < count; i++)
+            out[i] = Kernel::apply(in[0][i]);
+    }
+    else if constexpr (operand_count == 2)
+    {
+        for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+            lane_store(out + i, Kernel::apply(lane_load(in[0] + i), lane_load(in[1] + i)));
+
+        for (; i < count; i++)
+            out[i] = Kernel::apply(in[0][i], in[1][i]);
+    }
+    else
+    {
+        for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+            lane_store(out + i, Kernel::apply(lane_load(in[0] + i), lane_load(in[1] + i), lane_load(in[2] + i)));
+
+        for (; i < count; i++)
+            out[i] = Kernel::apply(in[0][i], in[1][i], in[2][i]);
+    }
+}
+
+// Used for operators that don't have a kernel (mostly transcendental functions)
+static void run_scalar_fallback(const Operator& op, f64* out, const f64* const in[], u64 count)
+{
+    f64 operands[3];    // Max operand count in functions is 3
+
+    for (u64 i = 0; i < count; i++)
+    {
+        for (u32 j = 0; j < op.operand_count; j++)
+            operands[j] = in[j][i];
+
+        out[i] = op.operation(operands);
+    }
+}
+
+static void reciprocal(f64* values, u64 count)
+{
+    u64 i = 0;
+    for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+        lane_store(values + i, lane_div(lane_set(1.0), lane_load(values + i)));
+
+    for (; i < count; i++)
+        values[i] = 1 / values[i];
+}
+
+// Transcendental functions from vector_math.h, returns false if the operator doesn't have one
+static bool run_vector_math(const Operator& op, f64* out, const f64* const in[], u64 count)
+{
+    switch (op.code)
+    {
+        case OperatorCode::EXP:         vector_exp(in[0], out, count);          break;
+        case OperatorCode::NATURAL_LOG: vector_log(in[0], out, count);          break;
+        case OperatorCode::POW:         vector_pow(in[0], in[1], out, count);   break;
+        case OperatorCode::SIN:         vector_sin(in[0], out, count);          break;
+        case OperatorCode::COS:         vector_cos(in[0], out, count);          break;
+        case OperatorCode::TAN:         vector_tan(in[0], out, count);          break;
+        case OperatorCode::SINH:        vector_sinh(in[0], out, count);         break;
+        case OperatorCode::COSH:        vector_cosh(in[0], out, count);         break;
+        case OperatorCode::TANH:        vector_tanh(in[0], out, count);         break;
+
+        case OperatorCode::SEC:   vector_cos(in[0], out, count); reciprocal(out, count); break;
+        case OperatorCode::COSEC: vector_sin(in[0], out, count); reciprocal(out, count); break;
+        case OperatorCode::COT:   vector_tan(in[0], out, count); reciprocal(out, count); break;
+
+        case OperatorCode::LOG:
+        {
+            // The base is the first operand, which shares its column with the output
+            f64 base_logs[COLUMN_BLOCK_SIZE];
+            vector_log(in[0], base_logs, count);
+            vector_log(in[1], out, count);
+
+            for (u64 i = 0; i < count; i++)
+                out[i] /= base_logs[i];
+        } break;
+
+        default: return false;
+    }
+
+    return true;
+}
+
+// Output column can be the same as the first input column
+static void run_operator(const Operator& op, f64* out, const f64* const in[], u64 count, bool vector_math)
+{
+    if (vector_math && run_vector_math(op, out, in, count))
+        return;
+
+    switch (op.code)
+    {
+        case OperatorCode::NEG:           run_kernel<1, NegKernel>(out, in, count);          break;
+        case OperatorCode::NOT:           run_kernel<1, NotKernel>(out, in, count);          break;
+        case OperatorCode::SQRT:          run_kernel<1, SqrtKernel>(out, in, count);         break;
+        case OperatorCode::ADD:           run_kernel<2, AddKernel>(out, in, count);          break;
+        case OperatorCode::SUBTRACT:      run_kernel<2, SubtractKernel>(out, in, count);     break;
+        case OperatorCode::MULTIPLY:      run_kernel<2, MultiplyKernel>(out, in, count);     break;
+        case OperatorCode::DIVIDE:        run_kernel<2, DivideKernel>(out, in, count);       break;
+        case OperatorCode::MAX:           run_kernel<2, MaxKernel>(out, in, count);          break;
+        case OperatorCode::MIN:           run_kernel<2, MinKernel>(out, in, count);          break;
+        case OperatorCode::AND:           run_kernel<2, AndKernel>(out, in, count);          break;
+        case OperatorCode::OR:            run_kernel<2, OrKernel>(out, in, count);           break;
+        case OperatorCode::GREATER:       run_kernel<2, GreaterKernel>(out, in, count);      break;
+        case OperatorCode::LESSER:        run_kernel<2, LesserKernel>(out, in, count);       break;
+        case OperatorCode::GREATER_EQUAL: run_kernel<2, GreaterEqualKernel>(out, in, count); break;
+        case OperatorCode::LESSER_EQUAL:  run_kernel<2, LesserEqualKernel>(out, in, count);  break;
+        case OperatorCode::EQUAL:         run_kernel<2, EqualKernel>(out, in, count);        break;
+        case OperatorCode::NOT_EQUAL:     run_kernel<2, NotEqualKernel>(out, in, count);     break;
+        case OperatorCode::COND:          run_kernel<3, CondKernel>(out, in, count);         break;
+
+        default: run_scalar_fallback(op, out, in, count); break;
+    }
+}
+
+bool solve_postfix_columns(const DynamicArray<ExpressionElement>& expression, const f64* const variable_columns[], u64 row_count, f64 results[], ColumnScratch& scratch)
+{
+    const u32 stack_depth = max_stack_depth(expression);
+    if (stack_depth == 0)
+    {
+        print_error("Expression is malformed! Operators don't have the right number of operands.\n");
+        return false;
+    }
+
+    if (scratch.columns.capacity < stack_depth * COLUMN_BLOCK_SIZE)
+        resize(scratch.columns, stack_depth * COLUMN_BLOCK_SIZE);
+
+    if (scratch.slots.capacity < stack_depth)
+        resize(scratch.slots, (u64) stack_depth);
+
+    // Accessing the raw pointers since the arrays are used as fixed size storage here
+    f64* const         columns = scratch.columns.data;
+    const f64** const  slots   = scratch.slots.data;
+
+    for (u64 block_start = 0; block_start < row_count; block_start += COLUMN_BLOCK_SIZE)
+    {
+        const u64 count = min(COLUMN_BLOCK_SIZE, row_count - block_start);
+        u32 top = 0;
+
+        for (u64 i = 0; i < expression.size; i++)
+        {
+            const ExpressionElement& element = expression[i];
+
+            switch (element.type)
+            {
+                case ExpressionElement::Type::NUMBER:
+                {
+                    f64* column = columns + top * COLUMN_BLOCK_SIZE;
+                    for (u64 j = 0; j < count; j++)
+                        column[j] = element.value;
+
+                    slots[top++] = column;
+                } break;
+
+                case ExpressionElement::Type::VARIABLE:
+                {
+                    // Variable columns are read in place
+                    slots[top++] = variable_columns[element.variable.index] + block_start;
+                } break;
+
+                case ExpressionElement::Type::OPERATOR:
+                {
+                    const Operator& op = get_operator(element.op_code);
+                    top -= op.operand_count;
+
+                    // Result takes the place of the first operand
+                    f64* column = columns + top * COLUMN_BLOCK_SIZE;
+                    run_operator(op, column, slots + top, count, scratch.vector_math);
+
+                    slots[top++] = column;
+                } break;
+            }
+        }
+
+        platform_copy_memory(results + block_start, slots[0], count * sizeof(f64));
+    }
+
+    return true;
+}
+
+void free(ColumnScratch& scratch)
+{
+    free(scratch.columns);
+    free(scratch.slots);
+}
+
+// One step of Kahan summation. Once the sum is inf or NaN the compensation would be too (inf - inf),
+// so it is dropped and the sum goes on like a plain one.
+GN_FORCE_INLINE static void kahan_add(Lane& sum, Lane& compensation, Lane value)
+{
+    const Lane corrected = lane_sub(value, compensation);
+    const Lane total = lane_add(sum, corrected);
+    const Lane is_finite = lane_equal(lane_sub(total, total), lane_set(0.0));
+    compensation = lane_and(lane_sub(lane_sub(total, sum), corrected), is_finite);
+    sum = total;
+}
+
+GN_FORCE_INLINE static void kahan_add(f64& sum, f64& compensation, f64 value)
+{
+    const f64 corrected = value - compensation;
+    const f64 total = sum + corrected;
+    compensation = std::isfinite(total) ? (total - sum) - corrected : 0.0;
+    sum = total;
+}
+
+void add_column(ColumnSum& sum, const f64 values[], u64 count)
+{
+    Lane sum0 = lane_load(sum.sums),          sum1 = lane_load(sum.sums + LANE_WIDTH);
+    Lane comp0 = lane_load(sum.compensations), comp1 = lane_load(sum.compensations + LANE_WIDTH);
+
+    u64 i = 0;
+    for (; i + 2 * LANE_WIDTH <= count; i += 2 * LANE_WIDTH)
+    {
+        kahan_add(sum0, comp0, lane_load(values + i));
+        kahan_add(sum1, comp1, lane_load(values + i + LANE_WIDTH));
+    }
+
+    lane_store(sum.sums, sum0);
+    lane_store(sum.sums + LANE_WIDTH, sum1);
+    lane_store(sum.compensations, comp0);
+    lane_store(sum.compensations + LANE_WIDTH, comp1);
+
+    // Rows that don't fill up the lanes go to the first sum
+    for (; i < count; i++)
+        kahan_add(sum.sums[0], sum.compensations[0], values[i]);
+}
+
+f64 column_sum_total(const ColumnSum& sum)
+{
+    f64 total = 0.0;
+    f64 compensation = 0.0;
+
+    for (u64 i = 0; i < 2 * LANE_WIDTH; i++)
+    {
+        kahan_add(total, compensation, sum.sums[i]);
+        kahan_add(total, compensation, -sum.compensations[i]);
+    }
+
+    return total;
+}
+
+// Every value depends on the one before it, so this is scalar
+void prefix_sum_column(const f64 values[], f64 out[], u64 count, f64& sum, f64& compensation)
+{
+    f64 running = sum;
+    f64 running_compensation = compensation;
+
+    for (u64 i = 0; i < count; i++)
+    {
+        kahan_add(running, running_compensation, values[i]);
+        out[i] = running;
+    }
+
+    sum = running;
+    compensation = running_compensation;
+}
+
+f64 sum_column(const f64 values[], u64 count)
+{
+    ColumnSum sum = {};
+    add_column(sum, values, count);
+
+    return column_sum_total(sum);
+}
+
+f64 mean_column(const f64 values[], u64 count)
+{
+    return sum_column(values, count) / count;
+}
+
+void prefix_sum_column(const f64 values[], f64 out[], u64 count)
+{
+    f64 sum = 0.0;
+    f64 compensation = 0.0;
+    prefix_sum_column(values, out, count, sum, compensation);
+}
+
+} // namespace Calculator
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "containers/darray.h"
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Rows are solved in blocks of this size, every value on the number stack being a column of the block
+constexpr u64 COLUMN_BLOCK_SIZE = 256;
+
+// Scratch space for the column solver, can be reused across calls
+struct ColumnScratch
+{
+    DynamicArray<f64>        columns;   // Storage for intermediate values (one block for each stack slot)
+    DynamicArray<const f64*> slots;     // Column that each stack slot points to
+
+    // Transcendental functions use vector_math.h instead of calling libm for every row. Faster, but
+    // results can differ from the other evaluators in the last bits.
+    bool vector_math;
+};
+
+// Solves the expression for row_count rows at once. variable_columns should have a column of row_count
+// values for every variable in the expression. Returns false if the expression is malformed.
+bool solve_postfix_columns(const DynamicArray<ExpressionElement>& expression, const f64* const variable_columns[], u64 row_count, f64 results[], ColumnScratch& scratch);
+
+void free(ColumnScratch& scratch);
+
+// Compensated (Kahan) sum of columns of values. Each SIMD lane keeps its own sum (two lanes at a time
+// so the adds don't wait on each other), they are only added together by column_sum_total.
+struct ColumnSum
+{
+    f64 sums[8];            // Enough for two AVX lanes
+    f64 compensations[8];   // Low order bits lost by each sum (negated)
+};
+
+void add_column(ColumnSum& sum, const f64 values[], u64 count);
+f64  column_sum_total(const ColumnSum& sum);
+
+// Writes the running sum of the values to out (which can be the same as values). The sum and its
+// compensation carry over from the previous call so a column can be summed a block at a time.
+void prefix_sum_column(const f64 values[], f64 out[], u64 count, f64& sum, f64& compensation);
+
+// Same as above for a whole column in memory
+f64  sum_column(const f64 values[], u64 count);
+f64  mean_column(const f64 values[], u64 count);   // NaN if the column is empty
+void prefix_sum_column(const f64 values[], f64 out[], u64 count);
+
+} // namespace Calculator
@@ -0,0 +1,72 @@
+#include "compiled.h"
+
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/types.h"
+#include "bytecode.h"
+#include "jit.h"
+#include "optimizer.h"
+#include "solver.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+bool compile_expression(const String expression, const String variable_names[], u32 variable_count, CompiledExpression& compiled, bool optimize)
+{
+    if (!compiled.elements.data)
+        compiled.elements = make<DynamicArray<ExpressionElement>>(max(16Ui64, expression.size / 4));
+
+    if (!compiled.number_stack.data)
+        compiled.number_stack = make<DynamicArray<f64>>(16Ui64);
+
+    compiled.variable_count = variable_count;
+    compiled.elements_removed = 0;
+
+    // Machine code for a previous expression is no longer valid
+    free(compiled.jit);
+
+    DynamicArray<OperatorOrBracket> op_stack = make<DynamicArray<OperatorOrBracket>>(32Ui64);
+    const bool success = infix_expression_to_postfix(expression, compiled.elements, op_stack, variable_names, variable_count);
+    free(op_stack);
+
+    if (!success)
+        return false;
+
+    if (optimize)
+        compiled.elements_removed = optimize_postfix(compiled.elements);
+
+    if (!compile_bytecode(compiled.elements, compiled.bytecode))
+        return false;
+
+    if (compiled.number_stack.capacity < compiled.bytecode.stack_size)
+        resize(compiled.number_stack, (u64) compiled.bytecode.stack_size);
+
+    return true;
+}
+
+bool compile_jit(CompiledExpression& compiled)
+{
+    free(compiled.jit);
+    return compile_jit(compiled.elements, compiled.jit);
+}
+
+f64 evaluate(CompiledExpression& compiled, const f64 variables[])
+{
+    if (compiled.jit.function)
+        return compiled.jit.function(variables, compiled.number_stack.data);
+
+    return run_bytecode(compiled.bytecode, variables, compiled.number_stack.data);
+}
+
+void free(CompiledExpression& compiled)
+{
+    free(compiled.elements);
+    free(compiled.number_stack);
+    free(compiled.bytecode);
+    free(compiled.jit);
+    compiled.variable_count = 0;
+    compiled.elements_removed = 0;
+}
+
+} // namespace Calculator
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/types.h"
+#include "bytecode.h"
+#include "jit.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// An expression that is tokenized once and can be evaluated many times with different variable values
+struct CompiledExpression
+{
+    DynamicArray<ExpressionElement> elements;
+    DynamicArray<f64> number_stack;
+    Bytecode bytecode;
+    JitExpression jit;      // Only used if compiled with compile_jit
+    u32 variable_count;
+    u64 elements_removed;   // By the optimizer
+};
+
+// Variables in the expression are bound to the index of their name in variable_names.
+// Constant subexpressions are folded (see optimize_postfix) when optimize is true.
+bool compile_expression(const String expression, const String variable_names[], u32 variable_count, CompiledExpression& compiled, bool optimize = true);
+
+// Translates the compiled expression to machine code so evaluate doesn't need to interpret it.
+// Returns false if that's not possible, evaluate keeps using the bytecode then.
+bool compile_jit(CompiledExpression& compiled);
+
+// Runs the machine code (or the bytecode if there is none) for the expression. The variables
+// array should have a value for each variable the expression was compiled with.
+f64 evaluate(CompiledExpression& compiled, const f64 variables[]);
+
+void free(CompiledExpression& compiled);
+
+} // namespace Calculator
@@ -0,0 +1,390 @@
+#include "cse.h"
+
+#include <cstring>
+#include "containers/darray.h"
+#include "core/types.h"
+#include "math/common.h"
+#include "column_solver.h"
+#include "solver.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+constexpr u32 NO_NODE = 0xFFFFFFFF;
+
+struct DagNode
+{
+    ExpressionElement element;
+    u32 operands[3];    // Max operand count in functions is 3
+    u32 hash;
+    u32 use_count;      // Number of operators using the node (plus one for the result)
+    u32 temporary;      // NO_NODE if the node is solved where it's used
+};
+
+// Hash-consing table, each bucket holds the index of a node (or NO_NODE)
+struct NodeTable
+{
+    DynamicArray<DagNode> nodes;
+    DynamicArray<u32>     buckets;  // Size is a power of 2
+};
+
+inline static u32 mix(u64 key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDUi64;
+    key ^= key >> 33;
+    return (u32) key;
+}
+
+static u32 hash_node(const DagNode& node)
+{
+    const ExpressionElement& element = node.element;
+
+    switch (element.type)
+    {
+        case ExpressionElement::Type::NUMBER:
+        {
+            u64 bits;
+            memcpy(&bits, &element.value, sizeof(u64));
+            return mix(bits);
+        }
+
+        case ExpressionElement::Type::VARIABLE:
+            return mix(0x100000000Ui64 | element.variable.index);
+    }
+
+    u32 hash = mix(0x200000000Ui64 | (u32) element.op_code);
+    for (u32 i = 0; i < get_operator(element.op_code).operand_count; i++)
+        hash = mix(((u64) hash << 32) | node.operands[i]);
+
+    return hash;
+}
+
+static bool same_node(const DagNode& a, const DagNode& b)
+{
+    if (a.hash != b.hash || a.element.type != b.element.type)
+        return false;
+
+    switch (a.element.type)
+    {
+        // Numbers are compared bit for bit so 0 and -0 stay different
+        case ExpressionElement::Type::NUMBER:
+            return memcmp(&a.element.value, &b.element.value, sizeof(f64)) == 0;
+
+        case ExpressionElement::Type::VARIABLE:
+            return a.element.variable.index == b.element.variable.index;
+    }
+
+    if (a.element.op_code != b.element.op_code)
+        return false;
+
+    for (u32 i = 0; i < get_operator(a.element.op_code).operand_count; i++)
+    {
+        if (a.operands[i] != b.operands[i])
+            return false;
+    }
+
+    return true;
+}
+
+// Swapping the operands of these gives the exact same result
+static bool is_commutative(OperatorCode code)
+{
+    switch (code)
+    {
+        case OperatorCode::ADD:
+        case OperatorCode::MULTIPLY:
+        case OperatorCode::AND:
+        case OperatorCode::OR:
+        case OperatorCode::EQUAL:
+        case OperatorCode::NOT_EQUAL:
+            return true;
+    }
+
+    return false;
+}
+
+static void grow_buckets(NodeTable& table)
+{
+    const u64 capacity = table.buckets.size * 2;
+
+    free(table.buckets);
+    table.buckets = make<DynamicArray<u32>>(capacity);
+    table.buckets.size = capacity;
+    memset(table.buckets.data, 0xFF, capacity * sizeof(u32));
+
+    for (u32 i = 0; i < table.nodes.size; i++)
+    {
+        u64 bucket = table.nodes[i].hash & (capacity - 1);
+        while (table.buckets[bucket] != NO_NODE)
+            bucket = (bucket + 1) & (capacity - 1);
+
+        table.buckets[bucket] = i;
+    }
+}
+
+// Returns the index of the node identical to the given one, adding it if there is none
+static u32 intern_node(NodeTable& table, DagNode& node)
+{
+    node.hash = hash_node(node);
+
+    // Keep the load factor under 1/2
+    if ((table.nodes.size + 1) * 2 > table.buckets.size)
+        grow_buckets(table);
+
+    const u64 mask = table.buckets.size - 1;
+    u64 bucket = node.hash & mask;
+
+    while (table.buckets[bucket] != NO_NODE)
+    {
+        const u32 index = table.buckets[bucket];
+        if (same_node(table.nodes[index], node))
+            return index;
+
+        bucket = (bucket + 1) & mask;
+    }
+
+    const u32 index = (u32) table.nodes.size;
+    table.buckets[bucket] = index;
+    append(table.nodes, node);
+
+    return index;
+}
+
+// Node being emitted and the next of its operands to emit
+struct EmitFrame
+{
+    u32 node;
+    u32 next_operand;
+};
+
+// Appends the postfix elements for the node. Operands that are temporaries are read instead of being solved again.
+// Walks the DAG with an explicit stack since long chains ("x+x+x+...") are as deep as the expression is long.
+static void emit_node(const DynamicArray<DagNode>& nodes, u32 index, u32 variable_count, DynamicArray<ExpressionElement>& elements,
+                      DynamicArray<EmitFrame>& frames)
+{
+    clear(frames);
+    append(frames, EmitFrame { index, 0 });
+
+    while (frames.size > 0)
+    {
+        const u64 top = frames.size - 1;
+        const DagNode& node = nodes[frames[top].node];
+
+        const u32 operand_count = (node.element.type == ExpressionElement::Type::OPERATOR) ? get_operator(node.element.op_code).operand_count : 0;
+        if (frames[top].next_operand == operand_count)
+        {
+            append(elements, node.element);
+            frames.size--;
+            continue;
+        }
+
+        const u32 operand_index = node.operands[frames[top].next_operand++];
+        const DagNode& operand = nodes[operand_index];
+
+        if (operand.temporary != NO_NODE)
+            append(elements, ExpressionElement(Variable { variable_count + operand.temporary }));
+        else
+            append(frames, EmitFrame { operand_index, 0 });
+    }
+}
+
+bool eliminate_common_subexpressions(const DynamicArray<ExpressionElement>& expression, u32 variable_count, CseProgram& program)
+{
+    if (max_stack_depth(expression) == 0)
+        return false;
+
+    if (!program.elements.data)
+        program.elements = make<DynamicArray<ExpressionElement>>(max(16Ui64, expression.size));
+
+    if (!program.part_ends.data)
+        program.part_ends = make<DynamicArray<u64>>(8Ui64);
+
+    clear(program.elements);
+    clear(program.part_ends);
+
+    program.variable_count = variable_count;
+    program.temporary_count = 0;
+
+    NodeTable table;
+    table.nodes = make<DynamicArray<DagNode>>(max(16Ui64, expression.size));
+    table.buckets = make<DynamicArray<u32>>(32Ui64);
+    table.buckets.size = table.buckets.capacity;
+    memset(table.buckets.data, 0xFF, table.buckets.size * sizeof(u32));
+
+    DynamicArray<u32> stack = make<DynamicArray<u32>>(32Ui64);
+
+    u64 operators_before = 0;
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        const ExpressionElement& element = expression[i];
+
+        DagNode node = { element, { NO_NODE, NO_NODE, NO_NODE }, 0, 0, NO_NODE };
+
+        if (element.type == ExpressionElement::Type::OPERATOR)
+        {
+            const u32 operand_count = get_operator(element.op_code).operand_count;
+            operators_before++;
+
+            for (u32 j = 0; j < operand_count; j++)
+                node.operands[j] = stack[stack.size - operand_count + j];
+
+            stack.size -= operand_count;
+
+            if (is_commutative(element.op_code) && node.operands[0] > node.operands[1])
+            {
+                const u32 temp = node.operands[0];
+                node.operands[0] = node.operands[1];
+                node.operands[1] = temp;
+            }
+        }
+
+        append(stack, intern_node(table, node));
+    }
+
+    DynamicArray<DagNode>& nodes = table.nodes;
+    const u32 root = stack[0];
+
+    // Nodes are always added after their operands, so going backwards reaches
+    // every user of a node before the node itself
+    nodes[root].use_count = 1;
+    for (u64 i = nodes.size; i-- > 0;)
+    {
+        const DagNode& node = nodes[i];
+        if (node.use_count == 0 || node.element.type != ExpressionElement::Type::OPERATOR)
+            continue;
+
+        for (u32 j = 0; j < get_operator(node.element.op_code).operand_count; j++)
+            nodes[node.operands[j]].use_count++;
+    }
+
+    DynamicArray<EmitFrame> frames = make<DynamicArray<EmitFrame>>(32Ui64);
+
+    // Shared operators become temporaries, numbers and variables are cheap enough to be loaded again
+    for (u64 i = 0; i < nodes.size; i++)
+    {
+        DagNode& node = nodes[i];
+        if (node.use_count > 1 && node.element.type == ExpressionElement::Type::OPERATOR)
+        {
+            emit_node(nodes, (u32) i, variable_count, program.elements, frames);
+            append(program.part_ends, program.elements.size);
+
+            node.temporary = program.temporary_count++;
+        }
+    }
+
+    emit_node(nodes, root, variable_count, program.elements, frames);
+    append(program.part_ends, program.elements.size);
+
+    u64 operators_after = 0;
+    for (u64 i = 0; i < program.elements.size; i++)
+        operators_after += (program.elements[i].type == ExpressionElement::Type::OPERATOR);
+
+    program.operators_removed = operators_before - operators_after;
+
+    free(frames);
+    free(stack);
+    free(table.buckets);
+    free(table.nodes);
+
+    return true;
+}
+
+// Elements of a part as an array that can be passed to the solvers (doesn't own the data)
+inline static DynamicArray<ExpressionElement> get_part(const CseProgram& program, u64 part)
+{
+    const u64 start = (part == 0) ? 0 : program.part_ends[part - 1];
+    const u64 size  = program.part_ends[part] - start;
+
+    DynamicArray<ExpressionElement> elements;
+    elements.data = program.elements.data + start;
+    elements.size = elements.capacity = size;
+
+    return elements;
+}
+
+f64 solve_cse_program(const CseProgram& program, const f64 variables[], CseScratch& scratch)
+{
+    const u64 slot_count = program.variable_count + program.temporary_count;
+
+    if (!scratch.slots.data)
+        scratch.slots = make<DynamicArray<f64>>(max(16Ui64, slot_count));
+    else if (scratch.slots.capacity < slot_count)
+        resize(scratch.slots, slot_count);
+
+    if (!scratch.number_stack.data)
+        scratch.number_stack = make<DynamicArray<f64>>(16Ui64);
+
+    f64* const slots = scratch.slots.data;
+    for (u32 i = 0; i < program.variable_count; i++)
+        slots[i] = variables[i];
+
+    for (u32 i = 0; i < program.temporary_count; i++)
+        slots[program.variable_count + i] = solve_postfix_data(get_part(program, i), scratch.number_stack, slots);
+
+    return solve_postfix_data(get_part(program, program.temporary_count), scratch.number_stack, slots);
+}
+
+bool solve_cse_columns(const CseProgram& program, const f64* const variable_columns[], u64 row_count, f64 results[], CseScratch& scratch)
+{
+    const u64 slot_count = program.variable_count + program.temporary_count;
+    const u64 temporary_size = program.temporary_count * COLUMN_BLOCK_SIZE;
+
+    if (!scratch.columns.data)
+        scratch.columns = make<DynamicArray<const f64*>>(max(16Ui64, slot_count));
+    else if (scratch.columns.capacity < slot_count)
+        resize(scratch.columns, slot_count);
+
+    if (!scratch.temporary_columns.data)
+        scratch.temporary_columns = make<DynamicArray<f64>>(max(16Ui64, temporary_size));
+    else if (scratch.temporary_columns.capacity < temporary_size)
+        resize(scratch.temporary_columns, temporary_size);
+
+    const f64** const columns = scratch.columns.data;
+    f64* const temporaries = scratch.temporary_columns.data;
+
+    for (u32 i = 0; i < program.temporary_count; i++)
+        columns[program.variable_count + i] = temporaries + i * COLUMN_BLOCK_SIZE;
+
+    // Temporaries are solved a block at a time so they stay in the cache until they are used
+    for (u64 block_start = 0; block_start < row_count; block_start += COLUMN_BLOCK_SIZE)
+    {
+        const u64 count = min(COLUMN_BLOCK_SIZE, row_count - block_start);
+
+        for (u32 i = 0; i < program.variable_count; i++)
+            columns[i] = variable_columns[i] + block_start;
+
+        for (u32 i = 0; i < program.temporary_count; i++)
+        {
+            if (!solve_postfix_columns(get_part(program, i), columns, count, temporaries + i * COLUMN_BLOCK_SIZE, scratch.column_scratch))
+                return false;
+        }
+
+        if (!solve_postfix_columns(get_part(program, program.temporary_count), columns, count, results + block_start, scratch.column_scratch))
+            return false;
+    }
+
+    return true;
+}
+
+void free(CseProgram& program)
+{
+    free(program.elements);
+    free(program.part_ends);
+    program.variable_count = 0;
+    program.temporary_count = 0;
+    program.operators_removed = 0;
+}
+
+void free(CseScratch& scratch)
+{
+    free(scratch.slots);
+    free(scratch.number_stack);
+    free(scratch.temporary_columns);
+    free(scratch.columns);
+    free(scratch.column_scratch);
+}
+
+} // namespace Calculator
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "containers/darray.h"
+#include "core/types.h"
+#include "column_solver.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// An expression split into parts so every unique subexpression is solved only once.
+// All parts but the last one compute a temporary, the last one computes the result.
+// Temporaries are read like variables: temporary i is variable slot variable_count + i.
+struct CseProgram
+{
+    DynamicArray<ExpressionElement> elements;   // Postfix elements of all the parts, back to back
+    DynamicArray<u64> part_ends;                // Index after the last element of each part
+    u32 variable_count;
+    u32 temporary_count;
+    u64 operators_removed;                      // Operators that no longer have to be solved
+};
+
+// Scratch space for solving programs, can be reused across calls
+struct CseScratch
+{
+    DynamicArray<f64> slots;            // Variables followed by the temporaries
+    DynamicArray<f64> number_stack;
+
+    // Used when solving columns
+    DynamicArray<f64>        temporary_columns;
+    DynamicArray<const f64*> columns;
+    ColumnScratch            column_scratch;
+};
+
+// Builds a DAG of the expression where identical subexpressions share a node (operands of
+// commutative operators are put in a fixed order first) and turns shared nodes into temporaries.
+// Returns false if the expression is malformed.
+bool eliminate_common_subexpressions(const DynamicArray<ExpressionElement>& expression, u32 variable_count, CseProgram& program);
+
+f64 solve_cse_program(const CseProgram& program, const f64 variables[], CseScratch& scratch);
+
+// Same as solve_postfix_columns, temporaries are solved a column at a time too
+bool solve_cse_columns(const CseProgram& program, const f64* const variable_columns[], u64 row_count, f64 results[], CseScratch& scratch);
+
+void free(CseProgram& program);
+void free(CseScratch& scratch);
+
+} // namespace Calculator
@@ -0,0 +1,1102 @@
+#include "decimal.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "core/float_format.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "math/common.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+constexpr u32 DECIMAL_DEFAULT_DIGITS = 50;
+
+static u32 limbs_for_digits(u32 digits)
+{
+    // One guard limb on top of the requested digits
+    return (digits + DECIMAL_LIMB_DIGITS - 1) / DECIMAL_LIMB_DIGITS + 1;
+}
+
+static u32 precision_digits = DECIMAL_DEFAULT_DIGITS;
+static u32 precision_limbs  = limbs_for_digits(DECIMAL_DEFAULT_DIGITS);
+
+void set_decimal_precision(u32 digits)
+{
+    precision_digits = clamp(digits, 1u, DECIMAL_MAX_DIGITS);
+    precision_limbs  = limbs_for_digits(precision_digits);
+}
+
+u32 get_decimal_precision()
+{
+    return precision_digits;
+}
+
+// Intermediate results of functions are computed with more limbs, returns the previous limb count
+static u32 raise_precision(u32 extra_limbs)
+{
+    const u32 previous = precision_limbs;
+    precision_limbs = min(precision_limbs + extra_limbs, DECIMAL_MAX_LIMBS - 1);
+    return previous;
+}
+
+static Decimal make_zero()
+{
+    Decimal result;
+    result.size = 0;
+    result.exponent = 0;
+    result.negative = false;
+    result.kind = Decimal::Kind::FINITE;
+
+    return result;
+}
+
+static Decimal make_special(Decimal::Kind kind, bool negative)
+{
+    Decimal result = make_zero();
+    result.kind = kind;
+    result.negative = negative;
+
+    return result;
+}
+
+// Builds a number from limbs (least significant first) rounded half up to the limbs of the precision,
+// the digits below the last kept limb are all dropped at once (see set_decimal_precision)
+static Decimal from_limbs(const u32 limbs[], u32 size, s32 exponent, bool negative)
+{
+    while (size > 0 && limbs[size - 1] == 0)
+        size--;
+
+    u32 start = 0;
+    while (start < size && limbs[start] == 0)
+        start++;
+
+    if (start == size)
+        return make_zero();
+
+    Decimal result = make_zero();
+    result.negative = negative;
+
+    u32 count = size - start;
+    bool round_up = false;
+
+    if (count > precision_limbs)
+    {
+        const u32 dropped = count - precision_limbs;
+        round_up = limbs[start + dropped - 1] >= DECIMAL_LIMB_BASE / 2;
+
+        start += dropped;
+        count = precision_limbs;
+    }
+
+    memcpy(result.limbs, limbs + start, count * sizeof(u32));
+    result.size = count;
+    result.exponent = exponent + (s32) start;
+
+    if (round_up)
+    {
+        u32 i = 0;
+        for (; i < count; i++)
+        {
+            if (++result.limbs[i] < DECIMAL_LIMB_BASE)
+                break;
+
+            result.limbs[i] = 0;
+        }
+
+        if (i == count)
+            result.limbs[result.size++] = 1;
+
+        // Carrying leaves zeros at the bottom
+        u32 zeros = 0;
+        while (result.limbs[zeros] == 0)
+            zeros++;
+
+        if (zeros > 0)
+        {
+            memmove(result.limbs, result.limbs + zeros, (result.size - zeros) * sizeof(u32));
+            result.size -= zeros;
+            result.exponent += zeros;
+        }
+    }
+
+    return result;
+}
+
+// Rounds a value computed with a raised precision back down
+inline static Decimal round_to_precision(const Decimal& value)
+{
+    if (value.kind != Decimal::Kind::FINITE)
+        return value;
+
+    return from_limbs(value.limbs, value.size, value.exponent, value.negative);
+}
+
+Decimal make_decimal(s64 value)
+{
+    const bool negative = (value < 0);
+    u64 magnitude = negative ? (u64) -value : (u64) value;
+
+    u32 limbs[3];
+    u32 size = 0;
+    while (magnitude)
+    {
+        limbs[size++] = (u32) (magnitude % DECIMAL_LIMB_BASE);
+        magnitude /= DECIMAL_LIMB_BASE;
+    }
+
+    return from_limbs(limbs, size, 0, negative);
+}
+
+static Decimal make_half()
+{
+    const u32 limb = DECIMAL_LIMB_BASE / 2;
+    return from_limbs(&limb, 1, -1, false);
+}
+
+inline static bool is_true(const Decimal& a)
+{
+    return a.kind != Decimal::Kind::FINITE || a.size > 0;
+}
+
+inline static bool is_nan(const Decimal& a)
+{
+    return a.kind == Decimal::Kind::NOT_A_NUMBER;
+}
+
+inline static s32 top_position(const Decimal& a)
+{
+    return a.exponent + (s32) a.size;
+}
+
+// Limb at the given position (in powers of the base), 0 outside the number
+inline static u32 limb_at(const Decimal& a, s32 position)
+{
+    const s32 index = position - a.exponent;
+    return (index >= 0 && index < (s32) a.size) ? a.limbs[index] : 0;
+}
+
+// Term is too small to change a sum with the current precision
+inline static bool is_negligible(const Decimal& term, const Decimal& sum)
+{
+    return term.size == 0 || top_position(term) < top_position(sum) - (s32) precision_limbs - 1;
+}
+
+static s32 compare_magnitude(const Decimal& a, const Decimal& b)
+{
+    if (a.size == 0 || b.size == 0)
+        return (s32) (a.size != 0) - (s32) (b.size != 0);
+
+    if (top_position(a) != top_position(b))
+        return (top_position(a) > top_position(b)) ? 1 : -1;
+
+    s32 ia = (s32) a.size - 1;
+    s32 ib = (s32) b.size - 1;
+    for (; ia >= 0 && ib >= 0; ia--, ib--)
+    {
+        if (a.limbs[ia] != b.limbs[ib])
+            return (a.limbs[ia] > b.limbs[ib]) ? 1 : -1;
+    }
+
+    // Numbers don't have zeros at the bottom, so the longer one is bigger
+    return (ia >= 0) ? 1 : (ib >= 0) ? -1 : 0;
+}
+
+// |a| + |b|, or |a| - |b| when subtracting (|a| has to be bigger then)
+static Decimal add_magnitudes(const Decimal& a, const Decimal& b, bool subtract, bool negative)
+{
+    const s32 top = max(top_position(a), top_position(b));
+
+    // Limbs far below the precision can't change the rounded result
+    const s32 low = max(min(a.exponent, b.exponent), top - (s32) precision_limbs - 2);
+    const u32 count = (u32) (top - low) + 1;
+
+    u32 result[DECIMAL_MAX_LIMBS + 4];
+
+    if (subtract)
+    {
+        s64 borrow = 0;
+        for (u32 i = 0; i < count; i++)
+        {
+            s64 value = (s64) limb_at(a, low + i) - (s64) limb_at(b, low + i) - borrow;
+            borrow = (value < 0);
+            result[i] = (u32) (value + borrow * DECIMAL_LIMB_BASE);
+        }
+    }
+    else
+    {
+        u64 carry = 0;
+        for (u32 i = 0; i < count; i++)
+        {
+            const u64 value = (u64) limb_at(a, low + i) + limb_at(b, low + i) + carry;
+            carry = value / DECIMAL_LIMB_BASE;
+            result[i] = (u32) (value % DECIMAL_LIMB_BASE);
+        }
+    }
+
+    return from_limbs(result, count, low, negative);
+}
+
+static Decimal multiply_small(const Decimal& a, u32 factor)
+{
+    u32 result[DECIMAL_MAX_LIMBS + 1];
+
+    u64 carry = 0;
+    for (u32 i = 0; i < a.size; i++)
+    {
+        const u64 value = (u64) a.limbs[i] * factor + carry;
+        carry = value / DECIMAL_LIMB_BASE;
+        result[i] = (u32) (value % DECIMAL_LIMB_BASE);
+    }
+
+    result[a.size] = (u32) carry;
+
+    return from_limbs(result, a.size + 1, a.exponent, a.negative);
+}
+
+static Decimal divide_small(const Decimal& a, u32 divisor)
+{
+    if (a.size == 0)
+        return a;
+
+    // Quotient gets one limb more than the precision (and at least as many as the dividend)
+    const u32 count = max(precision_limbs + 1, a.size);
+    u32 quotient[DECIMAL_MAX_LIMBS + 2];
+
+    u64 remainder = 0;
+    for (u32 i = 0; i < count; i++)
+    {
+        const s32 index = (s32) a.size - 1 - (s32) i;
+        const u64 value = remainder * DECIMAL_LIMB_BASE + ((index >= 0) ? a.limbs[index] : 0);
+
+        quotient[count - 1 - i] = (u32) (value / divisor);
+        remainder = value % divisor;
+    }
+
+    return from_limbs(quotient, count, top_position(a) - (s32) count, a.negative);
+}
+
+Decimal operator-(const Decimal& a)
+{
+    Decimal result = a;
+
+    // There is no negative zero
+    if (a.size > 0 || a.kind != Decimal::Kind::FINITE)
+        result.negative = !a.negative;
+
+    return result;
+}
+
+Decimal operator+(const Decimal& a, const Decimal& b)
+{
+    if (a.kind != Decimal::Kind::FINITE || b.kind != Decimal::Kind::FINITE)
+        return decimal_from_f64(to_f64(a) + to_f64(b));
+
+    if (a.negative == b.negative)
+        return add_magnitudes(a, b, false, a.negative);
+
+    const s32 comparison = compare_magnitude(a, b);
+    if (comparison == 0)
+        return make_zero();
+
+    return (comparison > 0) ? add_magnitudes(a, b, true, a.negative) : add_magnitudes(b, a, true, b.negative);
+}
+
+Decimal operator-(const Decimal& a, const Decimal& b)
+{
+    return a + (-b);
+}
+
+Decimal operator*(const Decimal& a, const Decimal& b)
+{
+    if (a.kind != Decimal::Kind::FINITE || b.kind != Decimal::Kind::FINITE)
+        return decimal_from_f64(to_f64(a) * to_f64(b));
+
+    if (a.size == 0 || b.size == 0)
+        return make_zero();
+
+    u32 product[2 * DECIMAL_MAX_LIMBS] = {};
+
+    for (u32 i = 0; i < a.size; i++)
+    {
+        u64 carry = 0;
+        for (u32 j = 0; j < b.size; j++)
+        {
+            const u64 value = (u64) a.limbs[i] * b.limbs[j] + product[i + j] + carry;
+            carry = value / DECIMAL_LIMB_BASE;
+            product[i + j] = (u32) (value % DECIMAL_LIMB_BASE);
+        }
+
+        product[i + b.size] = (u32) carry;
+    }
+
+    return from_limbs(product, a.size + b.size, a.exponent + b.exponent, a.negative != b.negative);
+}
+
+// Helpers for long division on fixed size limb arrays (least significant first)
+
+static s32 compare_limbs(const u32 a[], const u32 b[], u32 count)
+{
+    for (u32 i = count; i-- > 0;)
+    {
+        if (a[i] != b[i])
+            return (a[i] > b[i]) ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static void subtract_limbs(u32 a[], const u32 b[], u32 count)
+{
+    s64 borrow = 0;
+    for (u32 i = 0; i < count; i++)
+    {
+        const s64 value = (s64) a[i] - (s64) b[i] - borrow;
+        borrow = (value < 0);
+        a[i] = (u32) (value + borrow * DECIMAL_LIMB_BASE);
+    }
+}
+
+static void multiply_limbs(const u32 a[], u32 count, u32 factor, u32 result[])
+{
+    u64 carry = 0;
+    for (u32 i = 0; i < count; i++)
+    {
+        const u64 value = (u64) a[i] * factor + carry;
+        carry = value / DECIMAL_LIMB_BASE;
+        result[i] = (u32) (value % DECIMAL_LIMB_BASE);
+    }
+}
+
+Decimal operator/(const Decimal& a, const Decimal& b)
+{
+    if (a.kind != Decimal::Kind::FINITE || b.kind != Decimal::Kind::FINITE || b.size == 0)
+        return decimal_from_f64(to_f64(a) / to_f64(b));
+
+    if (a.size == 0)
+        return make_zero();
+
+    if (b.size == 1)
+    {
+        Decimal result = divide_small(a, b.limbs[0]);
+        result.exponent -= b.exponent;
+        result.negative = (a.negative != b.negative) && result.size > 0;
+        return result;
+    }
+
+    // Zeros are added below the dividend so the quotient has one limb more than the precision
+    const u32 extra = (u32) max(0, (s32) (precision_limbs + 1 + b.size) - (s32) a.size);
+    const u32 dividend_size = a.size + extra;
+
+    // Divisor with a zero limb on top so it lines up with the remainder
+    const u32 width = b.size + 1;
+    u32 divisor[DECIMAL_MAX_LIMBS + 1];
+    memcpy(divisor, b.limbs, b.size * sizeof(u32));
+    divisor[b.size] = 0;
+
+    u32 remainder[DECIMAL_MAX_LIMBS + 1] = {};
+    u32 product[DECIMAL_MAX_LIMBS + 1];
+    u32 quotient[3 * DECIMAL_MAX_LIMBS];
+
+    // Leading limbs of the divisor for estimating quotient limbs
+    const f64 base = DECIMAL_LIMB_BASE;
+    const f64 divisor_top = b.limbs[b.size - 1] + b.limbs[b.size - 2] / base + ((b.size > 2) ? b.limbs[b.size - 3] / (base * base) : 0.0);
+
+    for (u32 i = dividend_size; i-- > 0;)
+    {
+        // remainder = remainder * base + next limb
+        memmove(remainder + 1, remainder, (width - 1) * sizeof(u32));
+        remainder[0] = (i >= extra) ? a.limbs[i - extra] : 0;
+
+        const f64 remainder_top = remainder[b.size] * base + remainder[b.size - 1] + remainder[b.size - 2] / base +
+                                  ((b.size > 2) ? remainder[b.size - 3] / (base * base) : 0.0);
+
+        u32 digit = (u32) clamp(floor(remainder_top / divisor_top), 0.0, base - 1.0);
+
+        // The estimate can be off by one in either direction
+        multiply_limbs(divisor, width, digit, product);
+        while (compare_limbs(product, remainder, width) > 0)
+        {
+            digit--;
+            subtract_limbs(product, divisor, width);
+        }
+
+        subtract_limbs(remainder, product, width);
+
+        while (compare_limbs(remainder, divisor, width) >= 0)
+        {
+            digit++;
+            subtract_limbs(remainder, divisor, width);
+        }
+
+        quotient[i] = digit;
+    }
+
+    return from_limbs(quotient, dividend_size, a.exponent - (s32) extra - b.exponent, a.negative != b.negative);
+}
+
+// Comparison of numbers that aren't NaN
+static s32 compare(const Decimal& a, const Decimal& b)
+{
+    if (a.kind == Decimal::Kind::INFINITE || b.kind == Decimal::Kind::INFINITE)
+    {
+        const f64 fa = to_f64(a);
+        const f64 fb = to_f64(b);
+        return (fa > fb) ? 1 : (fa < fb) ? -1 : 0;
+    }
+
+    if (a.negative != b.negative)
+        return a.negative ? -1 : 1;
+
+    const s32 comparison = compare_magnitude(a, b);
+    return a.negative ? -comparison : comparison;
+}
+
+bool operator==(const Decimal& a, const Decimal& b) { return !is_nan(a) && !is_nan(b) && compare(a, b) == 0; }
+bool operator!=(const Decimal& a, const Decimal& b) { return !(a == b); }
+bool operator< (const Decimal& a, const Decimal& b) { return !is_nan(a) && !is_nan(b) && compare(a, b) <  0; }
+bool operator> (const Decimal& a, const Decimal& b) { return !is_nan(a) && !is_nan(b) && compare(a, b) >  0; }
+bool operator<=(const Decimal& a, const Decimal& b) { return !is_nan(a) && !is_nan(b) && compare(a, b) <= 0; }
+bool operator>=(const Decimal& a, const Decimal& b) { return !is_nan(a) && !is_nan(b) && compare(a, b) >= 0; }
+
+// Integer closest to the value, or the integer part when truncating
+static Decimal round_to_integer(const Decimal& a, bool truncate)
+{
+    if (a.kind != Decimal::Kind::FINITE || a.size == 0 || a.exponent >= 0)
+        return a;
+
+    const u32 fraction_size = (u32) -a.exponent;
+
+    u32 limbs[DECIMAL_MAX_LIMBS + 1];
+    u32 size = 0;
+    for (u32 i = fraction_size; i < a.size; i++)
+        limbs[size++] = a.limbs[i];
+
+    // Limb right after the point decides the rounding
+    if (!truncate && limb_at(a, -1) >= DECIMAL_LIMB_BASE / 2)
+    {
+        u32 i = 0;
+        for (; i < size; i++)
+        {
+            if (++limbs[i] < DECIMAL_LIMB_BASE)
+                break;
+
+            limbs[i] = 0;
+        }
+
+        if (i == size)
+            limbs[size++] = 1;
+    }
+
+    return from_limbs(limbs, size, 0, a.negative);
+}
+
+// Approximation of the value as leading * base^limb_exponent, with leading in [1, base)
+static f64 leading_f64(const Decimal& a, s32& limb_exponent)
+{
+    const f64 base = DECIMAL_LIMB_BASE;
+
+    limb_exponent = top_position(a) - 1;
+    return limb_at(a, limb_exponent) + limb_at(a, limb_exponent - 1) / base + limb_at(a, limb_exponent - 2) / (base * base);
+}
+
+static Decimal decimal_sqrt(const Decimal& a)
+{
+    if (a.kind != Decimal::Kind::FINITE || a.negative)
+        return decimal_from_f64(sqrt(a.negative ? -1.0 : to_f64(a)));
+
+    if (a.size == 0)
+        return a;
+
+    // Starting from the f64 square root of the leading limbs
+    s32 limb_exponent;
+    f64 leading = leading_f64(a, limb_exponent);
+    if (limb_exponent % 2 != 0)
+    {
+        leading *= DECIMAL_LIMB_BASE;
+        limb_exponent--;
+    }
+
+    Decimal x = decimal_from_f64(sqrt(leading));
+    x.exponent += limb_exponent / 2;
+
+    const u32 previous = raise_precision(2);
+    const Decimal half = make_half();
+
+    // Newton's method, doubles the number of correct digits each step
+    for (u32 digits = 8; digits < 2 * precision_limbs * DECIMAL_LIMB_DIGITS; digits *= 2)
+        x = (x + a / x) * half;
+
+    precision_limbs = previous;
+    return round_to_precision(x);
+}
+
+static Decimal decimal_exp(const Decimal& a)
+{
+    if (a.kind != Decimal::Kind::FINITE)
+        return decimal_from_f64(exp(to_f64(a)));
+
+    if (a.size == 0)
+        return make_decimal(1);
+
+    // Results past this have more digits in the exponent than an s32 can hold
+    const f64 approximate = to_f64(a);
+    if (approximate > 4.0e10)
+        return make_special(Decimal::Kind::INFINITE, false);
+
+    if (approximate < -4.0e10)
+        return make_zero();
+
+    // The series below adds up to e^a - 1, which is about -1 for large negative arguments so
+    // adding the 1 back would cancel all the digits. e^-a doesn't have that problem.
+    if (a.negative)
+    {
+        const u32 previous = raise_precision(1);
+        const Decimal result = make_decimal(1) / decimal_exp(-a);
+
+        precision_limbs = previous;
+        return round_to_precision(result);
+    }
+
+    const u32 previous = raise_precision(3);
+
+    // e^a = (e^(a / 2^k))^(2^k), the series converges quickly for the small argument
+    u32 halvings = (fabs(approximate) > 1e-3) ? (u32) (log2(fabs(approximate)) + 10.0) : 0;
+
+    Decimal r = a;
+    for (u32 remaining = halvings; remaining > 0;)
+    {
+        const u32 step = min(remaining, 29u);
+        r = divide_small(r, 1u << step);
+        remaining -= step;
+    }
+
+    // Series for e^r - 1 (keeping the 1 out keeps the precision of small values)
+    Decimal sum  = r;
+    Decimal term = r;
+    for (u32 n = 2; ; n++)
+    {
+        term = divide_small(term * r, n);
+        if (is_negligible(term, sum))
+            break;
+
+        sum = sum + term;
+    }
+
+    // (s + 1)^2 - 1 = s * (s + 2)
+    const Decimal two = make_decimal(2);
+    for (u32 i = 0; i < halvings; i++)
+        sum = sum * (sum + two);
+
+    sum = sum + make_decimal(1);
+
+    precision_limbs = previous;
+    return round_to_precision(sum);
+}
+
+Decimal decimal_e()
+{
+    return decimal_exp(make_decimal(1));
+}
+
+static Decimal decimal_log(const Decimal& a)
+{
+    if (a.kind == Decimal::Kind::FINITE && a.negative)
+        return make_special(Decimal::Kind::NOT_A_NUMBER, false);
+
+    if (a.kind != Decimal::Kind::FINITE || a.size == 0)
+        return decimal_from_f64(log(to_f64(a)));
+
+    const Decimal one = make_decimal(1);
+    if (a == one)
+        return make_zero();
+
+    // Starting from the f64 logarithm of the leading limbs
+    s32 limb_exponent;
+    const f64 leading = leading_f64(a, limb_exponent);
+    Decimal x = decimal_from_f64(log(leading) + limb_exponent * (DECIMAL_LIMB_DIGITS * 2.302585092994045684));
+
+    const u32 previous = raise_precision(2);
+
+    // Halley's method for e^x = a, triples the number of correct digits each step
+    for (u32 digits = 5; digits < 3 * precision_limbs * DECIMAL_LIMB_DIGITS; digits *= 3)
+    {
+        const Decimal e = decimal_exp(x);
+        x = x + multiply_small(a - e, 2) / (a + e);
+    }
+
+    precision_limbs = previous;
+    return round_to_precision(x);
+}
+
+// atan(1 / n) = 1/n - 1/(3n^3) + 1/(5n^5) - ...
+static Decimal atan_inverse(u32 n)
+{
+    Decimal power = divide_small(make_decimal(1), n);
+    Decimal sum = power;
+
+    for (u32 k = 1; ; k++)
+    {
+        power = divide_small(power, n * n);
+
+        const Decimal term = divide_small(power, 2 * k + 1);
+        if (is_negligible(term, sum))
+            break;
+
+        sum = (k % 2) ? sum - term : sum + term;
+    }
+
+    return sum;
+}
+
+static Decimal pi_cache;
+static u32     pi_cache_limbs = 0;
+
+Decimal decimal_pi()
+{
+    if (pi_cache_limbs < precision_limbs)
+    {
+        // Machin's formula: pi = 16 atan(1/5) - 4 atan(1/239)
+        const u32 previous = raise_precision(1);
+
+        pi_cache = multiply_small(atan_inverse(5), 16) - multiply_small(atan_inverse(239), 4);
+        pi_cache_limbs = precision_limbs;
+
+        precision_limbs = previous;
+    }
+
+    return round_to_precision(pi_cache);
+}
+
+static void decimal_sin_cos(const Decimal& a, Decimal& sin_a, Decimal& cos_a)
+{
+    if (a.kind != Decimal::Kind::FINITE)
+    {
+        sin_a = cos_a = make_special(Decimal::Kind::NOT_A_NUMBER, false);
+        return;
+    }
+
+    // Reducing large arguments needs pi with as many more digits as the argument has in its integer part
+    const u32 previous = raise_precision(2 + (u32) max(0, top_position(a)));
+    const Decimal half_pi = decimal_pi() * make_half();
+
+    // Reduce to [-pi/4, pi/4] remembering the quadrant
+    const Decimal quadrants = round_to_integer(a / half_pi, false);
+    const Decimal r = a - quadrants * half_pi;
+
+    // Powers of the base are multiples of 4, only the lowest limb decides the quadrant
+    u32 quadrant = (quadrants.exponent == 0 && quadrants.size > 0) ? quadrants.limbs[0] % 4 : 0;
+    if (quadrants.negative)
+        quadrant = (4 - quadrant) % 4;
+
+    precision_limbs = min(previous + 2, DECIMAL_MAX_LIMBS - 1);
+
+    Decimal s = r;
+    Decimal c = make_decimal(1);
+
+    if (r.size > 0)
+    {
+        const Decimal r2 = -(r * r);
+
+        Decimal term = r;
+        for (u32 n = 2; ; n += 2)
+        {
+            term = divide_small(term * r2, n * (n + 1));
+            if (is_negligible(term, s))
+                break;
+
+            s = s + term;
+        }
+
+        term = c;
+        for (u32 n = 1; ; n += 2)
+        {
+            term = divide_small(term * r2, n * (n + 1));
+            if (is_negligible(term, c))
+                break;
+
+            c = c + term;
+        }
+    }
+
+    precision_limbs = previous;
+
+    switch (quadrant)
+    {
+        case 0: { sin_a =  s; cos_a =  c; } break;
+        case 1: { sin_a =  c; cos_a = -s; } break;
+        case 2: { sin_a = -s; cos_a = -c; } break;
+        case 3: { sin_a = -c; cos_a =  s; } break;
+    }
+
+    sin_a = round_to_precision(sin_a);
+    cos_a = round_to_precision(cos_a);
+}
+
+static Decimal decimal_sinh(const Decimal& a)
+{
+    // e^a - e^-a loses the precision of values smaller than 1
+    if (a.kind == Decimal::Kind::FINITE && a.size > 0 && top_position(a) <= 0)
+    {
+        const u32 previous = raise_precision(1);
+        const Decimal a2 = a * a;
+
+        Decimal sum  = a;
+        Decimal term = a;
+        for (u32 n = 2; ; n += 2)
+        {
+            term = divide_small(term * a2, n * (n + 1));
+            if (is_negligible(term, sum))
+                break;
+
+            sum = sum + term;
+        }
+
+        precision_limbs = previous;
+        return round_to_precision(sum);
+    }
+
+    const Decimal e = decimal_exp(a);
+    return (e - make_decimal(1) / e) * make_half();
+}
+
+static Decimal decimal_cosh(const Decimal& a)
+{
+    const Decimal e = decimal_exp(a);
+    return (e + make_decimal(1) / e) * make_half();
+}
+
+static Decimal decimal_tanh(const Decimal& a)
+{
+    // Past this tanh is 1 to more digits than the max precision
+    const f64 approximate = to_f64(a);
+    if (fabs(approximate) > 400.0)
+        return make_decimal((approximate > 0.0) ? 1 : -1);
+
+    return decimal_sinh(a) / decimal_cosh(a);
+}
+
+static Decimal decimal_pow(const Decimal& a, const Decimal& b)
+{
+    if (a.kind != Decimal::Kind::FINITE || b.kind != Decimal::Kind::FINITE || a.size == 0)
+        return decimal_from_f64(pow(to_f64(a), to_f64(b)));
+
+    // Integer powers by repeated squaring, exact if the result fits in the precision
+    if (b.exponent >= 0 && top_position(b) <= 2)
+    {
+        const u64 n = (u64) limb_at(b, 1) * DECIMAL_LIMB_BASE + limb_at(b, 0);
+        if (n < 0x80000000Ui64)
+        {
+            const u32 previous = raise_precision(1);
+
+            Decimal result = make_decimal(1);
+            Decimal base = a;
+
+            for (u64 m = n; m > 0; m >>= 1)
+            {
+                if (m & 1)
+                    result = result * base;
+
+                if (m > 1)
+                    base = base * base;
+            }
+
+            if (b.negative)
+                result = make_decimal(1) / result;
+
+            precision_limbs = previous;
+            return round_to_precision(result);
+        }
+    }
+
+    if (a.negative)
+        return decimal_from_f64(pow(to_f64(a), to_f64(b)));
+
+    const u32 previous = raise_precision(1);
+    const Decimal result = decimal_exp(b * decimal_log(a));
+    precision_limbs = previous;
+
+    return round_to_precision(result);
+}
+
+static Decimal decimal_fmod(const Decimal& a, const Decimal& b)
+{
+    if (a.kind == Decimal::Kind::FINITE && b.kind == Decimal::Kind::INFINITE)
+        return a;
+
+    if (a.kind != Decimal::Kind::FINITE || b.kind != Decimal::Kind::FINITE || b.size == 0)
+        return decimal_from_f64(fmod(to_f64(a), to_f64(b)));
+
+    // The integer part of the quotient has to be exact
+    const u32 previous = raise_precision(1 + (u32) max(0, top_position(a) - top_position(b) + 1));
+
+    const Decimal quotient = round_to_integer(a / b, true);
+    Decimal result = a - quotient * b;
+
+    // Rounding in the division can make the quotient off by one
+    Decimal step = b;
+    step.negative = a.negative;
+
+    if (result.size > 0 && result.negative != a.negative)
+        result = result + step;
+    else if (compare_magnitude(result, b) >= 0)
+        result = result - step;
+
+    precision_limbs = previous;
+    return round_to_precision(result);
+}
+
+Decimal decimal_from_f64(f64 value)
+{
+    if (value != value)
+        return make_special(Decimal::Kind::NOT_A_NUMBER, false);
+
+    if (!std::isfinite(value))
+        return make_special(Decimal::Kind::INFINITE, value < 0.0);
+
+    char buffer[32];
+    to_shortest_chars(value, buffer, sizeof(buffer));
+
+    return decimal_from_string(buffer);
+}
+
+Decimal decimal_from_string(const char* str)
+{
+    constexpr u32 MAX_PARSED_DIGITS = (DECIMAL_MAX_LIMBS - 1) * DECIMAL_LIMB_DIGITS;
+
+    bool negative = false;
+    if (*str == '-' || *str == '+')
+        negative = (*str++ == '-');
+
+    u8  digits[MAX_PARSED_DIGITS + DECIMAL_LIMB_DIGITS];
+    u32 digit_count = 0;
+    s32 exponent = 0;
+    bool after_point = false;
+
+    for (; (*str >= '0' && *str <= '9') || *str == '.'; str++)
+    {
+        if (*str == '.')
+        {
+            after_point = true;
+            continue;
+        }
+
+        // Leading zeros only move the point, digits past the max precision are dropped
+        if (digit_count == 0 && *str == '0')
+        {
+            exponent -= after_point;
+        }
+        else if (digit_count < MAX_PARSED_DIGITS)
+        {
+            digits[digit_count++] = (u8) (*str - '0');
+            exponent -= after_point;
+        }
+        else
+        {
+            exponent += !after_point;
+        }
+    }
+
+    if (*str == 'e' || *str == 'E')
+        exponent += atoi(str + 1);
+
+    // Pad with zeros so the exponent is a multiple of the limb size
+    while (exponent % (s32) DECIMAL_LIMB_DIGITS != 0)
+    {
+        digits[digit_count++] = 0;
+        exponent--;
+    }
+
+    u32 limbs[DECIMAL_MAX_LIMBS + 1];
+    u32 size = 0;
+
+    for (s32 end = (s32) digit_count; end > 0; end -= DECIMAL_LIMB_DIGITS)
+    {
+        u32 limb = 0;
+        for (s32 i = max(0, end - (s32) DECIMAL_LIMB_DIGITS); i < end; i++)
+            limb = limb * 10 + digits[i];
+
+        limbs[size++] = limb;
+    }
+
+    return from_limbs(limbs, size, exponent / (s32) DECIMAL_LIMB_DIGITS, negative);
+}
+
+// Digits of the value rounded to max_digits, returns the number of digits without trailing zeros
+static u32 get_digits(const Decimal& value, u32 max_digits, u8 digits[], s32& exponent)
+{
+    const u32 top = value.limbs[value.size - 1];
+
+    u32 top_digits = 1;
+    for (u32 t = top; t >= 10; t /= 10)
+        top_digits++;
+
+    exponent = (top_position(value) - 1) * (s32) DECIMAL_LIMB_DIGITS + (s32) top_digits - 1;
+
+    // One digit more than needed for rounding
+    u32 count = 0;
+    for (s32 i = (s32) value.size - 1; i >= 0 && count <= max_digits; i--)
+    {
+        const u32 limb_digits = (i == (s32) value.size - 1) ? top_digits : DECIMAL_LIMB_DIGITS;
+
+        u8 limb_buffer[DECIMAL_LIMB_DIGITS];
+        u32 limb = value.limbs[i];
+        for (u32 j = limb_digits; j-- > 0;)
+        {
+            limb_buffer[j] = (u8) (limb % 10);
+            limb /= 10;
+        }
+
+        for (u32 j = 0; j < limb_digits && count <= max_digits; j++)
+            digits[count++] = limb_buffer[j];
+    }
+
+    if (count > max_digits)
+    {
+        const bool round_up = digits[max_digits] >= 5;
+        count = max_digits;
+
+        if (round_up)
+        {
+            s32 i = (s32) count - 1;
+            while (i >= 0 && digits[i] == 9)
+                digits[i--] = 0;
+
+            if (i >= 0)
+            {
+                digits[i]++;
+            }
+            else
+            {
+                digits[0] = 1;
+                exponent++;
+            }
+        }
+    }
+
+    while (count > 1 && digits[count - 1] == 0)
+        count--;
+
+    return count;
+}
+
+f64 to_f64(const Decimal& value)
+{
+    switch (value.kind)
+    {
+        case Decimal::Kind::NOT_A_NUMBER: return NAN;
+        case Decimal::Kind::INFINITE:     return value.negative ? -INFINITY : INFINITY;
+    }
+
+    if (value.size == 0)
+        return 0.0;
+
+    u8 digits[18];
+    s32 exponent;
+    const u32 count = get_digits(value, 17, digits, exponent);
+
+    char buffer[32];
+    u64 length = 0;
+
+    if (value.negative)
+        buffer[length++] = '-';
+
+    buffer[length++] = '0';
+    buffer[length++] = '.';
+    for (u32 i = 0; i < count; i++)
+        buffer[length++] = (char) ('0' + digits[i]);
+
+    snprintf(buffer + length, sizeof(buffer) - length, "e%d", exponent + 1);
+
+    return strtod(buffer, nullptr);
+}
+
+u64 to_chars(const Decimal& value, char buffer[], u64 buffer_size)
+{
+    switch (value.kind)
+    {
+        case Decimal::Kind::NOT_A_NUMBER: return snprintf(buffer, buffer_size, "nan");
+        case Decimal::Kind::INFINITE:     return snprintf(buffer, buffer_size, value.negative ? "-inf" : "inf");
+    }
+
+    if (value.size == 0)
+        return snprintf(buffer, buffer_size, "0");
+
+    u8 digits[DECIMAL_MAX_DIGITS + 1];
+    s32 exponent;
+    const u32 count = get_digits(value, precision_digits, digits, exponent);
+
+    return format_digits(digits, count, exponent, value.negative, buffer, buffer_size);
+}
+
+Decimal apply_operator(const Operator& op, const Decimal operands[])
+{
+    const Decimal& a = operands[0];
+    const Decimal& b = (op.operand_count > 1) ? operands[1] : operands[0];
+
+    switch (op.code)
+    {
+        case OperatorCode::NEG:           return -a;
+        case OperatorCode::MULTIPLY:      return a * b;
+        case OperatorCode::DIVIDE:        return a / b;
+        case OperatorCode::REMAINDER:     return decimal_fmod(a, b);
+        case OperatorCode::ADD:           return a + b;
+        case OperatorCode::SUBTRACT:      return a - b;
+        case OperatorCode::POW:           return decimal_pow(a, b);
+        case OperatorCode::AND:           return make_decimal(is_true(a) && is_true(b));
+        case OperatorCode::OR:            return make_decimal(is_true(a) || is_true(b));
+        case OperatorCode::NOT:           return make_decimal(!is_true(a));
+        case OperatorCode::GREATER:       return make_decimal(a > b);
+        case OperatorCode::LESSER:        return make_decimal(a < b);
+        case OperatorCode::GREATER_EQUAL: return make_decimal(a >= b);
+        case OperatorCode::LESSER_EQUAL:  return make_decimal(a <= b);
+        case OperatorCode::EQUAL:         return make_decimal(a == b);
+        case OperatorCode::NOT_EQUAL:     return make_decimal(a != b);
+        case OperatorCode::NATURAL_LOG:   return decimal_log(a);
+        case OperatorCode::LOG:           return decimal_log(b) / decimal_log(a);
+        case OperatorCode::SQRT:          return decimal_sqrt(a);
+        case OperatorCode::EXP:           return decimal_exp(a);
+        case OperatorCode::SINH:          return decimal_sinh(a);
+        case OperatorCode::COSH:          return decimal_cosh(a);
+        case OperatorCode::TANH:          return decimal_tanh(a);
+        case OperatorCode::MAX:           return (a > b) ? a : b;
+        case OperatorCode::MIN:           return (a < b) ? a : b;
+        case OperatorCode::COND:          return is_true(a) ? operands[1] : operands[2];
+
+        case OperatorCode::SIN:
+        case OperatorCode::COS:
+        case OperatorCode::TAN:
+        case OperatorCode::SEC:
+        case OperatorCode::COSEC:
+        case OperatorCode::COT:
+        {
+            Decimal s, c;
+            decimal_sin_cos(a, s, c);
+
+            switch (op.code)
+            {
+                case OperatorCode::SIN:   return s;
+                case OperatorCode::COS:   return c;
+                case OperatorCode::TAN:   return s / c;
+                case OperatorCode::SEC:   return make_decimal(1) / c;
+                case OperatorCode::COSEC: return make_decimal(1) / s;
+                case OperatorCode::COT:   return c / s;
+            }
+        } break;
+    }
+
+    gn_assert_with_message(false, "Operator doesn't have a decimal implementation! (code: %)", (u32) op.code);
+    return make_special(Decimal::Kind::NOT_A_NUMBER, false);
+}
+
+} // namespace Calculator
+
+template <>
+void print_to_file(FILE* file, const Calculator::Decimal& value)
+{
+    char buffer[Calculator::DECIMAL_MAX_DIGITS + 32];
+    Calculator::to_chars(value, buffer, sizeof(buffer));
+    print_to_file(file, buffer);
+}
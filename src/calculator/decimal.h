@@ -0,0 +1,75 @@
+#pragma once
+
+#include "core/float_format.h"
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+constexpr u32 DECIMAL_LIMB_DIGITS = 9;
+constexpr u32 DECIMAL_LIMB_BASE   = 1000000000;
+constexpr u32 DECIMAL_MAX_LIMBS   = 40;         // Enough for the max precision plus guard limbs
+constexpr u32 DECIMAL_MAX_DIGITS  = 300;
+
+// Decimal floating point number with a precision that is set at runtime (set_decimal_precision).
+// Sums, differences and products of numbers that fit in the precision are exact.
+struct Decimal
+{
+    enum struct Kind : u8
+    {
+        FINITE,
+        INFINITE,
+        NOT_A_NUMBER,
+    };
+
+    u32  limbs[DECIMAL_MAX_LIMBS];  // Base 10^9 digits, least significant first
+    u32  size;                      // Zero has no limbs
+    s32  exponent;                  // Value is limbs * 10^(9 * exponent)
+    bool negative;
+    Kind kind;
+};
+
+// Sets the number of significant digits results are printed with (clamped to DECIMAL_MAX_DIGITS).
+// Rounding is limb-granular: results keep the limbs needed for the digits plus one guard limb and are rounded
+// half up at a limb boundary. How many digits that is depends on where the leading digit falls in its limb,
+// but it is always more than asked for. Only to_chars rounds to the digit, the extra digits make the printed
+// result correctly rounded most of the time.
+void set_decimal_precision(u32 digits);
+u32  get_decimal_precision();
+
+Decimal make_decimal(s64 value);
+
+// Converts the number through its shortest decimal representation, so 0.1 becomes exactly 0.1
+Decimal decimal_from_f64(f64 value);
+
+// Parses a decimal number (digits, an optional point and an optional exponent)
+Decimal decimal_from_string(const char* str);
+
+// pi and e with the limbs of the precision
+Decimal decimal_pi();
+Decimal decimal_e();
+
+f64 to_f64(const Decimal& value);
+
+// Writes the value rounded to the precision, returns the number of characters written
+u64 to_chars(const Decimal& value, char buffer[], u64 buffer_size);
+
+Decimal operator-(const Decimal& a);
+Decimal operator+(const Decimal& a, const Decimal& b);
+Decimal operator-(const Decimal& a, const Decimal& b);
+Decimal operator*(const Decimal& a, const Decimal& b);
+Decimal operator/(const Decimal& a, const Decimal& b);
+
+// Comparisons follow f64 rules, any comparison with NaN is false (except !=)
+bool operator==(const Decimal& a, const Decimal& b);
+bool operator!=(const Decimal& a, const Decimal& b);
+bool operator< (const Decimal& a, const Decimal& b);
+bool operator> (const Decimal& a, const Decimal& b);
+bool operator<=(const Decimal& a, const Decimal& b);
+bool operator>=(const Decimal& a, const Decimal& b);
+
+// Solves the operator the same way as opdef.h does, but in decimal with the current precision
+Decimal apply_operator(const Operator& op, const Decimal operands[]);
+
+} // namespace Calculator
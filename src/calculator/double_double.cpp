@@ -0,0 +1,580 @@
+#include "double_double.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include "core/float_format.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "math/common.h"
+#include "decimal.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+static const DoubleDouble DD_PI      = { 3.141592653589793116e+00, 1.224646799147353207e-16 };
+static const DoubleDouble DD_HALF_PI = { 1.570796326794896558e+00, 6.123233995736766036e-17 };
+static const DoubleDouble DD_E       = { 2.718281828459045091e+00, 1.445646891729250158e-16 };
+static const DoubleDouble DD_LN2     = { 6.931471805599452862e-01, 2.319046813846299558e-17 };
+
+constexpr f64 DD_EPSILON = 4.93038065763132e-32;    // 2^-104
+
+static const DoubleDouble DD_ONE = { 1.0, 0.0 };
+
+inline static bool is_true(DoubleDouble a)
+{
+    return a.hi != 0.0;
+}
+
+static DoubleDouble dd_floor(DoubleDouble a)
+{
+    const f64 hi = floor(a.hi);
+
+    // The low part only matters when the high part is already an integer
+    if (hi == a.hi)
+        return quick_two_sum(hi, floor(a.lo));
+
+    return make_double_double(hi);
+}
+
+static DoubleDouble dd_trunc(DoubleDouble a)
+{
+    return (a.hi >= 0.0) ? dd_floor(a) : -dd_floor(-a);
+}
+
+static DoubleDouble dd_round(DoubleDouble a)
+{
+    return dd_floor(a + make_double_double(0.5));
+}
+
+static DoubleDouble dd_pow10(u32 exponent)
+{
+    DoubleDouble result = DD_ONE;
+    DoubleDouble base = make_double_double(10.0);
+
+    while (exponent)
+    {
+        if (exponent & 1)
+            result = result * base;
+
+        base = base * base;
+        exponent >>= 1;
+    }
+
+    return result;
+}
+
+static DoubleDouble dd_sqrt(DoubleDouble a)
+{
+    if (a.hi <= 0.0 || !std::isfinite(a.hi))
+        return make_double_double(sqrt(a.hi));
+
+    // One Newton step on top of the f64 square root (Karp's trick)
+    const f64 x  = 1.0 / sqrt(a.hi);
+    const f64 ax = a.hi * x;
+
+    const DoubleDouble error = a - two_prod(ax, ax);
+    return two_sum(ax, error.hi * (x * 0.5));
+}
+
+static DoubleDouble dd_exp(DoubleDouble a)
+{
+    if (a.hi > 709.8)
+        return make_double_double(INFINITY);
+
+    if (a.hi < -745.2)
+        return make_double_double(0.0);
+
+    if (a.hi != a.hi)
+        return a;
+
+    // e^a = 2^m * (e^r)^512 where |r| <= ln(2) / 1024
+    const f64 m = floor(a.hi / DD_LN2.hi + 0.5);
+    const DoubleDouble r = (a - DD_LN2 * m) * (1.0 / 512.0);
+
+    // Series for e^r - 1 (keeping the 1 out keeps the precision of small values)
+    DoubleDouble sum  = r;
+    DoubleDouble term = r;
+    for (f64 n = 2.0; n < 20.0; n++)
+    {
+        term = term * r / make_double_double(n);
+        sum = sum + term;
+
+        if (fabs(term.hi) <= DD_EPSILON * fabs(sum.hi))
+            break;
+    }
+
+    // (s + 1)^2 - 1 = 2s + s^2
+    for (u32 i = 0; i < 9; i++)
+        sum = sum * 2.0 + sum * sum;
+
+    sum = sum + DD_ONE;
+
+    return DoubleDouble { ldexp(sum.hi, (int) m), ldexp(sum.lo, (int) m) };
+}
+
+static DoubleDouble dd_log(DoubleDouble a)
+{
+    if (a.hi <= 0.0 || !std::isfinite(a.hi))
+        return make_double_double(log(a.hi));
+
+    // One Newton step for e^x = a on top of the f64 logarithm
+    const DoubleDouble x = make_double_double(log(a.hi));
+    return x + a * dd_exp(-x) - DD_ONE;
+}
+
+// 2/pi in chunks of 24 bits, enough for the reduction of any finite value (the same table as fdlibm)
+static const s64 TWO_OVER_PI[] =
+{
+    0xA2F983, 0x6E4E44, 0x1529FC, 0x2757D1, 0xF534DD, 0xC0DB62,
+    0x95993C, 0x439041, 0xFE5163, 0xABDEBB, 0xC561B7, 0x246E3A,
+    0x424DD2, 0xE00649, 0x2EEA09, 0xD1921C, 0xFE1DEB, 0x1CB129,
+    0xA73EE8, 0x8235F5, 0x2EBB44, 0x84E99C, 0x7026B4, 0x5F7E41,
+    0x3991D6, 0x398353, 0x39F49C, 0x845F8B, 0xBDF928, 0x3B1FF8,
+    0x97FFDE, 0x05980F, 0xEF2F11, 0x8B5A0A, 0x6D1F6D, 0x367ECF,
+    0x27CB09, 0xB74F46, 0x3F669E, 0x5FEA2D, 0x7527BA, 0xC7EBE5,
+    0xF17B3D, 0x0739F7, 0x8A5292, 0xEA6BFB, 0x5FB11F, 0x8D5D08,
+    0x560330, 0x46FC7B, 0x6BABF0, 0xCFBC20, 0x9AF436, 0x1DA9E3,
+    0x91615E, 0xE61B08, 0x659985, 0x5F14A0, 0x68408D, 0xFFD880,
+    0x4D7327, 0x310606, 0x1556CA, 0x73A8C9, 0x60E27B, 0xC08C6B,
+};
+
+constexpr u32 TWO_OVER_PI_COUNT = sizeof(TWO_OVER_PI) / sizeof(TWO_OVER_PI[0]);
+constexpr u32 REDUCTION_LIMBS = 13;     // The integer part and 12 limbs of 24 bits of the fraction
+constexpr s64 LIMB_MASK = 0xFFFFFF;
+
+// Adds sign * value * 2/pi to limbs, where limbs[i] holds the bits of 2^(-24 i). Bits above 2^1 are
+// multiples of 4 (a whole turn), so only the limbs from the integer part down are kept.
+static void add_times_two_over_pi(s64 limbs[], f64 value)
+{
+    if (value == 0.0)
+        return;
+
+    const s64 sign = (value < 0.0) ? -1 : 1;
+
+    int exponent;
+    const u64 mantissa = (u64) ldexp(fabs(frexp(value, &exponent)), 53);
+    exponent -= 53;
+
+    // value = mantissa * 2^(24 q + shift), the mantissa shifted goes into limbs of 24 bits
+    const s32 q = (exponent >= 0) ? exponent / 24 : -((-exponent + 23) / 24);
+    const s32 shift = exponent - 24 * q;
+
+    s64 digits[4] = {};
+    for (u32 j = 0; j < 3; j++)
+    {
+        const s64 part = (s64) ((mantissa >> (24 * j)) & LIMB_MASK) << shift;
+        digits[j]     += part & LIMB_MASK;
+        digits[j + 1] += part >> 24;
+    }
+
+    for (s32 j = 0; j < 4; j++)
+    {
+        for (s32 i = 0; i < (s32) TWO_OVER_PI_COUNT; i++)
+        {
+            const s32 limb = -(q + j - i - 1);
+            if (limb < 0)
+                continue;
+            if (limb >= (s32) REDUCTION_LIMBS)
+                break;
+
+            limbs[limb] += sign * digits[j] * TWO_OVER_PI[i];
+        }
+    }
+}
+
+// Payne-Hanek reduction: a = (quadrant + r / (pi/2)) * pi/2 with r in [-pi/4, pi/4]. Multiplying by a
+// 2/pi of 106 bits would leave only 106 - log2(a) correct bits, so a long 2/pi is used with integers.
+static DoubleDouble reduce_half_pi(DoubleDouble a, s32& quadrant)
+{
+    s64 limbs[REDUCTION_LIMBS] = {};
+    add_times_two_over_pi(limbs, a.hi);
+    add_times_two_over_pi(limbs, a.lo);
+
+    for (u32 i = REDUCTION_LIMBS - 1; i > 0; i--)
+    {
+        const s64 low = limbs[i] & LIMB_MASK;
+        limbs[i - 1] += (limbs[i] - low) / (LIMB_MASK + 1);
+        limbs[i] = low;
+    }
+
+    quadrant = (s32) (limbs[0] & 3);
+
+    // Round to the nearest quadrant, the fraction becomes -(1 - fraction)
+    const bool negative = (limbs[1] & 0x800000) != 0;
+    if (negative)
+    {
+        quadrant = (quadrant + 1) & 3;
+
+        s64 carry = 1;
+        for (u32 i = REDUCTION_LIMBS - 1; i > 0; i--)
+        {
+            limbs[i] = (LIMB_MASK - limbs[i]) + carry;
+            carry = limbs[i] >> 24;
+            limbs[i] &= LIMB_MASK;
+        }
+    }
+
+    DoubleDouble fraction = {};
+    for (u32 i = 1; i < REDUCTION_LIMBS; i++)
+        fraction = fraction + make_double_double(ldexp((f64) limbs[i], -24 * (s32) i));
+
+    const DoubleDouble r = fraction * DD_HALF_PI;
+    return negative ? -r : r;
+}
+
+static void dd_sin_cos(DoubleDouble a, DoubleDouble& sin_a, DoubleDouble& cos_a)
+{
+    if (!std::isfinite(a.hi))
+    {
+        sin_a = cos_a = make_double_double(NAN);
+        return;
+    }
+
+    // Reduce to [-pi/4, pi/4] remembering the quadrant
+    s32 quadrant = 0;
+    DoubleDouble r = a;
+    if (fabs(a.hi) > DD_HALF_PI.hi * 0.5)
+        r = reduce_half_pi(a, quadrant);
+
+    const DoubleDouble r2 = -(r * r);
+
+    DoubleDouble s = r;
+    DoubleDouble term = r;
+    for (f64 n = 2.0; n < 60.0; n += 2.0)
+    {
+        term = term * r2 / make_double_double(n * (n + 1.0));
+        s = s + term;
+
+        if (fabs(term.hi) <= DD_EPSILON * fabs(s.hi))
+            break;
+    }
+
+    DoubleDouble c = DD_ONE;
+    term = DD_ONE;
+    for (f64 n = 1.0; n < 60.0; n += 2.0)
+    {
+        term = term * r2 / make_double_double(n * (n + 1.0));
+        c = c + term;
+
+        if (fabs(term.hi) <= DD_EPSILON * fabs(c.hi))
+            break;
+    }
+
+    switch (quadrant)
+    {
+        case 0:  { sin_a =  s; cos_a =  c; } break;
+        case 1:  { sin_a =  c; cos_a = -s; } break;
+        case 2:  { sin_a = -s; cos_a = -c; } break;
+        default: { sin_a = -c; cos_a =  s; } break;    // Quadrant 3
+    }
+}
+
+static DoubleDouble dd_sinh(DoubleDouble a)
+{
+    // e^a - e^-a loses the precision of small values
+    if (fabs(a.hi) < 0.05)
+    {
+        const DoubleDouble a2 = a * a;
+
+        DoubleDouble sum  = a;
+        DoubleDouble term = a;
+        for (f64 n = 2.0; n < 30.0; n += 2.0)
+        {
+            term = term * a2 / make_double_double(n * (n + 1.0));
+            sum = sum + term;
+
+            if (fabs(term.hi) <= DD_EPSILON * fabs(sum.hi))
+                break;
+        }
+
+        return sum;
+    }
+
+    const DoubleDouble e = dd_exp(a);
+    return (e - DD_ONE / e) * 0.5;
+}
+
+static DoubleDouble dd_cosh(DoubleDouble a)
+{
+    const DoubleDouble e = dd_exp(a);
+    return (e + DD_ONE / e) * 0.5;
+}
+
+static DoubleDouble dd_tanh(DoubleDouble a)
+{
+    if (fabs(a.hi) > 40.0)
+        return make_double_double((a.hi > 0.0) ? 1.0 : -1.0);
+
+    return dd_sinh(a) / dd_cosh(a);
+}
+
+static DoubleDouble dd_pow(DoubleDouble a, DoubleDouble b)
+{
+    if (a.hi == 0.0)
+        return make_double_double(pow(a.hi, b.hi));
+
+    // Integer powers by repeated squaring
+    if (b.lo == 0.0 && b.hi == floor(b.hi) && fabs(b.hi) < 2147483648.0)
+    {
+        const s64 n = (s64) b.hi;
+        u64 m = (n < 0) ? -n : n;
+
+        DoubleDouble result = DD_ONE;
+        DoubleDouble base = a;
+
+        while (m)
+        {
+            if (m & 1)
+                result = result * base;
+
+            base = base * base;
+            m >>= 1;
+        }
+
+        return (n < 0) ? DD_ONE / result : result;
+    }
+
+    if (a.hi < 0.0)
+        return make_double_double(NAN);
+
+    return dd_exp(b * dd_log(a));
+}
+
+static DoubleDouble dd_fmod(DoubleDouble a, DoubleDouble b)
+{
+    return a - dd_trunc(a / b) * b;
+}
+
+DoubleDouble double_double_from_f64(f64 value)
+{
+    if (!std::isfinite(value) || value == 0.0)
+        return make_double_double(value);
+
+    char buffer[32];
+    to_shortest_chars(value, buffer, sizeof(buffer));
+
+    return double_double_from_string(buffer);
+}
+
+DoubleDouble double_double_pi()
+{
+    return DD_PI;
+}
+
+DoubleDouble double_double_e()
+{
+    return DD_E;
+}
+
+DoubleDouble double_double_from_string(const char* str)
+{
+    // Values that don't fit are handled by strtod (infinity, zero and denormals)
+    const f64 approximate = strtod(str, nullptr);
+    if (!std::isfinite(approximate) || fabs(approximate) < 1e-290)
+        return make_double_double(approximate);
+
+    bool negative = false;
+    if (*str == '-' || *str == '+')
+        negative = (*str++ == '-');
+
+    DoubleDouble value = make_double_double(0.0);
+    s32 exponent = 0;
+    u32 digit_count = 0;
+    bool after_point = false;
+
+    for (; (*str >= '0' && *str <= '9') || *str == '.'; str++)
+    {
+        if (*str == '.')
+        {
+            after_point = true;
+            continue;
+        }
+
+        // Digits past the precision only move the point
+        if (digit_count < 34)
+        {
+            value = value * 10.0 + make_double_double((f64) (*str - '0'));
+            digit_count += (digit_count > 0 || *str != '0');
+            exponent -= after_point;
+        }
+        else
+        {
+            exponent += !after_point;
+        }
+    }
+
+    if (*str == 'e' || *str == 'E')
+        exponent += atoi(str + 1);
+
+    if (exponent > 0)
+        value = value * dd_pow10(exponent);
+    else if (exponent < 0)
+        value = value / dd_pow10(-exponent);
+
+    return negative ? -value : value;
+}
+
+u64 to_chars(DoubleDouble value, char buffer[], u64 buffer_size)
+{
+    if (!std::isfinite(value.hi) || value.hi == 0.0)
+        return to_shortest_chars(value.hi, buffer, buffer_size);
+
+    constexpr u32 DIGIT_COUNT = 32;
+
+    const bool negative = (value.hi < 0.0);
+    if (negative)
+        value = -value;
+
+    // Scale to [1, 10)
+    s32 exponent = (s32) floor(log10(value.hi));
+    if (exponent < -300)
+        value = value * 1e300 * dd_pow10(-exponent - 300);
+    else
+        value = (exponent >= 0) ? value / dd_pow10(exponent) : value * dd_pow10(-exponent);
+
+    if (value.hi >= 10.0)
+    {
+        value = value / make_double_double(10.0);
+        exponent++;
+    }
+    else if (value.hi < 1.0)
+    {
+        value = value * 10.0;
+        exponent--;
+    }
+
+    // One extra digit for rounding
+    u8 digits[DIGIT_COUNT + 1];
+    for (u32 i = 0; i <= DIGIT_COUNT; i++)
+    {
+        f64 digit = floor(value.hi);
+        value = value - make_double_double(digit);
+
+        // The high part can be an integer with a negative low part
+        if (value.hi < 0.0)
+        {
+            digit--;
+            value = value + DD_ONE;
+        }
+
+        digits[i] = (u8) clamp(digit, 0.0, 9.0);
+        value = value * 10.0;
+    }
+
+    u32 count = DIGIT_COUNT;
+    if (digits[DIGIT_COUNT] >= 5)
+    {
+        s32 i = DIGIT_COUNT - 1;
+        while (i >= 0 && digits[i] == 9)
+            digits[i--] = 0;
+
+        if (i >= 0)
+        {
+            digits[i]++;
+        }
+        else
+        {
+            digits[0] = 1;
+            exponent++;
+        }
+    }
+
+    while (count > 1 && digits[count - 1] == 0)
+        count--;
+
+    return format_digits(digits, count, exponent, negative, buffer, buffer_size);
+}
+
+DoubleDouble apply_operator(const Operator& op, const DoubleDouble operands[])
+{
+    const DoubleDouble a = operands[0];
+    const DoubleDouble b = (op.operand_count > 1) ? operands[1] : a;
+
+    // Infinities and NaNs follow the f64 rules, the error free transformations don't work with them
+    bool all_finite = true;
+    for (u32 i = 0; i < op.operand_count; i++)
+        all_finite = all_finite && std::isfinite(operands[i].hi);
+
+    f64 his[3];     // Max operand count in functions is 3
+    for (u32 i = 0; i < op.operand_count; i++)
+        his[i] = operands[i].hi;
+
+    if (!all_finite && op.code != OperatorCode::COND)
+        return make_double_double(op.operation(his));
+
+    DoubleDouble result;
+
+    switch (op.code)
+    {
+        case OperatorCode::NEG:           result = -a; break;
+        case OperatorCode::MULTIPLY:      result = a * b; break;
+        case OperatorCode::DIVIDE:        result = (b.hi != 0.0) ? a / b : make_double_double(a.hi / b.hi); break;
+        case OperatorCode::REMAINDER:     result = (b.hi != 0.0) ? dd_fmod(a, b) : make_double_double(NAN); break;
+        case OperatorCode::ADD:           result = a + b; break;
+        case OperatorCode::SUBTRACT:      result = a - b; break;
+        case OperatorCode::POW:           result = dd_pow(a, b); break;
+        case OperatorCode::AND:           result = make_double_double(is_true(a) && is_true(b)); break;
+        case OperatorCode::OR:            result = make_double_double(is_true(a) || is_true(b)); break;
+        case OperatorCode::NOT:           result = make_double_double(!is_true(a)); break;
+        case OperatorCode::GREATER:       result = make_double_double(a > b); break;
+        case OperatorCode::LESSER:        result = make_double_double(a < b); break;
+        case OperatorCode::GREATER_EQUAL: result = make_double_double(a >= b); break;
+        case OperatorCode::LESSER_EQUAL:  result = make_double_double(a <= b); break;
+        case OperatorCode::EQUAL:         result = make_double_double(a == b); break;
+        case OperatorCode::NOT_EQUAL:     result = make_double_double(a != b); break;
+        case OperatorCode::NATURAL_LOG:   result = dd_log(a); break;
+        case OperatorCode::LOG:           result = dd_log(b) / dd_log(a); break;
+        case OperatorCode::SQRT:          result = dd_sqrt(a); break;
+        case OperatorCode::EXP:           result = dd_exp(a); break;
+        case OperatorCode::SINH:          result = dd_sinh(a); break;
+        case OperatorCode::COSH:          result = dd_cosh(a); break;
+        case OperatorCode::TANH:          result = dd_tanh(a); break;
+        case OperatorCode::MAX:           result = (a > b) ? a : b; break;
+        case OperatorCode::MIN:           result = (a < b) ? a : b; break;
+        case OperatorCode::COND:          result = is_true(a) ? operands[1] : operands[2]; break;
+
+        case OperatorCode::SIN:
+        case OperatorCode::COS:
+        case OperatorCode::TAN:
+        case OperatorCode::SEC:
+        case OperatorCode::COSEC:
+        case OperatorCode::COT:
+        {
+            DoubleDouble s, c;
+            dd_sin_cos(a, s, c);
+
+            switch (op.code)
+            {
+                case OperatorCode::SIN:   result = s; break;
+                case OperatorCode::COS:   result = c; break;
+                case OperatorCode::TAN:   result = s / c; break;
+                case OperatorCode::SEC:   result = DD_ONE / c; break;
+                case OperatorCode::COSEC: result = DD_ONE / s; break;
+                case OperatorCode::COT:   result = c / s; break;
+            }
+        } break;
+
+        default:
+        {
+            gn_assert_with_message(false, "Operator doesn't have a double-double implementation! (code: %)", (u32) op.code);
+            result = make_double_double(op.operation(his));
+        } break;
+    }
+
+    // Overflow turns the low part into NaN, the f64 result has the right infinity
+    if (!std::isfinite(result.hi) || result.lo != result.lo)
+        return make_double_double(op.operation(his));
+
+    return result;
+}
+
+} // namespace Calculator
+
+template <>
+void print_to_file(FILE* file, const Calculator::DoubleDouble& value)
+{
+    char buffer[64];
+    Calculator::to_chars(value, buffer, sizeof(buffer));
+    print_to_file(file, buffer);
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cmath>
+#include "core/types.h"
+#include "math/common.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Unevaluated sum of two doubles (hi + lo, |lo| <= ulp(hi) / 2) giving about 106 bits of precision
+struct DoubleDouble
+{
+    f64 hi;
+    f64 lo;
+};
+
+// Error free transformations, the rounding error of the f64 operation ends up in err
+
+inline DoubleDouble quick_two_sum(f64 a, f64 b)    // Only valid when |a| >= |b|
+{
+    const f64 sum = a + b;
+    return DoubleDouble { sum, b - (sum - a) };
+}
+
+inline DoubleDouble two_sum(f64 a, f64 b)
+{
+    const f64 sum = a + b;
+    const f64 v   = sum - a;
+    return DoubleDouble { sum, (a - (sum - v)) + (b - v) };
+}
+
+#if !defined(__FMA__) && !defined(__AVX2__)
+// Splits the value into two halves of 26 bits that can be multiplied exactly (Dekker's split).
+// Values above 2^996 are scaled down first, 2^27 times them would overflow.
+inline void split(f64 a, f64& hi, f64& lo)
+{
+    constexpr f64 SPLITTER        = 134217729.0;            // 2^27 + 1
+    constexpr f64 SPLIT_THRESHOLD = 6.69692879491417e+299;  // 2^996
+
+    const bool is_large = (a > SPLIT_THRESHOLD || a < -SPLIT_THRESHOLD);
+    if (is_large)
+        a *= 3.7252902984619140625e-09;                     // 2^-28
+
+    const f64 t = SPLITTER * a;
+    hi = t - (t - a);
+    lo = a - hi;
+
+    if (is_large)
+    {
+        hi *= 268435456.0;                                  // 2^28
+        lo *= 268435456.0;
+    }
+}
+#endif
+
+inline DoubleDouble two_prod(f64 a, f64 b)
+{
+    const f64 product = a * b;
+
+    // The error of a product that overflowed would be inf - inf
+    if (!std::isfinite(product))
+        return DoubleDouble { product, 0.0 };
+
+#if defined(__FMA__) || defined(__AVX2__)
+    return DoubleDouble { product, fma(a, b, -product) };
+#else
+    // Near the overflow limit a_hi * b_hi can round up to inf, so the product is computed 2^28 times smaller
+    constexpr f64 SPLIT_THRESHOLD = 6.69692879491417e+299;  // 2^996
+    const bool is_large = (product > SPLIT_THRESHOLD || product < -SPLIT_THRESHOLD);
+    if (is_large)
+        a *= 3.7252902984619140625e-09;                     // 2^-28
+
+    const f64 scaled_product = a * b;
+
+    f64 a_hi, a_lo, b_hi, b_lo;
+    split(a, a_hi, a_lo);
+    split(b, b_hi, b_lo);
+
+    const f64 error = ((a_hi * b_hi - scaled_product) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+    return DoubleDouble { product, is_large ? error * 268435456.0 : error };
+#endif
+}
+
+inline DoubleDouble make_double_double(f64 value)
+{
+    return DoubleDouble { value, 0.0 };
+}
+
+inline DoubleDouble operator-(DoubleDouble a)
+{
+    return DoubleDouble { -a.hi, -a.lo };
+}
+
+inline DoubleDouble operator+(DoubleDouble a, DoubleDouble b)
+{
+    DoubleDouble s = two_sum(a.hi, b.hi);
+    const DoubleDouble t = two_sum(a.lo, b.lo);
+
+    s.lo += t.hi;
+    s = quick_two_sum(s.hi, s.lo);
+    s.lo += t.lo;
+
+    return quick_two_sum(s.hi, s.lo);
+}
+
+inline DoubleDouble operator-(DoubleDouble a, DoubleDouble b)
+{
+    return a + (-b);
+}
+
+inline DoubleDouble operator*(DoubleDouble a, DoubleDouble b)
+{
+    DoubleDouble p = two_prod(a.hi, b.hi);
+    p.lo += a.hi * b.lo + a.lo * b.hi;
+
+    return quick_two_sum(p.hi, p.lo);
+}
+
+inline DoubleDouble operator*(DoubleDouble a, f64 b)
+{
+    DoubleDouble p = two_prod(a.hi, b);
+    p.lo += a.lo * b;
+
+    return quick_two_sum(p.hi, p.lo);
+}
+
+inline DoubleDouble operator/(DoubleDouble a, DoubleDouble b)
+{
+    // Long division, each step gets about 53 more bits of the quotient
+    const f64 q1 = a.hi / b.hi;
+    DoubleDouble r = a - b * q1;
+
+    const f64 q2 = r.hi / b.hi;
+    r = r - b * q2;
+
+    const f64 q3 = r.hi / b.hi;
+
+    const DoubleDouble q = quick_two_sum(q1, q2);
+    return q + make_double_double(q3);
+}
+
+inline bool operator==(DoubleDouble a, DoubleDouble b) { return a.hi == b.hi && a.lo == b.lo; }
+inline bool operator!=(DoubleDouble a, DoubleDouble b) { return !(a == b); }
+inline bool operator< (DoubleDouble a, DoubleDouble b) { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); }
+inline bool operator> (DoubleDouble a, DoubleDouble b) { return b < a; }
+inline bool operator<=(DoubleDouble a, DoubleDouble b) { return a < b || a == b; }
+inline bool operator>=(DoubleDouble a, DoubleDouble b) { return b < a || a == b; }
+
+// Converts the number through its shortest decimal representation, so 0.1 becomes 0.1 instead of
+// the f64 closest to 0.1
+DoubleDouble double_double_from_f64(f64 value);
+
+// Parses a decimal number (digits, an optional point and an optional exponent)
+DoubleDouble double_double_from_string(const char* str);
+
+DoubleDouble double_double_pi();
+DoubleDouble double_double_e();
+
+// Writes up to 32 significant digits, returns the number of characters written
+u64 to_chars(DoubleDouble value, char buffer[], u64 buffer_size);
+
+// Solves the operator the same way as opdef.h does, but with double-double precision
+DoubleDouble apply_operator(const Operator& op, const DoubleDouble operands[]);
+
+} // namespace Calculator
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+enum struct ErrorCode : u32
+{
+    NONE,
+    UNBALANCED_BRACKETS,
+    INVALID_NUMBER,     // A point without digits
+    MISSING_OPERAND,    // Operator (or function call) without enough operands
+    EXTRA_VALUES,       // Values left over that no operator uses
+    EMPTY_EXPRESSION,
+    UNKNOWN_SYMBOL,     // Characters that aren't a number, keyword, variable or user function
+    TOO_LARGE,          // Inlining a user function call grew the expression too much (see USER_FUNCTION_MAX_GROWTH)
+    BUFFER_FULL,        // Caller owned buffers are too small for the expression
+};
+
+// Why an expression couldn't be tokenized or solved. Tokenizer errors have the byte offset into the
+// expression, solver errors have the index of the postfix element. Filled in only on the error path,
+// so it can be passed along with every expression for free.
+struct ExpressionError
+{
+    ErrorCode code;
+    u32 offset;
+    OperatorCode op;    // Operator the error is for, COUNT if there is none (or it's a user function)
+};
+
+inline const char* error_message(ErrorCode code)
+{
+    switch (code)
+    {
+        case ErrorCode::NONE:                return "no error";
+        case ErrorCode::UNBALANCED_BRACKETS: return "unbalanced brackets";
+        case ErrorCode::INVALID_NUMBER:      return "invalid number";
+        case ErrorCode::MISSING_OPERAND:     return "missing operand";
+        case ErrorCode::EXTRA_VALUES:        return "value without an operator";
+        case ErrorCode::EMPTY_EXPRESSION:    return "empty expression";
+        case ErrorCode::UNKNOWN_SYMBOL:      return "unknown symbol";
+        case ErrorCode::TOO_LARGE:           return "expression is too large after inlining functions";
+        case ErrorCode::BUFFER_FULL:         return "expression doesn't fit in the buffers";
+    }
+
+    return "unknown error";
+}
+
+} // namespace Calculator
@@ -0,0 +1,303 @@
+#include "expression_cache.h"
+
+#include <atomic>
+#include <cstring>
+#include "containers/darray.h"
+#include "containers/hash.h"
+#include "containers/string.h"
+#include "core/types.h"
+#include "platform/platform.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+constexpr u32 NO_ENTRY = 0xFFFFFFFF;
+
+inline static void lock(ExpressionCache& cache)
+{
+    while (cache.lock.test_and_set(std::memory_order_acquire))
+        platform_yield_thread();
+}
+
+inline static void unlock(ExpressionCache& cache)
+{
+    cache.lock.clear(std::memory_order_release);
+}
+
+// Counts the buckets too, there are at least two per entry
+inline static u64 entry_memory(u64 key_size, u64 element_count)
+{
+    return sizeof(CacheEntry) + 2 * sizeof(u32) + key_size + element_count * sizeof(ExpressionElement);
+}
+
+void init_expression_cache(ExpressionCache& cache, u64 memory_cap)
+{
+    cache.entries = make<DynamicArray<CacheEntry>>(64Ui64);
+    cache.buckets = make<DynamicArray<u32>>(128Ui64);
+    cache.buckets.size = cache.buckets.capacity;
+    memset(cache.buckets.data, 0xFF, cache.buckets.size * sizeof(u32));
+
+    cache.newest = cache.oldest = cache.free_list = NO_ENTRY;
+
+    cache.memory_used = 0;
+    cache.memory_cap = memory_cap;
+
+    cache.hit_count = cache.miss_count = cache.eviction_count = 0;
+    cache.lock.clear();
+}
+
+void free(ExpressionCache& cache)
+{
+    for (u64 i = 0; i < cache.entries.size; i++)
+    {
+        CacheEntry& entry = cache.entries[i];
+        if (!entry.key.data)
+            continue;
+
+        free(entry.elements);
+        free(entry.key);
+    }
+
+    free(cache.buckets);
+    free(cache.entries);
+}
+
+// Brackets and commas are tokens of their own, whitespace next to them never changes the tokens
+inline static bool is_separator(char ch)
+{
+    return ch == '(' || ch == ')' || ch == ',';
+}
+
+inline static bool is_whitespace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+void normalize_expression(const String expression, DynamicArray<char>& normalized)
+{
+    clear(normalized);
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        if (!is_whitespace(expression.data[i]))
+        {
+            append(normalized, expression.data[i]);
+            continue;
+        }
+
+        // Whitespace between any other characters can split a token ("1 = = 2" isn't "1==2", "1e +2" isn't "1e+2"),
+        // so it is kept as a single space
+        u64 next = i;
+        while (next < expression.size && is_whitespace(expression.data[next]))
+            next++;
+
+        if (normalized.size > 0 && next < expression.size &&
+            !is_separator(normalized[normalized.size - 1]) && !is_separator(expression.data[next]))
+            append(normalized, ' ');
+
+        i = next - 1;
+    }
+
+    // Hashing reads whole words, keep the bytes after the end readable
+    if (normalized.capacity < normalized.size + sizeof(Hash))
+        resize(normalized, normalized.size + sizeof(Hash));
+}
+
+static u64 find_bucket(const ExpressionCache& cache, const String key, Hash hash)
+{
+    const u64 mask = cache.buckets.size - 1;
+    u64 bucket = hash & mask;
+
+    while (cache.buckets[bucket] != NO_ENTRY)
+    {
+        const CacheEntry& entry = cache.entries[cache.buckets[bucket]];
+        if (entry.hash == hash && entry.key == key)
+            break;
+
+        bucket = (bucket + 1) & mask;
+    }
+
+    return bucket;
+}
+
+static void grow_buckets(ExpressionCache& cache)
+{
+    const u64 capacity = cache.buckets.size * 2;
+
+    free(cache.buckets);
+    cache.buckets = make<DynamicArray<u32>>(capacity);
+    cache.buckets.size = capacity;
+    memset(cache.buckets.data, 0xFF, capacity * sizeof(u32));
+
+    for (u32 i = 0; i < cache.entries.size; i++)
+    {
+        if (!cache.entries[i].key.data)
+            continue;
+
+        u64 bucket = cache.entries[i].hash & (capacity - 1);
+        while (cache.buckets[bucket] != NO_ENTRY)
+            bucket = (bucket + 1) & (capacity - 1);
+
+        cache.buckets[bucket] = i;
+    }
+}
+
+// Shifts the entries after the bucket back so lookups don't need tombstones
+static void remove_bucket(ExpressionCache& cache, u64 bucket)
+{
+    const u64 mask = cache.buckets.size - 1;
+    u64 next = bucket;
+
+    while (true)
+    {
+        next = (next + 1) & mask;
+        if (cache.buckets[next] == NO_ENTRY)
+            break;
+
+        // Entries whose home bucket is between the hole and their bucket have to stay where they are
+        const u64 home = cache.entries[cache.buckets[next]].hash & mask;
+        const bool stays = (bucket <= next) ? (bucket < home && home <= next) : (bucket < home || home <= next);
+        if (stays)
+            continue;
+
+        cache.buckets[bucket] = cache.buckets[next];
+        bucket = next;
+    }
+
+    cache.buckets[bucket] = NO_ENTRY;
+}
+
+static void unlink_entry(ExpressionCache& cache, u32 index)
+{
+    CacheEntry& entry = cache.entries[index];
+
+    if (entry.newer != NO_ENTRY)
+        cache.entries[entry.newer].older = entry.older;
+    else
+        cache.newest = entry.older;
+
+    if (entry.older != NO_ENTRY)
+        cache.entries[entry.older].newer = entry.newer;
+    else
+        cache.oldest = entry.newer;
+}
+
+static void link_newest(ExpressionCache& cache, u32 index)
+{
+    CacheEntry& entry = cache.entries[index];
+    entry.newer = NO_ENTRY;
+    entry.older = cache.newest;
+
+    if (cache.newest != NO_ENTRY)
+        cache.entries[cache.newest].newer = index;
+    else
+        cache.oldest = index;
+
+    cache.newest = index;
+}
+
+static void evict_oldest(ExpressionCache& cache)
+{
+    const u32 index = cache.oldest;
+    CacheEntry& entry = cache.entries[index];
+
+    remove_bucket(cache, find_bucket(cache, entry.key, entry.hash));
+    unlink_entry(cache, index);
+
+    cache.memory_used -= entry_memory(entry.key.size, entry.elements.size);
+    cache.eviction_count++;
+
+    free(entry.elements);
+    free(entry.key);
+
+    // Free entries are chained through older
+    entry.older = cache.free_list;
+    cache.free_list = index;
+}
+
+static void insert_entry(ExpressionCache& cache, const String key, Hash hash, const DynamicArray<ExpressionElement>& elements, bool valid)
+{
+    // Empty keys can't be told apart from free entries
+    const u64 memory = entry_memory(key.size, elements.size);
+    if (key.size == 0 || memory > cache.memory_cap)
+        return;
+
+    while (cache.oldest != NO_ENTRY && cache.memory_used + memory > cache.memory_cap)
+        evict_oldest(cache);
+
+    u32 index = cache.free_list;
+    if (index != NO_ENTRY)
+    {
+        cache.free_list = cache.entries[index].older;
+    }
+    else
+    {
+        index = (u32) cache.entries.size;
+        append(cache.entries, CacheEntry {});
+
+        // Keep the load factor under 1/2
+        if (cache.entries.size * 2 > cache.buckets.size)
+            grow_buckets(cache);
+    }
+
+    CacheEntry& entry = cache.entries[index];
+    entry.key = copy(key);
+    entry.elements = make<DynamicArray<ExpressionElement>>(max(elements.size, 1Ui64));
+    append_many(entry.elements, elements.data, elements.size);
+    entry.hash = hash;
+    entry.valid = valid;
+
+    cache.buckets[find_bucket(cache, key, hash)] = index;
+    link_newest(cache, index);
+
+    cache.memory_used += memory;
+}
+
+bool cached_infix_to_postfix(ExpressionCache& cache, const String expression, DynamicArray<ExpressionElement>& elements,
+                             DynamicArray<OperatorOrBracket>& op_stack, DynamicArray<char>& normalized)
+{
+    normalize_expression(expression, normalized);
+
+    const String key = ref(normalized.data, normalized.size);
+    const Hash hash = Hasher<String>()(key);
+
+    lock(cache);
+
+    const u32 index = cache.buckets[find_bucket(cache, key, hash)];
+    if (index != NO_ENTRY)
+    {
+        CacheEntry& entry = cache.entries[index];
+
+        // The elements are copied out so other threads can evict the entry while they are used
+        clear(elements);
+        append_many(elements, entry.elements.data, entry.elements.size);
+        const bool valid = entry.valid;
+
+        unlink_entry(cache, index);
+        link_newest(cache, index);
+        cache.hit_count++;
+
+        unlock(cache);
+        return valid;
+    }
+
+    cache.miss_count++;
+    unlock(cache);
+
+    // Tokenized outside the lock so other threads aren't held up
+    const bool valid = infix_expression_to_postfix(expression, elements, op_stack);
+    if (!valid)
+        clear(elements);
+
+    lock(cache);
+
+    // Another thread might have added it in the meantime
+    if (cache.buckets[find_bucket(cache, key, hash)] == NO_ENTRY)
+        insert_entry(cache, key, hash, elements, valid);
+
+    unlock(cache);
+    return valid;
+}
+
+} // namespace Calculator
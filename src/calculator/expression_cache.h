@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include "containers/darray.h"
+#include "containers/hash.h"
+#include "containers/string.h"
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+struct CacheEntry
+{
+    String key;                                 // Normalized expression
+    DynamicArray<ExpressionElement> elements;   // Postfix, empty if the expression couldn't be parsed
+    Hash hash;
+    bool valid;
+
+    u32 newer;  // Least recently used list
+    u32 older;
+};
+
+// Postfix expressions keyed by their whitespace normalized text. Once the memory used goes over the
+// cap the least recently used expressions are evicted. Can be shared between threads.
+struct ExpressionCache
+{
+    DynamicArray<CacheEntry> entries;   // Evicted entries are reused
+    DynamicArray<u32> buckets;          // Size is a power of 2
+    u32 newest;
+    u32 oldest;
+    u32 free_list;
+
+    u64 memory_used;
+    u64 memory_cap;
+
+    u64 hit_count;
+    u64 miss_count;
+    u64 eviction_count;
+
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+};
+
+void init_expression_cache(ExpressionCache& cache, u64 memory_cap);
+void free(ExpressionCache& cache);
+
+// Removes the whitespace next to brackets and commas and turns the rest into a single space,
+// so "sin (x)  +  max( 1 , y )" and "sin(x) + max(1,y)" share an entry
+void normalize_expression(const String expression, DynamicArray<char>& normalized);
+
+// Same as infix_expression_to_postfix, but the expression is only tokenized
+// if it isn't in the cache. Expressions that can't be parsed are cached as well.
+bool cached_infix_to_postfix(ExpressionCache& cache, const String expression, DynamicArray<ExpressionElement>& elements,
+                             DynamicArray<OperatorOrBracket>& op_stack, DynamicArray<char>& normalized);
+
+} // namespace Calculator
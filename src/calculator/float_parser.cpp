@@ -0,0 +1,360 @@
+#include "float_parser.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "core/types.h"
+#include "platform/platform.h"
+
+#if defined(GN_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+namespace Calculator
+{
+
+#include "powers_of_five.inl"
+
+constexpr s32 SMALLEST_POWER_OF_TEN = -342;    // Anything smaller rounds to 0
+constexpr s32 LARGEST_POWER_OF_TEN  = 308;     // Anything larger rounds to infinity
+
+constexpr u32 MAX_MANTISSA_DIGITS = 19;        // Fits in a u64
+constexpr u64 MANTISSA_BITS = 52;
+
+static constexpr f64 exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static constexpr u64 integer_powers_of_ten[] = {
+    1Ui64, 10Ui64, 100Ui64, 1000Ui64, 10000Ui64, 100000Ui64, 1000000Ui64, 10000000Ui64,
+    100000000Ui64, 1000000000Ui64, 10000000000Ui64, 100000000000Ui64, 1000000000000Ui64,
+    10000000000000Ui64, 100000000000000Ui64, 1000000000000000Ui64, 10000000000000000Ui64,
+};
+
+inline static bool is_digit(char ch)
+{
+    return (ch >= '0') && (ch <= '9');
+}
+
+// Returns 16 if the character isn't a hex digit
+inline static u32 hex_digit_value(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+
+    ch |= 0x20;     // Lower case
+    if (ch >= 'a' && ch <= 'f')
+        return ch - 'a' + 10;
+
+    return 16;
+}
+
+inline static u64 multiply_full(u64 a, u64 b, u64& low)
+{
+#if defined(GN_COMPILER_MSVC)
+    u64 high;
+    low = _umul128(a, b, &high);
+    return high;
+#else
+    const unsigned __int128 product = (unsigned __int128) a * b;
+    low = (u64) product;
+    return (u64) (product >> 64);
+#endif
+}
+
+inline static u32 leading_zeros(u64 value)
+{
+#if defined(GN_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return 63 - index;
+#else
+    return __builtin_clzll(value);
+#endif
+}
+
+inline static f64 f64_from_bits(u64 bits)
+{
+    f64 value;
+    memcpy(&value, &bits, sizeof(f64));
+    return value;
+}
+
+// Eisel-Lemire: rounds mantissa * 10^exponent using a 128 bit approximation of the power of ten.
+// Returns the bits of the f64, the mantissa shouldn't be 0.
+static u64 eisel_lemire(u64 mantissa, s64 exponent)
+{
+    if (exponent < SMALLEST_POWER_OF_TEN)
+        return 0;
+
+    if (exponent > LARGEST_POWER_OF_TEN)
+        return 0x7FFUi64 << MANTISSA_BITS;
+
+    const u32 zeros = leading_zeros(mantissa);
+    mantissa <<= zeros;
+
+    const u64* power = powers_of_five + 2 * (exponent - SMALLEST_POWER_OF_TEN);
+
+    u64 low;
+    u64 high = multiply_full(mantissa, power[0], low);
+
+    // Only look at the lower half of the power if the bits below the rounding bit could change
+    constexpr u64 precision_mask = 0xFFFFFFFFFFFFFFFFUi64 >> (MANTISSA_BITS + 3);
+    if ((high & precision_mask) == precision_mask)
+    {
+        u64 second_low;
+        const u64 second_high = multiply_full(mantissa, power[1], second_low);
+
+        low += second_high;
+        high += (second_high > low);
+    }
+
+    const u64 upper_bit = high >> 63;
+    const u64 shift = upper_bit + 64 - MANTISSA_BITS - 3;
+
+    u64 result = high >> shift;
+
+    // floor(log2(10^exponent)) + 63 + 1023
+    s64 power2 = (((152170 + 65536) * exponent) >> 16) + 63 + (s64) upper_bit - zeros + 1023;
+
+    if (power2 <= 0)
+    {
+        // Subnormal
+        if (-power2 + 1 >= 64)
+            return 0;
+
+        result >>= -power2 + 1;
+        result += (result & 1);
+        result >>= 1;
+
+        // Rounding up can make it a normal number
+        power2 = (result < (1Ui64 << MANTISSA_BITS)) ? 0 : 1;
+        return (result & ~(1Ui64 << MANTISSA_BITS)) | ((u64) power2 << MANTISSA_BITS);
+    }
+
+    // Exactly halfway between two numbers rounds to even, this can only happen for small exponents
+    if (low <= 1 && exponent >= -4 && exponent <= 23 && (result & 3) == 1 && (result << shift) == high)
+        result &= ~1Ui64;
+
+    result += (result & 1);
+    result >>= 1;
+
+    if (result >= (2Ui64 << MANTISSA_BITS))
+    {
+        result = 1Ui64 << MANTISSA_BITS;
+        power2++;
+    }
+
+    if (power2 >= 0x7FF)
+        return 0x7FFUi64 << MANTISSA_BITS;
+
+    return (result & ~(1Ui64 << MANTISSA_BITS)) | ((u64) power2 << MANTISSA_BITS);
+}
+
+// Used for the rare numbers that can't be rounded from the first 19 digits
+static f64 parse_with_strtod(const char* str, u64 size)
+{
+    char buffer[512];
+    char* copy = (size < sizeof(buffer)) ? buffer : (char*) platform_allocate(size + 1);
+
+    memcpy(copy, str, size);
+    copy[size] = '\0';
+
+    const f64 value = strtod(copy, nullptr);
+
+    if (copy != buffer)
+        platform_free(copy);
+
+    return value;
+}
+
+static u64 parse_hex(const char* str, u64 size, f64& value)
+{
+    u64 index = 2;  // Skip "0x"
+    u64 mantissa = 0;
+    s64 exponent = 0;
+    bool has_digits = false;
+    bool truncated = false;
+    bool in_fraction = false;
+
+    for (; index < size; index++)
+    {
+        if (str[index] == '.' && !in_fraction)
+        {
+            in_fraction = true;
+            continue;
+        }
+
+        const u32 digit = hex_digit_value(str[index]);
+        if (digit >= 16)
+            break;
+
+        has_digits = true;
+
+        // Digits that don't fit only matter for rounding
+        if ((mantissa >> 60) == 0)
+        {
+            mantissa = (mantissa << 4) | digit;
+            exponent -= in_fraction ? 4 : 0;
+        }
+        else
+        {
+            truncated |= (digit != 0);
+            exponent += in_fraction ? 0 : 4;
+        }
+    }
+
+    if (!has_digits)
+        return 0;
+
+    // Binary exponent
+    if (index + 1 < size && (str[index] | 0x20) == 'p')
+    {
+        u64 exponent_index = index + 1;
+        const bool negative = str[exponent_index] == '-';
+        exponent_index += (str[exponent_index] == '-' || str[exponent_index] == '+');
+
+        if (exponent_index < size && is_digit(str[exponent_index]))
+        {
+            s64 binary_exponent = 0;
+            for (; exponent_index < size && is_digit(str[exponent_index]); exponent_index++)
+            {
+                if (binary_exponent < 100000)
+                    binary_exponent = binary_exponent * 10 + (str[exponent_index] - '0');
+            }
+
+            exponent += negative ? -binary_exponent : binary_exponent;
+            index = exponent_index;
+        }
+    }
+
+    if (mantissa == 0)
+    {
+        value = 0.0;
+        return index;
+    }
+
+    // The mantissa has more than 56 bits when digits are dropped, so a sticky bit at the bottom rounds correctly
+    if (truncated)
+        mantissa |= 1;
+
+    value = ldexp((f64) mantissa, (int) exponent);
+
+    // Subnormals would be rounded twice
+    if (value < 2.2250738585072014e-308)
+        value = parse_with_strtod(str, index);
+
+    return index;
+}
+
+u64 parse_f64(const char* str, u64 size, f64& value)
+{
+    if (size > 2 && str[0] == '0' && (str[1] | 0x20) == 'x')
+    {
+        const u64 used = parse_hex(str, size, value);
+        if (used > 0)
+            return used;
+    }
+
+    u64 index = 0;
+    u64 mantissa = 0;
+    s64 exponent = 0;
+    u32 digit_count = 0;        // Leading zeros aren't counted
+    bool has_digits = false;
+    bool truncated = false;
+    bool in_fraction = false;
+
+    for (; index < size; index++)
+    {
+        if (str[index] == '.' && !in_fraction)
+        {
+            in_fraction = true;
+            continue;
+        }
+
+        if (!is_digit(str[index]))
+            break;
+
+        const u32 digit = str[index] - '0';
+        has_digits = true;
+
+        if (digit_count < MAX_MANTISSA_DIGITS)
+        {
+            mantissa = mantissa * 10 + digit;
+            digit_count += (mantissa != 0);
+            exponent -= in_fraction;
+        }
+        else
+        {
+            truncated |= (digit != 0);
+            exponent += !in_fraction;
+        }
+    }
+
+    if (!has_digits)
+        return 0;
+
+    // The exponent is only used if it has digits, otherwise the 'e' is left for the tokenizer
+    if (index + 1 < size && (str[index] | 0x20) == 'e')
+    {
+        u64 exponent_index = index + 1;
+        const bool negative = str[exponent_index] == '-';
+        exponent_index += (str[exponent_index] == '-' || str[exponent_index] == '+');
+
+        if (exponent_index < size && is_digit(str[exponent_index]))
+        {
+            s64 decimal_exponent = 0;
+            for (; exponent_index < size && is_digit(str[exponent_index]); exponent_index++)
+            {
+                if (decimal_exponent < 100000)
+                    decimal_exponent = decimal_exponent * 10 + (str[exponent_index] - '0');
+            }
+
+            exponent += negative ? -decimal_exponent : decimal_exponent;
+            index = exponent_index;
+        }
+    }
+
+    if (mantissa == 0)
+    {
+        value = 0.0;
+        return index;
+    }
+
+    // Clinger's fast path: both the mantissa and the power of ten are exact so a single operation rounds correctly
+    if (!truncated && mantissa <= (1Ui64 << 53))
+    {
+        if (exponent >= -22 && exponent <= 22)
+        {
+            value = (exponent < 0) ? (f64) mantissa / exact_powers_of_ten[-exponent]
+                                   : (f64) mantissa * exact_powers_of_ten[exponent];
+            return index;
+        }
+
+        // Some of the power can be moved into the mantissa if it stays exact
+        if (exponent > 22 && exponent <= 22 + 16)
+        {
+            const u64 scale = integer_powers_of_ten[exponent - 22];
+            if (mantissa <= (1Ui64 << 53) / scale)
+            {
+                value = (f64) (mantissa * scale) * 1e22;
+                return index;
+            }
+        }
+    }
+
+    const u64 bits = eisel_lemire(mantissa, exponent);
+
+    // The dropped digits put the number between mantissa and mantissa + 1, both have to round the same way
+    if (truncated && eisel_lemire(mantissa + 1, exponent) != bits)
+    {
+        value = parse_with_strtod(str, index);
+        return index;
+    }
+
+    value = f64_from_bits(bits);
+    return index;
+}
+
+} // namespace Calculator
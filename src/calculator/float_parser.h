@@ -0,0 +1,14 @@
+#pragma once
+
+#include "core/types.h"
+
+namespace Calculator
+{
+
+// Parses the number at the start of str without reading past size characters. Accepts decimal numbers
+// with an optional point and exponent (1.5e-9) and hex numbers with an optional point and binary
+// exponent (0x1.8p3). Signs are left to the caller. The result is correctly rounded.
+// Returns the number of characters used, 0 if str doesn't start with a number.
+u64 parse_f64(const char* str, u64 size, f64& value);
+
+} // namespace Calculator
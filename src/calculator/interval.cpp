@@ -0,0 +1,727 @@
+#include "interval.h"
+
+#include <cmath>
+#include <cstdio>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/float_format.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "platform/platform.h"
+#include "double_double.h"
+#include "error.h"
+#include "numeric_solver.h"
+#include "solver.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+constexpr f64 INTERVAL_PI     = 3.141592653589793;
+constexpr f64 INTERVAL_TWO_PI = 6.283185307179586;
+constexpr f64 INTERVAL_PI_2   = 1.5707963267948966;
+
+// Periodic functions of larger numbers aren't reduced precisely enough, they get their whole range
+constexpr f64 INTERVAL_MAX_PERIODIC_INPUT = 1e9;
+
+// Results are moved one f64 outwards. The basic operations are correctly rounded and the math
+// library functions are accurate to less than one unit in the last place.
+inline static f64 round_down(f64 value)
+{
+    return nextafter(value, -INFINITY);
+}
+
+inline static f64 round_up(f64 value)
+{
+    return nextafter(value, INFINITY);
+}
+
+inline static Interval make_interval(f64 low, f64 high)
+{
+    return Interval { low, high };
+}
+
+inline static Interval round_outwards(f64 low, f64 high)
+{
+    return Interval { round_down(low), round_up(high) };
+}
+
+inline static Interval everything()
+{
+    return Interval { -INFINITY, INFINITY };
+}
+
+inline static Interval empty()
+{
+    return Interval { NAN, NAN };
+}
+
+inline static Interval hull(Interval a, Interval b)
+{
+    return Interval { fmin(a.low, b.low), fmax(a.high, b.high) };
+}
+
+inline static bool contains_zero(Interval a)
+{
+    return a.low <= 0.0 && a.high >= 0.0;
+}
+
+inline static f64 min4(f64 a, f64 b, f64 c, f64 d)
+{
+    return fmin(fmin(a, b), fmin(c, d));
+}
+
+inline static f64 max4(f64 a, f64 b, f64 c, f64 d)
+{
+    return fmax(fmax(a, b), fmax(c, d));
+}
+
+// Infinity times 0 is 0 here since the infinite bound is never reached
+inline static f64 multiply_bounds(f64 a, f64 b)
+{
+    return (a == 0.0 || b == 0.0) ? 0.0 : a * b;
+}
+
+// Logic operators only know the result if every value in the range is true or every value is false
+enum struct Truth
+{
+    FALSE,
+    TRUE,
+    UNKNOWN
+};
+
+inline static Truth truth(Interval a)
+{
+    if (a.low == 0.0 && a.high == 0.0)
+        return Truth::FALSE;
+
+    if (a.low > 0.0 || a.high < 0.0)
+        return Truth::TRUE;
+
+    return Truth::UNKNOWN;
+}
+
+inline static Interval from_truth(Truth value)
+{
+    switch (value)
+    {
+        case Truth::FALSE: return make_interval(0.0, 0.0);
+        case Truth::TRUE:  return make_interval(1.0, 1.0);
+        default:           return make_interval(0.0, 1.0);
+    }
+}
+
+// Checks if the interval contains phase + k * period for any integer k. Extremes right at the
+// ends are counted as inside so rounding in the division can't lose them.
+static bool contains_phase(Interval a, f64 phase, f64 period)
+{
+    const f64 start = (a.low - phase) / period;
+    const f64 end   = (a.high - phase) / period;
+
+    return ceil(start - 1e-9) <= floor(end + 1e-9);
+}
+
+inline static bool is_periodic_input(Interval a)
+{
+    return fabs(a.low) < INTERVAL_MAX_PERIODIC_INPUT && fabs(a.high) < INTERVAL_MAX_PERIODIC_INPUT;
+}
+
+// For sin and cos, the maximum is at max_phase + 2k * pi and the minimum half a period later
+static Interval periodic_bounds(Interval a, f64 (*function)(f64), f64 max_phase)
+{
+    if (!is_periodic_input(a) || a.high - a.low >= INTERVAL_TWO_PI)
+        return make_interval(-1.0, 1.0);
+
+    const f64 at_low  = function(a.low);
+    const f64 at_high = function(a.high);
+
+    Interval result = round_outwards(fmin(at_low, at_high), fmax(at_low, at_high));
+
+    if (contains_phase(a, max_phase, INTERVAL_TWO_PI))
+        result.high = 1.0;
+
+    if (contains_phase(a, max_phase + INTERVAL_PI, INTERVAL_TWO_PI))
+        result.low = -1.0;
+
+    return make_interval(fmax(result.low, -1.0), fmin(result.high, 1.0));
+}
+
+// Kernels work on one box at a time, the same kernels are used for single intervals and for columns.
+// They follow the functions in opdef.h.
+
+struct NegInterval      { static Interval apply(Interval a) { return make_interval(-a.high, -a.low); } };
+
+struct AddInterval      { static Interval apply(Interval a, Interval b) { return round_outwards(a.low + b.low, a.high + b.high); } };
+struct SubtractInterval { static Interval apply(Interval a, Interval b) { return round_outwards(a.low - b.high, a.high - b.low); } };
+
+struct MultiplyInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        const f64 p0 = multiply_bounds(a.low,  b.low);
+        const f64 p1 = multiply_bounds(a.low,  b.high);
+        const f64 p2 = multiply_bounds(a.high, b.low);
+        const f64 p3 = multiply_bounds(a.high, b.high);
+
+        return round_outwards(min4(p0, p1, p2, p3), max4(p0, p1, p2, p3));
+    }
+};
+
+struct DivideInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        // Dividing by a range around 0 can give anything, dividing by exactly 0 is never defined
+        if (contains_zero(b))
+            return (b.low == 0.0 && b.high == 0.0) ? empty() : everything();
+
+        const f64 q0 = a.low  / b.low;
+        const f64 q1 = a.low  / b.high;
+        const f64 q2 = a.high / b.low;
+        const f64 q3 = a.high / b.high;
+
+        return round_outwards(min4(q0, q1, q2, q3), max4(q0, q1, q2, q3));
+    }
+};
+
+// fmod is exact, the result has the sign of a and is smaller than b in magnitude
+struct RemainderInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        const f64 largest_divisor = fmax(fabs(b.low), fabs(b.high));
+        const f64 smallest_divisor = contains_zero(b) ? 0.0 : fmin(fabs(b.low), fabs(b.high));
+
+        if (fmax(fabs(a.low), fabs(a.high)) < smallest_divisor)
+            return a;
+
+        const f64 low  = (a.low  >= 0.0) ? 0.0 : fmax(a.low, -largest_divisor);
+        const f64 high = (a.high <= 0.0) ? 0.0 : fmin(a.high, largest_divisor);
+        return make_interval(low, high);
+    }
+};
+
+struct PowInterval
+{
+    static Interval corners(Interval a, Interval b)
+    {
+        const f64 p0 = pow(a.low,  b.low);
+        const f64 p1 = pow(a.low,  b.high);
+        const f64 p2 = pow(a.high, b.low);
+        const f64 p3 = pow(a.high, b.high);
+
+        return round_outwards(min4(p0, p1, p2, p3), max4(p0, p1, p2, p3));
+    }
+
+    static Interval apply(Interval a, Interval b)
+    {
+        // Negative bases only have results for integer exponents
+        const bool integer_exponent = b.low == b.high && b.low == floor(b.low) && fabs(b.low) < 1e15;
+
+        if (!integer_exponent)
+        {
+            if (a.high < 0.0)
+                return empty();
+
+            // Powers of non negative numbers are monotonic in both the base and the exponent
+            return corners(make_interval(fmax(a.low, 0.0), a.high), b);
+        }
+
+        if (a.low >= 0.0 || a.high <= 0.0)
+            return corners(a, b);
+
+        // Base is on both sides of 0
+        const f64 n = b.low;
+        if (n == 0.0)
+            return make_interval(1.0, 1.0);
+
+        if (n < 0.0)
+            return everything();
+
+        const bool even = fmod(n, 2.0) == 0.0;
+        if (even)
+            return make_interval(0.0, round_up(fmax(pow(a.low, n), pow(a.high, n))));
+
+        return round_outwards(pow(a.low, n), pow(a.high, n));
+    }
+};
+
+struct AndInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        const Truth x = truth(a);
+        const Truth y = truth(b);
+
+        if (x == Truth::FALSE || y == Truth::FALSE)
+            return from_truth(Truth::FALSE);
+
+        return from_truth((x == Truth::TRUE && y == Truth::TRUE) ? Truth::TRUE : Truth::UNKNOWN);
+    }
+};
+
+struct OrInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        const Truth x = truth(a);
+        const Truth y = truth(b);
+
+        if (x == Truth::TRUE || y == Truth::TRUE)
+            return from_truth(Truth::TRUE);
+
+        return from_truth((x == Truth::FALSE && y == Truth::FALSE) ? Truth::FALSE : Truth::UNKNOWN);
+    }
+};
+
+struct NotInterval
+{
+    static Interval apply(Interval a)
+    {
+        switch (truth(a))
+        {
+            case Truth::FALSE: return from_truth(Truth::TRUE);
+            case Truth::TRUE:  return from_truth(Truth::FALSE);
+            default:           return from_truth(Truth::UNKNOWN);
+        }
+    }
+};
+
+// Comparisons are only known if the ranges don't overlap in the wrong way
+inline static Interval compare(bool always, bool never)
+{
+    return from_truth(always ? Truth::TRUE : (never ? Truth::FALSE : Truth::UNKNOWN));
+}
+
+struct GreaterInterval      { static Interval apply(Interval a, Interval b) { return compare(a.low > b.high,  a.high <= b.low); } };
+struct LesserInterval       { static Interval apply(Interval a, Interval b) { return compare(a.high < b.low,  a.low >= b.high); } };
+struct GreaterEqualInterval { static Interval apply(Interval a, Interval b) { return compare(a.low >= b.high, a.high < b.low); } };
+struct LesserEqualInterval  { static Interval apply(Interval a, Interval b) { return compare(a.high <= b.low, a.low > b.high); } };
+
+struct EqualInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        const bool always = a.low == a.high && b.low == b.high && a.low == b.low;
+        const bool never  = a.high < b.low || b.high < a.low;
+        return compare(always, never);
+    }
+};
+
+struct NotEqualInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        const bool never  = a.low == a.high && b.low == b.high && a.low == b.low;
+        const bool always = a.high < b.low || b.high < a.low;
+        return compare(always, never);
+    }
+};
+
+struct NaturalLogInterval
+{
+    static Interval apply(Interval a)
+    {
+        if (a.high < 0.0)
+            return empty();
+
+        return round_outwards(log(fmax(a.low, 0.0)), log(a.high));
+    }
+};
+
+// log(a, b) = ln(b) / ln(a)
+struct LogInterval
+{
+    static Interval apply(Interval a, Interval b)
+    {
+        return DivideInterval::apply(NaturalLogInterval::apply(b), NaturalLogInterval::apply(a));
+    }
+};
+
+struct SinInterval { static Interval apply(Interval a) { return periodic_bounds(a, sin, INTERVAL_PI_2); } };
+struct CosInterval { static Interval apply(Interval a) { return periodic_bounds(a, cos, 0.0); } };
+
+// Increasing between the poles at pi/2 + k * pi
+struct TanInterval
+{
+    static Interval apply(Interval a)
+    {
+        if (!is_periodic_input(a) || a.high - a.low >= INTERVAL_PI || contains_phase(a, INTERVAL_PI_2, INTERVAL_PI))
+            return everything();
+
+        return round_outwards(tan(a.low), tan(a.high));
+    }
+};
+
+// Decreasing between the poles at k * pi
+struct CotInterval
+{
+    static Interval apply(Interval a)
+    {
+        if (!is_periodic_input(a) || a.high - a.low >= INTERVAL_PI || contains_phase(a, 0.0, INTERVAL_PI))
+            return everything();
+
+        return round_outwards(1.0 / tan(a.high), 1.0 / tan(a.low));
+    }
+};
+
+struct SecInterval   { static Interval apply(Interval a) { return DivideInterval::apply(make_interval(1.0, 1.0), CosInterval::apply(a)); } };
+struct CosecInterval { static Interval apply(Interval a) { return DivideInterval::apply(make_interval(1.0, 1.0), SinInterval::apply(a)); } };
+
+struct SinhInterval { static Interval apply(Interval a) { return round_outwards(sinh(a.low), sinh(a.high)); } };
+
+struct CoshInterval
+{
+    static Interval apply(Interval a)
+    {
+        const f64 high = round_up(fmax(cosh(a.low), cosh(a.high)));
+        if (contains_zero(a))
+            return make_interval(1.0, high);
+
+        return make_interval(fmax(round_down(fmin(cosh(a.low), cosh(a.high))), 1.0), high);
+    }
+};
+
+struct TanhInterval
+{
+    static Interval apply(Interval a)
+    {
+        return make_interval(fmax(round_down(tanh(a.low)), -1.0), fmin(round_up(tanh(a.high)), 1.0));
+    }
+};
+
+struct SqrtInterval
+{
+    static Interval apply(Interval a)
+    {
+        if (a.high < 0.0)
+            return empty();
+
+        return make_interval(fmax(round_down(sqrt(fmax(a.low, 0.0))), 0.0), round_up(sqrt(a.high)));
+    }
+};
+
+struct ExpInterval
+{
+    static Interval apply(Interval a)
+    {
+        return make_interval(fmax(round_down(exp(a.low)), 0.0), round_up(exp(a.high)));
+    }
+};
+
+// Choosing the larger or smaller value is exact
+struct MaxInterval { static Interval apply(Interval a, Interval b) { return make_interval(fmax(a.low, b.low), fmax(a.high, b.high)); } };
+struct MinInterval { static Interval apply(Interval a, Interval b) { return make_interval(fmin(a.low, b.low), fmin(a.high, b.high)); } };
+
+struct CondInterval
+{
+    static Interval apply(Interval c, Interval a, Interval b)
+    {
+        switch (truth(c))
+        {
+            case Truth::TRUE:  return a;
+            case Truth::FALSE: return b;
+            default:           return hull(a, b);
+        }
+    }
+};
+
+template <u32 operand_count, typename Kernel>
+static void run_interval_kernel(f64* out_lows, f64* out_highs, const f64* const in_lows[], const f64* const in_highs[], u64 count)
+{
+    for (u64 i = 0; i < count; i++)
+    {
+        Interval result;
+
+        if constexpr (operand_count == 1)
+        {
+            result = Kernel::apply(Interval { in_lows[0][i], in_highs[0][i] });
+        }
+        else if constexpr (operand_count == 2)
+        {
+            result = Kernel::apply(Interval { in_lows[0][i], in_highs[0][i] }, Interval { in_lows[1][i], in_highs[1][i] });
+        }
+        else
+        {
+            result = Kernel::apply(Interval { in_lows[0][i], in_highs[0][i] }, Interval { in_lows[1][i], in_highs[1][i] },
+                                   Interval { in_lows[2][i], in_highs[2][i] });
+        }
+
+        out_lows[i]  = result.low;
+        out_highs[i] = result.high;
+    }
+}
+
+// Output columns can be the same as the first input columns
+static void run_interval_operator(const Operator& op, f64* out_lows, f64* out_highs, const f64* const in_lows[], const f64* const in_highs[], u64 count)
+{
+    #define INTERVAL_CASE(code, operand_count, kernel) \
+        case OperatorCode::code: run_interval_kernel<operand_count, kernel>(out_lows, out_highs, in_lows, in_highs, count); break;
+
+    switch (op.code)
+    {
+        INTERVAL_CASE(NEG,           1, NegInterval)
+        INTERVAL_CASE(MULTIPLY,      2, MultiplyInterval)
+        INTERVAL_CASE(DIVIDE,        2, DivideInterval)
+        INTERVAL_CASE(REMAINDER,     2, RemainderInterval)
+        INTERVAL_CASE(ADD,           2, AddInterval)
+        INTERVAL_CASE(SUBTRACT,      2, SubtractInterval)
+        INTERVAL_CASE(POW,           2, PowInterval)
+        INTERVAL_CASE(AND,           2, AndInterval)
+        INTERVAL_CASE(OR,            2, OrInterval)
+        INTERVAL_CASE(NOT,           1, NotInterval)
+        INTERVAL_CASE(GREATER,       2, GreaterInterval)
+        INTERVAL_CASE(LESSER,        2, LesserInterval)
+        INTERVAL_CASE(GREATER_EQUAL, 2, GreaterEqualInterval)
+        INTERVAL_CASE(LESSER_EQUAL,  2, LesserEqualInterval)
+        INTERVAL_CASE(EQUAL,         2, EqualInterval)
+        INTERVAL_CASE(NOT_EQUAL,     2, NotEqualInterval)
+        INTERVAL_CASE(NATURAL_LOG,   1, NaturalLogInterval)
+        INTERVAL_CASE(LOG,           2, LogInterval)
+        INTERVAL_CASE(SIN,           1, SinInterval)
+        INTERVAL_CASE(COS,           1, CosInterval)
+        INTERVAL_CASE(TAN,           1, TanInterval)
+        INTERVAL_CASE(SEC,           1, SecInterval)
+        INTERVAL_CASE(COSEC,         1, CosecInterval)
+        INTERVAL_CASE(COT,           1, CotInterval)
+        INTERVAL_CASE(SINH,          1, SinhInterval)
+        INTERVAL_CASE(COSH,          1, CoshInterval)
+        INTERVAL_CASE(TANH,          1, TanhInterval)
+        INTERVAL_CASE(SQRT,          1, SqrtInterval)
+        INTERVAL_CASE(EXP,           1, ExpInterval)
+        INTERVAL_CASE(MAX,           2, MaxInterval)
+        INTERVAL_CASE(MIN,           2, MinInterval)
+        INTERVAL_CASE(COND,          3, CondInterval)
+
+        default:
+        {
+            gn_assert_with_message(false, "Operator doesn't have an interval version! (code: %)", (u32) op.code);
+        } break;
+    }
+
+    #undef INTERVAL_CASE
+}
+
+Interval apply_operator(const Operator& op, const Interval operands[])
+{
+    const f64* lows[3];
+    const f64* highs[3];
+
+    for (u32 i = 0; i < op.operand_count; i++)
+    {
+        lows[i]  = &operands[i].low;
+        highs[i] = &operands[i].high;
+    }
+
+    Interval result;
+    run_interval_operator(op, &result.low, &result.high, lows, highs, 1);
+    return result;
+}
+
+// Double-doubles parsed from text are good to about 2^-100 of the value, closer than that it isn't known
+// which side of the f64 the written number is on
+constexpr f64 INTERVAL_SOURCE_ERROR = 0x1p-96;
+
+static Interval number_interval(f64 value, DoubleDouble exact)
+{
+    // Numbers that overflow or are tiny are only parsed as f64 (see double_double_from_string), so they
+    // aren't known to be exact. Numbers that underflow to zero are taken as zero.
+    const bool parsed_as_f64 = !std::isfinite(value) || (value != 0.0 && fabs(value) < 1e-290);
+
+    if (exact.hi == value && exact.lo == 0.0 && !parsed_as_f64)
+        return make_interval(value, value);
+
+    const bool known_side = exact.hi == value && fabs(exact.lo) > fabs(value) * INTERVAL_SOURCE_ERROR;
+    return make_interval((known_side && exact.lo > 0.0) ? value : round_down(value),
+                         (known_side && exact.lo < 0.0) ? value : round_up(value));
+}
+
+void convert_interval_constants(const DynamicArray<ExpressionElement>& expression, const String text, DynamicArray<Interval>& constants)
+{
+    clear(constants);
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        const ExpressionElement& element = expression[i];
+
+        if (element.type != ExpressionElement::Type::NUMBER)
+            append(constants, Interval {});
+        else if (element.source != 0)
+            append(constants, number_interval(element.value, numeric_from_source<DoubleDouble>(text, element.source - 1, element.value)));
+        else if (element.value == trunc(element.value) && std::isfinite(element.value))
+            append(constants, make_interval(element.value, element.value));
+        else
+            append(constants, make_interval(round_down(element.value), round_up(element.value)));
+    }
+}
+
+Interval solve_postfix_interval(const DynamicArray<ExpressionElement>& expression, const DynamicArray<Interval>& constants,
+                                DynamicArray<Interval>& interval_stack, const Interval variables[])
+{
+    clear(interval_stack);
+
+    Interval operands[3];   // Max operand count in functions is 3
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        switch (expression[i].type)
+        {
+            case ExpressionElement::Type::NUMBER:
+            {
+                append(interval_stack, constants[i]);
+            } break;
+
+            case ExpressionElement::Type::VARIABLE:
+            {
+                gn_assert_with_message(variables, "Expression uses variables but no ranges were given for them! (variable index: %)", expression[i].variable.index);
+                append(interval_stack, variables[expression[i].variable.index]);
+            } break;
+
+            case ExpressionElement::Type::OPERATOR:
+            {
+                const Operator& op = get_operator(expression[i].op_code);
+
+                interval_stack.size -= op.operand_count;
+                for (u32 j = 0; j < op.operand_count; j++)
+                    operands[j] = interval_stack.data[interval_stack.size + j];
+
+                append(interval_stack, apply_operator(op, operands));
+            } break;
+        }
+    }
+
+    gn_assert_with_message(interval_stack.size == 1, "Number stack has extra values! (numbers left: %)", interval_stack.size);
+
+    return interval_stack[0];
+}
+
+bool solve_postfix_intervals(const DynamicArray<ExpressionElement>& expression, const DynamicArray<Interval>& constants,
+                             const f64* const variable_lows[], const f64* const variable_highs[], u64 box_count,
+                             f64 result_lows[], f64 result_highs[], IntervalScratch& scratch)
+{
+    const u32 stack_depth = max_stack_depth(expression);
+    if (stack_depth == 0)
+    {
+        print_error("Expression is malformed! Operators don't have the right number of operands.\n");
+        return false;
+    }
+
+    if (scratch.lows.capacity < stack_depth * INTERVAL_BLOCK_SIZE)
+    {
+        resize(scratch.lows, stack_depth * INTERVAL_BLOCK_SIZE);
+        resize(scratch.highs, stack_depth * INTERVAL_BLOCK_SIZE);
+    }
+
+    if (scratch.low_slots.capacity < stack_depth)
+    {
+        resize(scratch.low_slots, (u64) stack_depth);
+        resize(scratch.high_slots, (u64) stack_depth);
+    }
+
+    // Accessing the raw pointers since the arrays are used as fixed size storage here
+    f64* const        lows       = scratch.lows.data;
+    f64* const        highs      = scratch.highs.data;
+    const f64** const low_slots  = scratch.low_slots.data;
+    const f64** const high_slots = scratch.high_slots.data;
+
+    for (u64 block_start = 0; block_start < box_count; block_start += INTERVAL_BLOCK_SIZE)
+    {
+        const u64 count = min(INTERVAL_BLOCK_SIZE, box_count - block_start);
+        u32 top = 0;
+
+        for (u64 i = 0; i < expression.size; i++)
+        {
+            const ExpressionElement& element = expression[i];
+
+            switch (element.type)
+            {
+                case ExpressionElement::Type::NUMBER:
+                {
+                    f64* low_column  = lows  + top * INTERVAL_BLOCK_SIZE;
+                    f64* high_column = highs + top * INTERVAL_BLOCK_SIZE;
+                    for (u64 j = 0; j < count; j++)
+                    {
+                        low_column[j]  = constants[i].low;
+                        high_column[j] = constants[i].high;
+                    }
+
+                    low_slots[top]  = low_column;
+                    high_slots[top] = high_column;
+                    top++;
+                } break;
+
+                case ExpressionElement::Type::VARIABLE:
+                {
+                    // Variable columns are read in place
+                    low_slots[top]  = variable_lows[element.variable.index] + block_start;
+                    high_slots[top] = variable_highs[element.variable.index] + block_start;
+                    top++;
+                } break;
+
+                case ExpressionElement::Type::OPERATOR:
+                {
+                    const Operator& op = get_operator(element.op_code);
+                    top -= op.operand_count;
+
+                    // Result takes the place of the first operand
+                    f64* low_column  = lows  + top * INTERVAL_BLOCK_SIZE;
+                    f64* high_column = highs + top * INTERVAL_BLOCK_SIZE;
+                    run_interval_operator(op, low_column, high_column, low_slots + top, high_slots + top, count);
+
+                    low_slots[top]  = low_column;
+                    high_slots[top] = high_column;
+                    top++;
+                } break;
+            }
+        }
+
+        platform_copy_memory(result_lows + block_start, low_slots[0], count * sizeof(f64));
+        platform_copy_memory(result_highs + block_start, high_slots[0], count * sizeof(f64));
+    }
+
+    return true;
+}
+
+void free(IntervalScratch& scratch)
+{
+    free(scratch.lows);
+    free(scratch.highs);
+    free(scratch.low_slots);
+    free(scratch.high_slots);
+}
+
+bool solve_bounds(const String expression, const String variable_names[], const Interval ranges[], u32 variable_count, FILE* output)
+{
+    // Not optimized, folding constants would round them to the nearest f64 instead of outwards.
+    // Numbers keep their source so the ones f64 can't hold exactly are widened.
+    DynamicArray<ExpressionElement> elements = make<DynamicArray<ExpressionElement>>(16Ui64);
+    DynamicArray<OperatorOrBracket> op_stack = make<DynamicArray<OperatorOrBracket>>(16Ui64);
+
+    ExpressionError error;
+    const bool success = infix_expression_to_postfix(expression, elements, op_stack, error, variable_names, variable_count, true);
+
+    if (success)
+    {
+        DynamicArray<Interval> constants      = make<DynamicArray<Interval>>(elements.size);
+        DynamicArray<Interval> interval_stack = make<DynamicArray<Interval>>(16Ui64);
+        convert_interval_constants(elements, expression, constants);
+
+        const Interval result = solve_postfix_interval(elements, constants, interval_stack, ranges);
+
+        print_to_file(output, "Range: [%, %]\n", ShortestF64 { result.low }, ShortestF64 { result.high });
+
+        free(interval_stack);
+        free(constants);
+    }
+    else
+    {
+        print_error("Could not parse expression \"%\"!\n", expression);
+    }
+
+    free(op_stack);
+    free(elements);
+
+    return success;
+}
+
+} // namespace Calculator
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdio>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Closed range of values. Every operator rounds its bounds outwards and numbers that f64 can't hold
+// exactly are ranges around them (see convert_interval_constants), so the result of an expression
+// contains every value it takes for inputs in the ranges of its variables (points where it isn't
+// defined, like sqrt of a negative number, are left out). Empty ranges have NaN bounds.
+struct Interval
+{
+    f64 low;
+    f64 high;
+};
+
+Interval apply_operator(const Operator& op, const Interval operands[]);
+
+// Ranges of the numbers in the expression, indexed like its elements. Numbers that kept their source (see
+// infix_expression_to_postfix) are parsed again as double-doubles, if their f64 isn't exact the range reaches
+// one f64 past it on the side of the written value. Pi and e are never exact. Numbers without a source are
+// only exact if they are integers, the others get one f64 on both sides.
+void convert_interval_constants(const DynamicArray<ExpressionElement>& expression, const String text, DynamicArray<Interval>& constants);
+
+// Same as solve_postfix_data but for ranges of the variables
+Interval solve_postfix_interval(const DynamicArray<ExpressionElement>& expression, const DynamicArray<Interval>& constants,
+                                DynamicArray<Interval>& interval_stack, const Interval variables[]);
+
+// Boxes are solved in blocks of this size, the low and high bounds of each stack slot are separate columns
+constexpr u64 INTERVAL_BLOCK_SIZE = 256;
+
+// Scratch space for the interval column solver, can be reused across calls
+struct IntervalScratch
+{
+    DynamicArray<f64>        lows;          // Storage for intermediate bounds (one block for each stack slot)
+    DynamicArray<f64>        highs;
+    DynamicArray<const f64*> low_slots;     // Columns that each stack slot points to
+    DynamicArray<const f64*> high_slots;
+};
+
+// Solves the expression for box_count boxes at once. Every variable has a column of low bounds and a
+// column of high bounds with box_count values each. Returns false if the expression is malformed.
+bool solve_postfix_intervals(const DynamicArray<ExpressionElement>& expression, const DynamicArray<Interval>& constants,
+                             const f64* const variable_lows[], const f64* const variable_highs[], u64 box_count,
+                             f64 result_lows[], f64 result_highs[], IntervalScratch& scratch);
+
+void free(IntervalScratch& scratch);
+
+// Prints the range of the expression for the given ranges of the variables
+bool solve_bounds(const String expression, const String variable_names[], const Interval ranges[], u32 variable_count, FILE* output);
+
+} // namespace Calculator
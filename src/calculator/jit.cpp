@@ -0,0 +1,434 @@
+#include "jit.h"
+
+#include "containers/darray.h"
+#include "core/types.h"
+#include "math/common.h"
+#include "platform/platform.h"
+#include "solver.h"
+#include "token.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define CALCULATOR_JIT_X64
+#endif
+
+namespace Calculator
+{
+
+#ifdef CALCULATOR_JIT_X64
+
+// Generated code keeps every value on the stack in the scratch array (r12 points to it) and
+// the variables are read from the array rbx points to. Both registers are callee saved on
+// Windows and System V, so libm calls don't clobber them. Operands are loaded into xmm
+// registers, the result is written back into the scratch slot of the first operand.
+
+enum XmmRegister : u8
+{
+    XMM0,
+    XMM1,
+    XMM2,
+    XMM3,
+};
+
+// SSE2 opcodes (second byte after 0x0F)
+constexpr u8 SSE_MOVSD_LOAD  = 0x10;
+constexpr u8 SSE_MOVSD_STORE = 0x11;
+constexpr u8 SSE_MOVAPD      = 0x28;
+constexpr u8 SSE_SQRT        = 0x51;
+constexpr u8 SSE_AND         = 0x54;
+constexpr u8 SSE_ANDN        = 0x55;
+constexpr u8 SSE_OR          = 0x56;
+constexpr u8 SSE_XOR         = 0x57;
+constexpr u8 SSE_ADD         = 0x58;
+constexpr u8 SSE_MUL         = 0x59;
+constexpr u8 SSE_SUB         = 0x5C;
+constexpr u8 SSE_MIN         = 0x5D;
+constexpr u8 SSE_DIV         = 0x5E;
+constexpr u8 SSE_MAX         = 0x5F;
+constexpr u8 SSE_CMP         = 0xC2;
+
+// Prefixes for scalar double and packed double instructions
+constexpr u8 PREFIX_SD = 0xF2;
+constexpr u8 PREFIX_PD = 0x66;
+
+// Predicates for cmpsd (ordered unless stated otherwise)
+constexpr u8 CMP_EQ  = 0;
+constexpr u8 CMP_LT  = 1;
+constexpr u8 CMP_LE  = 2;
+constexpr u8 CMP_NEQ = 4;  // Unordered (true for NaN) like != in C
+
+// Wrappers so the generated code calls the same libm functions as the functions in opdef.h
+static f64 jit_sin(f64 x)         { return sin(x); }
+static f64 jit_cos(f64 x)         { return cos(x); }
+static f64 jit_tan(f64 x)         { return tan(x); }
+static f64 jit_sinh(f64 x)        { return sinh(x); }
+static f64 jit_cosh(f64 x)        { return cosh(x); }
+static f64 jit_tanh(f64 x)        { return tanh(x); }
+static f64 jit_exp(f64 x)         { return exp(x); }
+static f64 jit_log(f64 x)         { return log(x); }
+static f64 jit_pow(f64 x, f64 y)  { return pow(x, y); }
+static f64 jit_fmod(f64 x, f64 y) { return fmod(x, y); }
+
+// A value on the stack while compiling
+struct JitValue
+{
+    enum struct Kind
+    {
+        SLOT,       // Stored in the scratch slot for its stack position
+        CONSTANT,
+        VARIABLE,
+    };
+
+    Kind kind;
+
+    union
+    {
+        f64 value;
+        u32 index;
+    };
+};
+
+inline static void emit(DynamicArray<u8>& code, u8 byte)
+{
+    append(code, byte);
+}
+
+inline static void emit_u32(DynamicArray<u8>& code, u32 value)
+{
+    append_many(code, (const u8*) &value, sizeof(u32));
+}
+
+inline static void emit_u64(DynamicArray<u8>& code, u64 value)
+{
+    append_many(code, (const u8*) &value, sizeof(u64));
+}
+
+// Register to register SSE instruction (dst = dst op src)
+inline static void emit_sse(DynamicArray<u8>& code, u8 prefix, u8 opcode, XmmRegister dst, XmmRegister src)
+{
+    emit(code, prefix);
+    emit(code, 0x0F);
+    emit(code, opcode);
+    emit(code, 0xC0 | (dst << 3) | src);
+}
+
+// cmpsd dst, src, predicate (dst becomes an all ones or all zeros mask)
+inline static void emit_compare(DynamicArray<u8>& code, XmmRegister dst, XmmRegister src, u8 predicate)
+{
+    emit_sse(code, PREFIX_SD, SSE_CMP, dst, src);
+    emit(code, predicate);
+}
+
+// mov rax, imm64
+inline static void emit_mov_rax(DynamicArray<u8>& code, u64 value)
+{
+    emit(code, 0x48);
+    emit(code, 0xB8);
+    emit_u64(code, value);
+}
+
+// movsd xmm, [r12 + slot * 8]
+inline static void emit_load_slot(DynamicArray<u8>& code, XmmRegister reg, u32 slot)
+{
+    emit(code, PREFIX_SD);
+    emit(code, 0x41);
+    emit(code, 0x0F);
+    emit(code, SSE_MOVSD_LOAD);
+    emit(code, 0x84 | (reg << 3));
+    emit(code, 0x24);
+    emit_u32(code, slot * sizeof(f64));
+}
+
+// movsd [r12 + slot * 8], xmm
+inline static void emit_store_slot(DynamicArray<u8>& code, u32 slot, XmmRegister reg)
+{
+    emit(code, PREFIX_SD);
+    emit(code, 0x41);
+    emit(code, 0x0F);
+    emit(code, SSE_MOVSD_STORE);
+    emit(code, 0x84 | (reg << 3));
+    emit(code, 0x24);
+    emit_u32(code, slot * sizeof(f64));
+}
+
+// movsd xmm, [rbx + index * 8]
+inline static void emit_load_variable(DynamicArray<u8>& code, XmmRegister reg, u32 index)
+{
+    emit(code, PREFIX_SD);
+    emit(code, 0x0F);
+    emit(code, SSE_MOVSD_LOAD);
+    emit(code, 0x83 | (reg << 3));
+    emit_u32(code, index * sizeof(f64));
+}
+
+// mov rax, imm64; movq xmm, rax
+inline static void emit_load_constant(DynamicArray<u8>& code, XmmRegister reg, f64 value)
+{
+    u64 bits;
+    platform_copy_memory(&bits, &value, sizeof(f64));
+
+    emit_mov_rax(code, bits);
+
+    emit(code, PREFIX_PD);
+    emit(code, 0x48);
+    emit(code, 0x0F);
+    emit(code, 0x6E);
+    emit(code, 0xC0 | (reg << 3));
+}
+
+// mov rax, function; call rax
+inline static void emit_call(DynamicArray<u8>& code, const void* function)
+{
+    emit_mov_rax(code, (u64) function);
+    emit(code, 0xFF);
+    emit(code, 0xD0);
+}
+
+static void emit_load_value(DynamicArray<u8>& code, XmmRegister reg, const JitValue& value, u32 slot)
+{
+    switch (value.kind)
+    {
+        case JitValue::Kind::SLOT:     emit_load_slot(code, reg, slot);            break;
+        case JitValue::Kind::CONSTANT: emit_load_constant(code, reg, value.value); break;
+        case JitValue::Kind::VARIABLE: emit_load_variable(code, reg, value.index); break;
+    }
+}
+
+// Turns the mask in xmm0 into 1.0 or 0.0
+static void emit_mask_to_bool(DynamicArray<u8>& code)
+{
+    emit_load_constant(code, XMM3, 1.0);
+    emit_sse(code, PREFIX_PD, SSE_AND, XMM0, XMM3);
+}
+
+// xmm0 = 1 / xmm0
+static void emit_reciprocal(DynamicArray<u8>& code)
+{
+    emit_sse(code, PREFIX_PD, SSE_MOVAPD, XMM1, XMM0);
+    emit_load_constant(code, XMM0, 1.0);
+    emit_sse(code, PREFIX_SD, SSE_DIV, XMM0, XMM1);
+}
+
+static void emit_prologue(DynamicArray<u8>& code)
+{
+    emit(code, 0x53);                                   // push rbx
+    emit(code, 0x41); emit(code, 0x54);                 // push r12
+    emit(code, 0x48); emit(code, 0x83);                 // sub rsp, 40 (shadow space and alignment for calls)
+    emit(code, 0xEC); emit(code, 0x28);
+
+#ifdef _WIN32
+    emit(code, 0x48); emit(code, 0x89); emit(code, 0xCB);   // mov rbx, rcx
+    emit(code, 0x49); emit(code, 0x89); emit(code, 0xD4);   // mov r12, rdx
+#else
+    emit(code, 0x48); emit(code, 0x89); emit(code, 0xFB);   // mov rbx, rdi
+    emit(code, 0x49); emit(code, 0x89); emit(code, 0xF4);   // mov r12, rsi
+#endif
+}
+
+static void emit_epilogue(DynamicArray<u8>& code)
+{
+    emit(code, 0x48); emit(code, 0x83);                 // add rsp, 40
+    emit(code, 0xC4); emit(code, 0x28);
+    emit(code, 0x41); emit(code, 0x5C);                 // pop r12
+    emit(code, 0x5B);                                   // pop rbx
+    emit(code, 0xC3);                                   // ret
+}
+
+// Operands are in the stack starting at slot. Leaves the result in xmm0.
+static void emit_operator(DynamicArray<u8>& code, const Operator& op, const JitValue operands[], u32 slot)
+{
+    // Log needs log of both operands so they are loaded one at a time
+    if (op.code == OperatorCode::LOG)
+    {
+        // log(x) / log(base)
+        emit_load_value(code, XMM0, operands[1], slot + 1);
+        emit_call(code, (const void*) jit_log);
+        emit_store_slot(code, slot + 1, XMM0);
+
+        emit_load_value(code, XMM0, operands[0], slot);
+        emit_call(code, (const void*) jit_log);
+        emit_sse(code, PREFIX_PD, SSE_MOVAPD, XMM1, XMM0);
+        emit_load_slot(code, XMM0, slot + 1);
+        emit_sse(code, PREFIX_SD, SSE_DIV, XMM0, XMM1);
+        return;
+    }
+
+    for (u32 i = 0; i < op.operand_count; i++)
+        emit_load_value(code, (XmmRegister) i, operands[i], slot + i);
+
+    switch (op.code)
+    {
+        case OperatorCode::NEG:
+        {
+            emit_load_constant(code, XMM1, -1.0);
+            emit_sse(code, PREFIX_SD, SSE_MUL, XMM0, XMM1);
+        } break;
+
+        case OperatorCode::ADD:      emit_sse(code, PREFIX_SD, SSE_ADD, XMM0, XMM1); break;
+        case OperatorCode::SUBTRACT: emit_sse(code, PREFIX_SD, SSE_SUB, XMM0, XMM1); break;
+        case OperatorCode::MULTIPLY: emit_sse(code, PREFIX_SD, SSE_MUL, XMM0, XMM1); break;
+        case OperatorCode::DIVIDE:   emit_sse(code, PREFIX_SD, SSE_DIV, XMM0, XMM1); break;
+        case OperatorCode::MAX:      emit_sse(code, PREFIX_SD, SSE_MAX, XMM0, XMM1); break;
+        case OperatorCode::MIN:      emit_sse(code, PREFIX_SD, SSE_MIN, XMM0, XMM1); break;
+        case OperatorCode::SQRT:     emit_sse(code, PREFIX_SD, SSE_SQRT, XMM0, XMM0); break;
+
+        case OperatorCode::LESSER:       { emit_compare(code, XMM0, XMM1, CMP_LT);  emit_mask_to_bool(code); } break;
+        case OperatorCode::LESSER_EQUAL: { emit_compare(code, XMM0, XMM1, CMP_LE);  emit_mask_to_bool(code); } break;
+        case OperatorCode::EQUAL:        { emit_compare(code, XMM0, XMM1, CMP_EQ);  emit_mask_to_bool(code); } break;
+        case OperatorCode::NOT_EQUAL:    { emit_compare(code, XMM0, XMM1, CMP_NEQ); emit_mask_to_bool(code); } break;
+
+        // a > b is b < a
+        case OperatorCode::GREATER:
+        case OperatorCode::GREATER_EQUAL:
+        {
+            emit_compare(code, XMM1, XMM0, (op.code == OperatorCode::GREATER) ? CMP_LT : CMP_LE);
+            emit_sse(code, PREFIX_PD, SSE_MOVAPD, XMM0, XMM1);
+            emit_mask_to_bool(code);
+        } break;
+
+        case OperatorCode::NOT:
+        {
+            emit_sse(code, PREFIX_PD, SSE_XOR, XMM1, XMM1);
+            emit_compare(code, XMM0, XMM1, CMP_EQ);
+            emit_mask_to_bool(code);
+        } break;
+
+        case OperatorCode::AND:
+        case OperatorCode::OR:
+        {
+            emit_sse(code, PREFIX_PD, SSE_XOR, XMM2, XMM2);
+            emit_compare(code, XMM0, XMM2, CMP_NEQ);
+            emit_compare(code, XMM1, XMM2, CMP_NEQ);
+            emit_sse(code, PREFIX_PD, (op.code == OperatorCode::AND) ? SSE_AND : SSE_OR, XMM0, XMM1);
+            emit_mask_to_bool(code);
+        } break;
+
+        // (mask & a) | (~mask & b)
+        case OperatorCode::COND:
+        {
+            emit_sse(code, PREFIX_PD, SSE_XOR, XMM3, XMM3);
+            emit_compare(code, XMM0, XMM3, CMP_NEQ);
+            emit_sse(code, PREFIX_PD, SSE_AND, XMM1, XMM0);
+            emit_sse(code, PREFIX_PD, SSE_ANDN, XMM0, XMM2);
+            emit_sse(code, PREFIX_PD, SSE_OR, XMM0, XMM1);
+        } break;
+
+        case OperatorCode::REMAINDER:   emit_call(code, (const void*) jit_fmod); break;
+        case OperatorCode::POW:         emit_call(code, (const void*) jit_pow);  break;
+        case OperatorCode::NATURAL_LOG: emit_call(code, (const void*) jit_log);  break;
+        case OperatorCode::EXP:         emit_call(code, (const void*) jit_exp);  break;
+        case OperatorCode::SIN:         emit_call(code, (const void*) jit_sin);  break;
+        case OperatorCode::COS:         emit_call(code, (const void*) jit_cos);  break;
+        case OperatorCode::TAN:         emit_call(code, (const void*) jit_tan);  break;
+        case OperatorCode::SINH:        emit_call(code, (const void*) jit_sinh); break;
+        case OperatorCode::COSH:        emit_call(code, (const void*) jit_cosh); break;
+        case OperatorCode::TANH:        emit_call(code, (const void*) jit_tanh); break;
+
+        case OperatorCode::SEC:   { emit_call(code, (const void*) jit_cos); emit_reciprocal(code); } break;
+        case OperatorCode::COSEC: { emit_call(code, (const void*) jit_sin); emit_reciprocal(code); } break;
+        case OperatorCode::COT:   { emit_call(code, (const void*) jit_tan); emit_reciprocal(code); } break;
+    }
+}
+
+bool compile_jit(const DynamicArray<ExpressionElement>& expression, JitExpression& jit)
+{
+    jit = {};
+
+    const u32 stack_depth = max_stack_depth(expression);
+    if (stack_depth == 0)
+        return false;
+
+    DynamicArray<u8> code = make<DynamicArray<u8>>(max(64Ui64, expression.size * 16));
+    DynamicArray<JitValue> stack = make<DynamicArray<JitValue>>((u64) stack_depth);
+
+    emit_prologue(code);
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        const ExpressionElement& element = expression[i];
+
+        switch (element.type)
+        {
+            // Values are only loaded when an operator needs them
+            case ExpressionElement::Type::NUMBER:
+            {
+                JitValue value = { JitValue::Kind::CONSTANT };
+                value.value = element.value;
+                append(stack, value);
+            } break;
+
+            case ExpressionElement::Type::VARIABLE:
+            {
+                JitValue value = { JitValue::Kind::VARIABLE };
+                value.index = element.variable.index;
+                append(stack, value);
+            } break;
+
+            case ExpressionElement::Type::OPERATOR:
+            {
+                const Operator& op = get_operator(element.op_code);
+                const u32 slot = (u32) (stack.size - op.operand_count);
+                emit_operator(code, op, stack.data + slot, slot);
+                emit_store_slot(code, slot, XMM0);
+
+                stack.size = slot;
+                append(stack, JitValue { JitValue::Kind::SLOT });
+            } break;
+        }
+    }
+
+    emit_load_value(code, XMM0, stack[0], 0);
+    emit_epilogue(code);
+
+    free(stack);
+
+    void* memory = platform_allocate_executable(code.size);
+    if (!memory)
+    {
+        free(code);
+        return false;
+    }
+
+    platform_copy_memory(memory, code.data, code.size);
+
+    if (!platform_protect_executable(memory, code.size))
+    {
+        platform_free_executable(memory, code.size);
+        free(code);
+        return false;
+    }
+
+    jit.code = memory;
+    jit.code_size = code.size;
+    jit.scratch_size = stack_depth;
+    jit.function = (JitFunction) memory;
+
+    free(code);
+
+    return true;
+}
+
+void free(JitExpression& jit)
+{
+    if (jit.code)
+        platform_free_executable(jit.code, jit.code_size);
+
+    jit = {};
+}
+
+#else
+
+bool compile_jit(const DynamicArray<ExpressionElement>& expression, JitExpression& jit)
+{
+    // Only x86-64 is supported
+    jit = {};
+    return false;
+}
+
+void free(JitExpression& jit)
+{
+    jit = {};
+}
+
+#endif // CALCULATOR_JIT_X64
+
+} // namespace Calculator
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "containers/darray.h"
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Machine code takes the variables and a scratch array with space for jit.scratch_size values
+using JitFunction = f64 (*)(const f64 variables[], f64 scratch[]);
+
+struct JitExpression
+{
+    JitFunction function;   // Null if the expression couldn't be compiled
+    void* code;
+    u64   code_size;
+    u32   scratch_size;
+};
+
+// Translates the expression to x86-64 machine code. Returns false if the JIT isn't supported
+// on this platform (or the expression is malformed), the interpreter should be used instead then.
+bool compile_jit(const DynamicArray<ExpressionElement>& expression, JitExpression& jit);
+
+void free(JitExpression& jit);
+
+} // namespace Calculator
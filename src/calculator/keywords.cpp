@@ -1,67 +1,76 @@
 #include "keywords.h"
 
+#include "containers/darray.h"
 #include "containers/hash.h"
+#include "containers/hash_table.h"
 #include "containers/function.h"
 #include "containers/string.h"
+#include "core/logger.h"
 #include "core/types.h"
-#include "math/constants.h"
 #include "token.h"
 #include "opdef.h"
+#include "solver.h"
 
 namespace Calculator
 {
 
 const KeywordData keyword_table[] =
 {
-    // Constants
-    KeywordData(ref("pi"),     Math::PI),
-    KeywordData(ref("e"),      Math::E),
+    // Constants (the f32 ones in math/constants.h would only be right to 7 digits)
+    KeywordData(ref("pi"),     3.141592653589793),
+    KeywordData(ref("e"),      2.718281828459045),
     KeywordData(ref("true"),   true),
     KeywordData(ref("false"),  false),
 
     // Operators
-    KeywordData(ref("-"), NEG, 1, 0),
-
-    KeywordData(ref("sqrt"), SQRT,      1, 1),
-    KeywordData(ref("exp"),  EXP,       1, 1),
-    KeywordData(ref("*"),    MULTIPLY,  2, 1),
-    KeywordData(ref("/"),    DIVIDE,    2, 1),
-    KeywordData(ref("%"),    REMAINDER, 2, 1),
-    KeywordData(ref("^"),    POW,       2, 1),
-
-    KeywordData(ref("+"), ADD,      2, 2),
-    KeywordData(ref("-"), SUBTRACT, 2, 2),
-
-    KeywordData(ref("=="), EQUAL,         2, 3),
-    KeywordData(ref(">"),  GREATER,       2, 3),
-    KeywordData(ref(">="), GREATER_EQUAL, 2, 3),
-    KeywordData(ref("<"),  LESSER,        2, 3),
-    KeywordData(ref("<="), LESSER_EQUAL,  2, 3),
-
-    KeywordData(ref("!"),   NOT, 1, 4),
-    KeywordData(ref("not"), NOT, 1, 4),
-    KeywordData(ref("&&"),  AND, 2, 4),
-    KeywordData(ref("and"), AND, 2, 4),
-    KeywordData(ref("||"),  OR,  2, 4),
-    KeywordData(ref("or"),  OR,  2, 4),
-
-    KeywordData(ref("ln"),  NATURAL_LOG, 1, 5),
-    KeywordData(ref("log"), LOG,         1, 5),
-
-    KeywordData(ref("sin"),   SIN,   1, 6),
-    KeywordData(ref("cos"),   COS,   1, 6),
-    KeywordData(ref("tan"),   TAN,   1, 6),
-    KeywordData(ref("sec"),   SEC,   1, 6),
-    KeywordData(ref("cosec"), COSEC, 1, 6),
-    KeywordData(ref("cot"),   COT,   1, 6),
-    KeywordData(ref("sinh"),  SINH,  1, 6),
-    KeywordData(ref("cosh"),  COSH,  1, 6),
-    KeywordData(ref("tanh"),  TANH,  1, 6),
-
-    KeywordData(ref("max"), MAX, 2, 7),
-    KeywordData(ref("min"), MIN, 2, 7),
-
-    KeywordData(ref("if"), COND, 3, 8),
+    KeywordData(ref("-"), NEG, OperatorCode::NEG, 1, 0),
+
+    KeywordData(ref("sqrt"), SQRT,      OperatorCode::SQRT,      1, 1),
+    KeywordData(ref("exp"),  EXP,       OperatorCode::EXP,       1, 1),
+    KeywordData(ref("*"),    MULTIPLY,  OperatorCode::MULTIPLY,  2, 1),
+    KeywordData(ref("/"),    DIVIDE,    OperatorCode::DIVIDE,    2, 1),
+    KeywordData(ref("%"),    REMAINDER, OperatorCode::REMAINDER, 2, 1),
+    KeywordData(ref("^"),    POW,       OperatorCode::POW,       2, 1),
+
+    KeywordData(ref("+"), ADD,      OperatorCode::ADD,      2, 2),
+    KeywordData(ref("-"), SUBTRACT, OperatorCode::SUBTRACT, 2, 2),
+
+    KeywordData(ref("=="), EQUAL,         OperatorCode::EQUAL,         2, 3),
+    KeywordData(ref("!="), NOT_EQUAL,     OperatorCode::NOT_EQUAL,     2, 3),
+    KeywordData(ref(">"),  GREATER,       OperatorCode::GREATER,       2, 3),
+    KeywordData(ref(">="), GREATER_EQUAL, OperatorCode::GREATER_EQUAL, 2, 3),
+    KeywordData(ref("<"),  LESSER,        OperatorCode::LESSER,        2, 3),
+    KeywordData(ref("<="), LESSER_EQUAL,  OperatorCode::LESSER_EQUAL,  2, 3),
+
+    KeywordData(ref("!"),   NOT, OperatorCode::NOT, 1, 4),
+    KeywordData(ref("not"), NOT, OperatorCode::NOT, 1, 4),
+    KeywordData(ref("&&"),  AND, OperatorCode::AND, 2, 4),
+    KeywordData(ref("and"), AND, OperatorCode::AND, 2, 4),
+    KeywordData(ref("||"),  OR,  OperatorCode::OR,  2, 4),
+    KeywordData(ref("or"),  OR,  OperatorCode::OR,  2, 4),
+
+    KeywordData(ref("ln"),  NATURAL_LOG, OperatorCode::NATURAL_LOG, 1, 5),
+    KeywordData(ref("log"), LOG,         OperatorCode::LOG,         2, 5),
+
+    KeywordData(ref("sin"),   SIN,   OperatorCode::SIN,   1, 6),
+    KeywordData(ref("cos"),   COS,   OperatorCode::COS,   1, 6),
+    KeywordData(ref("tan"),   TAN,   OperatorCode::TAN,   1, 6),
+    KeywordData(ref("sec"),   SEC,   OperatorCode::SEC,   1, 6),
+    KeywordData(ref("cosec"), COSEC, OperatorCode::COSEC, 1, 6),
+    KeywordData(ref("cot"),   COT,   OperatorCode::COT,   1, 6),
+    KeywordData(ref("sinh"),  SINH,  OperatorCode::SINH,  1, 6),
+    KeywordData(ref("cosh"),  COSH,  OperatorCode::COSH,  1, 6),
+    KeywordData(ref("tanh"),  TANH,  OperatorCode::TANH,  1, 6),
+
+    KeywordData(ref("max"), MAX, OperatorCode::MAX, 2, 7),
+    KeywordData(ref("min"), MIN, OperatorCode::MIN, 2, 7),
+
+    KeywordData(ref("if"), COND, OperatorCode::COND, 3, 8),
+
+    // Aggregates
+    KeywordData(ref("sum"),  Aggregate::SUM),
+    KeywordData(ref("mean"), Aggregate::MEAN),
+    KeywordData(ref("dot"),  Aggregate::DOT),
 
     // Empty (to find end of list)
     KeywordData()
@@ -69,4 +78,301 @@ const KeywordData keyword_table[] =
 
 const u32 keyword_table_size = sizeof(keyword_table) / sizeof(KeywordData);
 
+// The first keyword for each operator code is the one that goes in the table
+static OperatorTable build_operator_table()
+{
+    OperatorTable table = {};
+    bool found[(u32) OperatorCode::COUNT] = {};
+
+    for (u32 i = 0; i < keyword_table_size; i++)
+    {
+        const KeywordData& keyword = keyword_table[i];
+        if (keyword.type != KeywordData::Type::OPERATOR || found[(u32) keyword.op_data.code])
+            continue;
+
+        table.operators[(u32) keyword.op_data.code] = keyword.op_data;
+        found[(u32) keyword.op_data.code] = true;
+    }
+
+    for (u32 i = 0; i < (u32) OperatorCode::COUNT; i++)
+        gn_assert_with_message(found[i], "Operator code % has no keyword!", i);
+
+    return table;
+}
+
+const OperatorTable operator_table = build_operator_table();
+
+// Keywords are looked up with a trie built from keyword_table when the program starts.
+// Characters are mapped to a small alphabet (only the ones used in keywords) to keep the nodes small.
+
+constexpr u32 KEYWORD_TRIE_MAX_NODES     = 256;
+constexpr u32 KEYWORD_TRIE_ALPHABET_SIZE = 64;
+constexpr u8  KEYWORD_TRIE_NONE          = 0xFF;
+
+struct KeywordTrie
+{
+    struct Node
+    {
+        u8 children[KEYWORD_TRIE_ALPHABET_SIZE];    // Index of child node (0 is the root so it means no child)
+        u8 keyword;                                 // Keyword that ends here
+        u8 keyword_without_neg;                     // Keyword that ends here when negation is not allowed
+    };
+
+    u8   char_to_letter[256];   // 0 means the character isn't used by any keyword
+    Node nodes[KEYWORD_TRIE_MAX_NODES];
+    u32  node_count;
+    u32  letter_count;
+};
+
+static KeywordTrie build_keyword_trie()
+{
+    static_assert(sizeof(keyword_table) / sizeof(KeywordData) < KEYWORD_TRIE_NONE, "Keyword indices don't fit in the trie!");
+
+    KeywordTrie trie = {};
+
+    // Node 0 is the root and letter 0 is for characters that aren't in any keyword
+    trie.node_count = 1;
+    trie.letter_count = 1;
+    trie.nodes[0].keyword = trie.nodes[0].keyword_without_neg = KEYWORD_TRIE_NONE;
+
+    for (u32 i = 0; i < keyword_table_size; i++)
+    {
+        const KeywordData& keyword = keyword_table[i];
+        if (keyword.type == KeywordData::Type::EMPTY)
+            continue;
+
+        u32 node = 0;
+        for (u64 j = 0; j < keyword.str.size; j++)
+        {
+            const u8 ch = (u8) keyword.str[j];
+
+            if (trie.char_to_letter[ch] == 0)
+            {
+                gn_assert_with_message(trie.letter_count < KEYWORD_TRIE_ALPHABET_SIZE, "Too many different characters in keywords for the trie!");
+                trie.char_to_letter[ch] = (u8) trie.letter_count++;
+            }
+
+            const u8 letter = trie.char_to_letter[ch];
+            if (trie.nodes[node].children[letter] == 0)
+            {
+                gn_assert_with_message(trie.node_count < KEYWORD_TRIE_MAX_NODES, "Too many nodes in keyword trie!");
+
+                const u32 child = trie.node_count++;
+                trie.nodes[child].keyword = trie.nodes[child].keyword_without_neg = KEYWORD_TRIE_NONE;
+                trie.nodes[node].children[letter] = (u8) child;
+            }
+
+            node = trie.nodes[node].children[letter];
+        }
+
+        // Earlier keywords win if multiple keywords have the same spelling (like negation and subtraction)
+        KeywordTrie::Node& end = trie.nodes[node];
+        if (end.keyword == KEYWORD_TRIE_NONE)
+            end.keyword = (u8) i;
+
+        const bool is_neg = keyword.type == KeywordData::Type::OPERATOR && keyword.op_data.precedence == 0;
+        if (!is_neg && end.keyword_without_neg == KEYWORD_TRIE_NONE)
+            end.keyword_without_neg = (u8) i;
+    }
+
+    return trie;
+}
+
+static const KeywordTrie keyword_trie = build_keyword_trie();
+
+u32 find_keyword(const String str, bool allow_neg)
+{
+    u32 match = keyword_table_size - 1;
+    u32 node = 0;
+
+    for (u64 i = 0; i < str.size; i++)
+    {
+        const u8 letter = keyword_trie.char_to_letter[(u8) str.data[i]];
+        node = keyword_trie.nodes[node].children[letter];
+
+        // Letter 0 (not in any keyword) never has a child
+        if (node == 0)
+            break;
+
+        const KeywordTrie::Node& current = keyword_trie.nodes[node];
+        const u8 keyword = allow_neg ? current.keyword : current.keyword_without_neg;
+
+        // The longest matching keyword is considered the correct one
+        if (keyword != KEYWORD_TRIE_NONE)
+            match = keyword;
+    }
+
+    return match;
+}
+
+String operator_name(OperatorCode code)
+{
+    for (u32 i = 0; i < keyword_table_size; i++)
+    {
+        if (keyword_table[i].type == KeywordData::Type::OPERATOR && keyword_table[i].op_data.code == code)
+            return keyword_table[i].str;
+    }
+
+    return ref("function");
+}
+
+// User functions are looked up by name when an identifier doesn't match a variable
+static HashTable<String, UserFunction> user_functions = {};
+
+inline static bool is_identifier_start(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+}
+
+inline static bool is_identifier_char(char ch)
+{
+    return is_identifier_start(ch) || (ch >= '0' && ch <= '9');
+}
+
+inline static void skip_whitespace(const String str, u64& index)
+{
+    while (index < str.size && (str[index] == ' ' || str[index] == '\t' || str[index] == '\r' || str[index] == '\n'))
+        index++;
+}
+
+// Returns an empty string if there is no identifier at index
+static String read_identifier(const String str, u64& index)
+{
+    skip_whitespace(str, index);
+
+    const u64 start = index;
+    if (index < str.size && is_identifier_start(str[index]))
+    {
+        while (index < str.size && is_identifier_char(str[index]))
+            index++;
+    }
+
+    return get_substring(str, start, index - start);
+}
+
+bool define_function(const String definition)
+{
+    u64 index = 0;
+
+    const String name = read_identifier(definition, index);
+    if (name.size == 0)
+    {
+        print_error("Definition should start with a name!\n");
+        return false;
+    }
+
+    // Built in keywords can't be replaced
+    const KeywordData& keyword = keyword_table[find_keyword(name, true)];
+    if (keyword.type != KeywordData::Type::EMPTY && keyword.str.size == name.size)
+    {
+        print_error("\"%\" is already a keyword!\n", name);
+        return false;
+    }
+
+    String parameters[USER_FUNCTION_MAX_PARAMETERS];
+    u32 parameter_count = 0;
+
+    skip_whitespace(definition, index);
+    if (index < definition.size && definition[index] == '(')
+    {
+        index++;
+
+        while (true)
+        {
+            const String parameter = read_identifier(definition, index);
+            if (parameter.size == 0)
+            {
+                print_error("Expected a parameter name in the definition of \"%\"!\n", name);
+                return false;
+            }
+
+            for (u32 i = 0; i < parameter_count; i++)
+            {
+                if (parameters[i] == parameter)
+                {
+                    print_error("Parameter \"%\" is used twice in the definition of \"%\"!\n", parameter, name);
+                    return false;
+                }
+            }
+
+            if (parameter_count == USER_FUNCTION_MAX_PARAMETERS)
+            {
+                print_error("Functions can have at most % parameters!\n", USER_FUNCTION_MAX_PARAMETERS);
+                return false;
+            }
+
+            parameters[parameter_count++] = parameter;
+
+            skip_whitespace(definition, index);
+            if (index < definition.size && definition[index] == ',')
+            {
+                index++;
+                continue;
+            }
+
+            if (index < definition.size && definition[index] == ')')
+            {
+                index++;
+                break;
+            }
+
+            print_error("Expected ',' or ')' after parameter \"%\"!\n", parameter);
+            return false;
+        }
+
+        skip_whitespace(definition, index);
+    }
+
+    // "==" is comparison
+    if (index >= definition.size || definition[index] != '=' || (index + 1 < definition.size && definition[index + 1] == '='))
+    {
+        print_error("Expected '=' after \"%\" in the definition!\n", name);
+        return false;
+    }
+
+    const String body = get_substring(definition, index + 1);
+
+    DynamicArray<ExpressionElement> elements = make<DynamicArray<ExpressionElement>>(max(body.size / 2, 4Ui64));
+    DynamicArray<OperatorOrBracket> op_stack = make<DynamicArray<OperatorOrBracket>>(16Ui64);
+
+    const bool valid = infix_expression_to_postfix(body, elements, op_stack, parameters, parameter_count);
+
+    free(op_stack);
+
+    if (!valid)
+    {
+        print_error("Could not parse the body of \"%\"!\n", name);
+        free(elements);
+        return false;
+    }
+
+    if (user_functions.capacity == 0)
+        user_functions = make<HashTable<String, UserFunction>>();
+
+    HashTableElement<String, UserFunction> existing = find(user_functions, name);
+    if (existing)
+    {
+        free(existing.value().body);
+        existing.value() = UserFunction { elements, parameter_count };
+        return true;
+    }
+
+    put(user_functions, copy(name), UserFunction { elements, parameter_count });
+    return true;
+}
+
+const UserFunction* find_user_function(const String name)
+{
+    if (user_functions.filled == 0)
+        return nullptr;
+
+    const HashTableElement<String, UserFunction> element = find(user_functions, name);
+    return element ? &element.value() : nullptr;
+}
+
+u32 user_function_count()
+{
+    return user_functions.filled;
+}
+
 } // namespace Calculator
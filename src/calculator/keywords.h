@@ -1,5 +1,6 @@
 #pragma once
 
+#include "containers/darray.h"
 #include "containers/hash.h"
 #include "containers/function.h"
 #include "containers/string.h"
@@ -15,6 +16,7 @@ struct KeywordData
     {
         CONSTANT,
         OPERATOR,
+        AGGREGATE,
         EMPTY
     };
 
@@ -29,6 +31,9 @@ struct KeywordData
 
         // Operator
         const Operator op_data;
+
+        // Aggregate
+        const Aggregate aggregate;
     };
 
     KeywordData()
@@ -42,9 +47,15 @@ struct KeywordData
     {
     }
 
-    KeywordData(const String str, Operation operation, u32 operand_count, u32 precedence)
+    KeywordData(const String str, Operation operation, OperatorCode code, u32 operand_count, u32 precedence)
     :   type(Type::OPERATOR), str(str), hash(Hasher<String>()(str))
-    ,   op_data({ operation, operand_count, precedence })
+    ,   op_data({ operation, operand_count, precedence, code })
+    {
+    }
+
+    KeywordData(const String str, Aggregate aggregate)
+    :   type(Type::AGGREGATE), str(str), hash(Hasher<String>()(str))
+    ,   aggregate(aggregate)
     {
     }
 };
@@ -52,4 +63,35 @@ struct KeywordData
 extern const KeywordData keyword_table[];
 extern const u32 keyword_table_size;
 
+// Returns the index of the longest keyword at the start of str in a single pass over its characters.
+// Returns the index of the empty keyword (last in the table) if nothing matches.
+// Negation is only matched if allow_neg is true (otherwise '-' is subtraction).
+u32 find_keyword(const String str, bool allow_neg);
+
+// Returns how the operator is written (the first keyword for it), "function" for user function calls
+String operator_name(OperatorCode code);
+
+constexpr u32 USER_FUNCTION_MAX_PARAMETERS = 16;
+
+// Calls copy their arguments for every use of the parameter, so nested calls like f(f(f(x))) with
+// f(x) = x*x double in size at every level. A single call can add at most this many elements.
+constexpr u64 USER_FUNCTION_MAX_GROWTH = 1 << 16;
+
+// Function defined at runtime, calls are replaced with the body when expressions are tokenized
+struct UserFunction
+{
+    DynamicArray<ExpressionElement> body;   // Postfix, the parameters are variables 0 to parameter_count - 1
+    u32 parameter_count;                    // 0 for a named value like "a = 2 * pi"
+};
+
+// Parses a definition like "f(x, y) = x*x + y" or "a = 2 * pi" and adds it to the user functions, replacing
+// any function with the same name. The body can call functions defined before it. Prints why on failure.
+// Functions should be defined before expressions are tokenized on other threads.
+bool define_function(const String definition);
+
+// Returns the user function with exactly this name, nullptr if there is none
+const UserFunction* find_user_function(const String name);
+
+u32 user_function_count();
+
 } // namespace Calculator
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "core/compiler_utils.h"
+#include "core/types.h"
+
+// SIMD lanes of f64 used by the column solver and the vector math functions.
+// AVX is only used if the compiler is allowed to generate it (/arch:AVX or /arch:AVX2 on MSVC).
+#if defined(__AVX2__) || defined(__AVX__)
+    #include <immintrin.h>
+    #define CALCULATOR_LANES_AVX
+#else
+    #include <emmintrin.h>
+#endif
+
+namespace Calculator
+{
+
+#ifdef CALCULATOR_LANES_AVX
+
+using Lane = __m256d;
+constexpr u64 LANE_WIDTH = 4;
+
+GN_FORCE_INLINE static Lane lane_load(const f64* ptr)      { return _mm256_loadu_pd(ptr); }
+GN_FORCE_INLINE static void lane_store(f64* ptr, Lane a)   { _mm256_storeu_pd(ptr, a); }
+GN_FORCE_INLINE static Lane lane_set(f64 value)            { return _mm256_set1_pd(value); }
+
+GN_FORCE_INLINE static Lane lane_add(Lane a, Lane b)  { return _mm256_add_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_sub(Lane a, Lane b)  { return _mm256_sub_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_mul(Lane a, Lane b)  { return _mm256_mul_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_div(Lane a, Lane b)  { return _mm256_div_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_max(Lane a, Lane b)  { return _mm256_max_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_min(Lane a, Lane b)  { return _mm256_min_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_sqrt(Lane a)         { return _mm256_sqrt_pd(a); }
+GN_FORCE_INLINE static Lane lane_and(Lane a, Lane b)  { return _mm256_and_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_or(Lane a, Lane b)   { return _mm256_or_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_xor(Lane a, Lane b)  { return _mm256_xor_pd(a, b); }
+
+GN_FORCE_INLINE static Lane lane_greater(Lane a, Lane b)        { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+GN_FORCE_INLINE static Lane lane_lesser(Lane a, Lane b)         { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+GN_FORCE_INLINE static Lane lane_greater_equal(Lane a, Lane b)  { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+GN_FORCE_INLINE static Lane lane_lesser_equal(Lane a, Lane b)   { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+GN_FORCE_INLINE static Lane lane_equal(Lane a, Lane b)          { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+GN_FORCE_INLINE static Lane lane_not_equal(Lane a, Lane b)      { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+
+// Picks a where the mask is set and b everywhere else
+GN_FORCE_INLINE static Lane lane_select(Lane mask, Lane a, Lane b) { return _mm256_blendv_pd(b, a, mask); }
+
+// Bit i is set if the mask is set in lane i
+GN_FORCE_INLINE static u32 lane_mask_bits(Lane mask) { return (u32) _mm256_movemask_pd(mask); }
+
+// Shifts the bits of every lane (as a 64 bit integer) so the exponent field moves to the bottom or back.
+// AVX only has 256 bit integer shifts with AVX2, without it each half is shifted on its own.
+#ifdef __AVX2__
+GN_FORCE_INLINE static Lane lane_shift_exponent_down(Lane a) { return _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(a), 52)); }
+GN_FORCE_INLINE static Lane lane_shift_exponent_up(Lane a)   { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a), 52)); }
+#else
+GN_FORCE_INLINE static Lane lane_shift_exponent_down(Lane a)
+{
+    const __m128i low  = _mm_srli_epi64(_mm_castpd_si128(_mm256_castpd256_pd128(a)), 52);
+    const __m128i high = _mm_srli_epi64(_mm_castpd_si128(_mm256_extractf128_pd(a, 1)), 52);
+    return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_castsi128_pd(low)), _mm_castsi128_pd(high), 1);
+}
+
+GN_FORCE_INLINE static Lane lane_shift_exponent_up(Lane a)
+{
+    const __m128i low  = _mm_slli_epi64(_mm_castpd_si128(_mm256_castpd256_pd128(a)), 52);
+    const __m128i high = _mm_slli_epi64(_mm_castpd_si128(_mm256_extractf128_pd(a, 1)), 52);
+    return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_castsi128_pd(low)), _mm_castsi128_pd(high), 1);
+}
+#endif // __AVX2__
+
+#else
+
+using Lane = __m128d;
+constexpr u64 LANE_WIDTH = 2;
+
+GN_FORCE_INLINE static Lane lane_load(const f64* ptr)      { return _mm_loadu_pd(ptr); }
+GN_FORCE_INLINE static void lane_store(f64* ptr, Lane a)   { _mm_storeu_pd(ptr, a); }
+GN_FORCE_INLINE static Lane lane_set(f64 value)            { return _mm_set1_pd(value); }
+
+GN_FORCE_INLINE static Lane lane_add(Lane a, Lane b)  { return _mm_add_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_sub(Lane a, Lane b)  { return _mm_sub_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_mul(Lane a, Lane b)  { return _mm_mul_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_div(Lane a, Lane b)  { return _mm_div_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_max(Lane a, Lane b)  { return _mm_max_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_min(Lane a, Lane b)  { return _mm_min_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_sqrt(Lane a)         { return _mm_sqrt_pd(a); }
+GN_FORCE_INLINE static Lane lane_and(Lane a, Lane b)  { return _mm_and_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_or(Lane a, Lane b)   { return _mm_or_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_xor(Lane a, Lane b)  { return _mm_xor_pd(a, b); }
+
+GN_FORCE_INLINE static Lane lane_greater(Lane a, Lane b)        { return _mm_cmpgt_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_lesser(Lane a, Lane b)         { return _mm_cmplt_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_greater_equal(Lane a, Lane b)  { return _mm_cmpge_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_lesser_equal(Lane a, Lane b)   { return _mm_cmple_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_equal(Lane a, Lane b)          { return _mm_cmpeq_pd(a, b); }
+GN_FORCE_INLINE static Lane lane_not_equal(Lane a, Lane b)      { return _mm_cmpneq_pd(a, b); }
+
+// Picks a where the mask is set and b everywhere else
+GN_FORCE_INLINE static Lane lane_select(Lane mask, Lane a, Lane b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+
+// Bit i is set if the mask is set in lane i
+GN_FORCE_INLINE static u32 lane_mask_bits(Lane mask) { return (u32) _mm_movemask_pd(mask); }
+
+// Shifts the bits of every lane (as a 64 bit integer) so the exponent field moves to the bottom or back
+GN_FORCE_INLINE static Lane lane_shift_exponent_down(Lane a) { return _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(a), 52)); }
+GN_FORCE_INLINE static Lane lane_shift_exponent_up(Lane a)   { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(a), 52)); }
+
+#endif // CALCULATOR_LANES_AVX
+
+// Comparison masks are turned into 1.0 or 0.0
+GN_FORCE_INLINE static Lane lane_mask_to_bool(Lane mask) { return lane_and(mask, lane_set(1.0)); }
+
+} // namespace Calculator
@@ -0,0 +1,183 @@
+#include "numeric_solver.h"
+
+#include <cstdio>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/float_format.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "decimal.h"
+#include "double_double.h"
+#include "error.h"
+#include "float_parser.h"
+#include "keywords.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+bool parse_numeric_type(const String name, NumericType& type)
+{
+    if (name == ref("f64"))
+        type = NumericType::F64;
+    else if (name == ref("dd"))
+        type = NumericType::DOUBLE_DOUBLE;
+    else if (name == ref("decimal"))
+        type = NumericType::DECIMAL;
+    else
+        return false;
+
+    return true;
+}
+
+enum struct SourceKind
+{
+    DIGITS,
+    PI,
+    E,
+    OTHER,
+};
+
+// Finds what the number at offset was written as, digits are copied to a null terminated string
+static SourceKind read_source(const String expression, u32 offset, String& digits)
+{
+    const char first = expression[offset];
+    if ((first >= '0' && first <= '9') || first == '.')
+    {
+        // Hex numbers are integers, f64 already has all their bits unless they are huge
+        if (first == '0' && offset + 1 < expression.size && (expression[offset + 1] | 0x20) == 'x')
+            return SourceKind::OTHER;
+
+        f64 value;
+        const u64 size = parse_f64(expression.data + offset, expression.size - offset, value);
+
+        digits = make<String>((const char*) expression.data + offset, (int) size);
+        digits.data[size] = '\0';
+        return SourceKind::DIGITS;
+    }
+
+    const String name = keyword_table[find_keyword(get_substring(expression, offset), true)].str;
+    if (name == ref("pi"))
+        return SourceKind::PI;
+    if (name == ref("e"))
+        return SourceKind::E;
+
+    return SourceKind::OTHER;
+}
+
+template <>
+DoubleDouble numeric_from_source(const String expression, u32 offset, f64 value)
+{
+    String digits = {};
+    switch (read_source(expression, offset, digits))
+    {
+        case SourceKind::DIGITS:
+        {
+            const DoubleDouble result = double_double_from_string(digits.data);
+            free(digits);
+            return result;
+        }
+
+        case SourceKind::PI: return double_double_pi();
+        case SourceKind::E:  return double_double_e();
+        default:             return double_double_from_f64(value);
+    }
+}
+
+template <>
+Decimal numeric_from_source(const String expression, u32 offset, f64 value)
+{
+    String digits = {};
+    switch (read_source(expression, offset, digits))
+    {
+        case SourceKind::DIGITS:
+        {
+            const Decimal result = decimal_from_string(digits.data);
+            free(digits);
+            return result;
+        }
+
+        case SourceKind::PI: return decimal_pi();
+        case SourceKind::E:  return decimal_e();
+        default:             return decimal_from_f64(value);
+    }
+}
+
+template <typename T>
+static bool solve_and_print(const String expression, const DynamicArray<ExpressionElement>& elements, FILE* output, ExpressionError& error)
+{
+    DynamicArray<T> constants    = make<DynamicArray<T>>(elements.size);
+    DynamicArray<T> number_stack = make<DynamicArray<T>>(16Ui64);
+
+    convert_constants(elements, expression, constants);
+    const T result = solve_postfix_numeric(elements, constants, number_stack, (const T*) nullptr, error);
+
+    if (error.code == ErrorCode::NONE)
+        print_to_file(output, "Result: %\n", result);
+
+    free(number_stack);
+    free(constants);
+
+    return error.code == ErrorCode::NONE;
+}
+
+bool solve_numeric(const String expression, NumericType type, u32 decimal_digits, FILE* output, ExpressionError& error)
+{
+    // Numbers keep their source so they can be parsed with the precision of the type
+    DynamicArray<ExpressionElement> elements = {};
+    DynamicArray<OperatorOrBracket> temp_op_stack = make<DynamicArray<OperatorOrBracket>>(32Ui64);
+
+    const bool tokenized = infix_expression_to_postfix(expression, elements, temp_op_stack, error, nullptr, 0, true);
+    free(temp_op_stack);
+
+    if (!tokenized)
+    {
+        free(elements);
+        return false;
+    }
+
+    bool success = true;
+
+    switch (type)
+    {
+        case NumericType::F64:
+        {
+            // Printed with all the digits needed to get the same f64 back
+            char buffer[32];
+            DynamicArray<f64> constants    = make<DynamicArray<f64>>(elements.size);
+            DynamicArray<f64> number_stack = make<DynamicArray<f64>>(16Ui64);
+
+            convert_constants(elements, constants);
+            const f64 result = solve_postfix_numeric(elements, constants, number_stack, (const f64*) nullptr, error);
+
+            success = (error.code == ErrorCode::NONE);
+            if (success)
+            {
+                to_shortest_chars(result, buffer, sizeof(buffer));
+                print_to_file(output, "Result: %\n", buffer);
+            }
+
+            free(number_stack);
+            free(constants);
+        } break;
+
+        case NumericType::DOUBLE_DOUBLE:
+            success = solve_and_print<DoubleDouble>(expression, elements, output, error);
+            break;
+
+        case NumericType::DECIMAL:
+        {
+            const u32 previous_digits = get_decimal_precision();
+            set_decimal_precision(decimal_digits);
+
+            success = solve_and_print<Decimal>(expression, elements, output, error);
+
+            set_decimal_precision(previous_digits);
+        } break;
+    }
+
+    free(elements);
+    return success;
+}
+
+} // namespace Calculator
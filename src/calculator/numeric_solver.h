@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdio>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "decimal.h"
+#include "double_double.h"
+#include "error.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Number types the expression can be solved with, from fastest to most precise
+enum struct NumericType
+{
+    F64,
+    DOUBLE_DOUBLE,
+    DECIMAL,
+};
+
+// The f64 versions of the operators are the ones in opdef.h
+inline f64 apply_operator(const Operator& op, const f64 operands[])
+{
+    return op.operation((f64*) operands);
+}
+
+template <typename T>
+T numeric_from_f64(f64 value);
+
+template <>
+inline f64 numeric_from_f64(f64 value)
+{
+    return value;
+}
+
+template <>
+inline DoubleDouble numeric_from_f64(f64 value)
+{
+    return double_double_from_f64(value);
+}
+
+template <>
+inline Decimal numeric_from_f64(f64 value)
+{
+    return decimal_from_f64(value);
+}
+
+// Parses the number or constant written at offset in the expression with the precision of T, pi and e are the
+// constants of T instead of their f64 values. Anything else (hex numbers, true and false) is converted from value.
+template <typename T>
+T numeric_from_source(const String expression, u32 offset, f64 value);
+
+template <>
+inline f64 numeric_from_source(const String expression, u32 offset, f64 value)
+{
+    return value;
+}
+
+template <>
+DoubleDouble numeric_from_source(const String expression, u32 offset, f64 value);
+
+template <>
+Decimal numeric_from_source(const String expression, u32 offset, f64 value);
+
+// Converts the numbers in the expression once so they don't have to be converted every time it's solved.
+// Constants are indexed like the elements of the expression.
+template <typename T>
+void convert_constants(const DynamicArray<ExpressionElement>& expression, DynamicArray<T>& constants)
+{
+    clear(constants);
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        const ExpressionElement& element = expression[i];
+        append(constants, (element.type == ExpressionElement::Type::NUMBER) ? numeric_from_f64<T>(element.value) : T {});
+    }
+}
+
+// Same as above, but numbers that kept their source (see infix_expression_to_postfix) are parsed again from
+// the text so they aren't rounded to f64 first
+template <typename T>
+void convert_constants(const DynamicArray<ExpressionElement>& expression, const String text, DynamicArray<T>& constants)
+{
+    clear(constants);
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        const ExpressionElement& element = expression[i];
+        if (element.type != ExpressionElement::Type::NUMBER)
+            append(constants, T {});
+        else if (element.source != 0)
+            append(constants, numeric_from_source<T>(text, element.source - 1, element.value));
+        else
+            append(constants, numeric_from_f64<T>(element.value));
+    }
+}
+
+// Same as solve_postfix_data but with the numbers and operators of type T. Malformed expressions return NaN
+// and say why in error.
+template <typename T>
+T solve_postfix_numeric(const DynamicArray<ExpressionElement>& expression, const DynamicArray<T>& constants, DynamicArray<T>& number_stack, const T variables[],
+                        ExpressionError& error)
+{
+    clear(number_stack);
+    error.code = ErrorCode::NONE;
+
+    T operands[3];  // Max operand count in functions is 3
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        switch (expression[i].type)
+        {
+            case ExpressionElement::Type::NUMBER:
+            {
+                append(number_stack, constants[i]);
+            } break;
+
+            case ExpressionElement::Type::VARIABLE:
+            {
+                gn_assert_with_message(variables, "Expression uses variables but no values were given for them! (variable index: %)", expression[i].variable.index);
+                append(number_stack, variables[expression[i].variable.index]);
+            } break;
+
+            case ExpressionElement::Type::OPERATOR:
+            {
+                const Operator& op = get_operator(expression[i].op_code);
+
+                if (op.operand_count > number_stack.size)
+                {
+                    error = ExpressionError { ErrorCode::MISSING_OPERAND, (u32) i, op.code };
+                    return numeric_from_f64<T>(NAN);
+                }
+
+                number_stack.size -= op.operand_count;
+                for (u32 j = 0; j < op.operand_count; j++)
+                    operands[j] = number_stack.data[number_stack.size + j];
+
+                append(number_stack, apply_operator(op, operands));
+            } break;
+        }
+    }
+
+    if (number_stack.size != 1)
+    {
+        const ErrorCode code = (number_stack.size == 0) ? ErrorCode::EMPTY_EXPRESSION : ErrorCode::EXTRA_VALUES;
+        error = ExpressionError { code, (u32) expression.size, OperatorCode::COUNT };
+        return numeric_from_f64<T>(NAN);
+    }
+
+    return number_stack[0];
+}
+
+// Parses "f64", "dd" (double-double) or "decimal". Returns false if the name doesn't match any of them.
+bool parse_numeric_type(const String name, NumericType& type);
+
+// Solves the expression with the numeric type and prints the result. Decimal results are
+// computed and printed with decimal_digits significant digits. Returns false and says why in error
+// if the expression is malformed.
+bool solve_numeric(const String expression, NumericType type, u32 decimal_digits, FILE* output, ExpressionError& error);
+
+} // namespace Calculator
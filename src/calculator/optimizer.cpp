@@ -0,0 +1,191 @@
+#include "optimizer.h"
+
+#include "containers/darray.h"
+#include "core/types.h"
+#include "solver.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Describes a value on the stack while simulating the solver
+struct Subexpression
+{
+    u64  start;         // Index of the first element of the subexpression in the output
+    bool is_constant;   // Subexpression is a single number
+};
+
+inline static bool is_number(const ExpressionElement& element, f64 value)
+{
+    return element.type == ExpressionElement::Type::NUMBER && element.value == value;
+}
+
+// Moves elements to a lower index (ranges can overlap)
+inline static void move_elements(DynamicArray<ExpressionElement>& expression, u64 to, u64 from, u64 count)
+{
+    for (u64 i = 0; i < count; i++)
+        expression.data[to + i] = expression.data[from + i];
+}
+
+u64 optimize_postfix(DynamicArray<ExpressionElement>& expression)
+{
+    if (max_stack_depth(expression) == 0)
+        return 0;
+
+    const u64 original_size = expression.size;
+
+    DynamicArray<Subexpression> stack = make<DynamicArray<Subexpression>>(32Ui64);
+
+    // The output is never longer than the input, so it's written into the same array
+    u64 out = 0;
+
+    for (u64 i = 0; i < original_size; i++)
+    {
+        const ExpressionElement element = expression.data[i];
+
+        if (element.type != ExpressionElement::Type::OPERATOR)
+        {
+            const bool is_constant = (element.type == ExpressionElement::Type::NUMBER);
+            append(stack, Subexpression { out, is_constant });
+            expression.data[out++] = element;
+            continue;
+        }
+
+        const Operator& op = get_operator(element.op_code);
+        Subexpression* operands = stack.data + stack.size - op.operand_count;
+
+        bool all_constant = true;
+        for (u32 j = 0; j < op.operand_count; j++)
+            all_constant = all_constant && operands[j].is_constant;
+
+        // Fold constants by solving the operator right away
+        if (all_constant)
+        {
+            f64 values[3];  // Max operand count in functions is 3
+            for (u32 j = 0; j < op.operand_count; j++)
+                values[j] = expression.data[operands[j].start].value;
+
+            const u64 start = operands[0].start;
+            stack.size -= op.operand_count;
+
+            expression.data[start] = ExpressionElement(op.operation(values));
+            out = start + 1;
+
+            append(stack, Subexpression { start, true });
+            continue;
+        }
+
+        switch (op.code)
+        {
+            // x * 1 = 1 * x = x
+            case OperatorCode::MULTIPLY:
+            {
+                if (operands[1].is_constant && is_number(expression.data[operands[1].start], 1.0))
+                {
+                    out = operands[1].start;
+                    stack.size--;
+                    continue;
+                }
+
+                if (operands[0].is_constant && is_number(expression.data[operands[0].start], 1.0))
+                {
+                    const u64 start = operands[0].start;
+                    move_elements(expression, start, operands[1].start, out - operands[1].start);
+                    out--;
+
+                    stack.size -= 2;
+                    append(stack, Subexpression { start, false });
+                    continue;
+                }
+            } break;
+
+            // x + 0 = 0 + x = x (only differs in the sign when x is -0)
+            case OperatorCode::ADD:
+            {
+                if (operands[1].is_constant && is_number(expression.data[operands[1].start], 0.0))
+                {
+                    out = operands[1].start;
+                    stack.size--;
+                    continue;
+                }
+
+                if (operands[0].is_constant && is_number(expression.data[operands[0].start], 0.0))
+                {
+                    const u64 start = operands[0].start;
+                    move_elements(expression, start, operands[1].start, out - operands[1].start);
+                    out--;
+
+                    stack.size -= 2;
+                    append(stack, Subexpression { start, false });
+                    continue;
+                }
+            } break;
+
+            // x - 0 = x
+            case OperatorCode::SUBTRACT:
+            {
+                if (operands[1].is_constant && is_number(expression.data[operands[1].start], 0.0))
+                {
+                    out = operands[1].start;
+                    stack.size--;
+                    continue;
+                }
+            } break;
+
+            // x / 1 = x
+            case OperatorCode::DIVIDE:
+            {
+                if (operands[1].is_constant && is_number(expression.data[operands[1].start], 1.0))
+                {
+                    out = operands[1].start;
+                    stack.size--;
+                    continue;
+                }
+            } break;
+
+            // - -x = x
+            case OperatorCode::NEG:
+            {
+                const ExpressionElement& last = expression.data[out - 1];
+                if (last.type == ExpressionElement::Type::OPERATOR && last.op_code == OperatorCode::NEG)
+                {
+                    out--;
+                    continue;
+                }
+            } break;
+
+            // Only keep the branch that will be taken
+            case OperatorCode::COND:
+            {
+                if (operands[0].is_constant)
+                {
+                    const u64 start = operands[0].start;
+                    const bool condition = expression.data[start].value;
+
+                    const Subexpression taken = condition ? operands[1] : operands[2];
+                    const u64 taken_end = condition ? operands[2].start : out;
+
+                    move_elements(expression, start, taken.start, taken_end - taken.start);
+                    out = start + (taken_end - taken.start);
+
+                    stack.size -= 3;
+                    append(stack, Subexpression { start, taken.is_constant });
+                    continue;
+                }
+            } break;
+        }
+
+        const u64 start = operands[0].start;
+        stack.size -= op.operand_count;
+
+        expression.data[out++] = element;
+        append(stack, Subexpression { start, false });
+    }
+
+    expression.size = out;
+    free(stack);
+
+    return original_size - out;
+}
+
+} // namespace Calculator
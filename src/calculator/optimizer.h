@@ -0,0 +1,17 @@
+#pragma once
+
+#include "containers/darray.h"
+#include "core/types.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+// Simplifies the postfix expression in place:
+//  - Subexpressions that only use constants are replaced by their result
+//  - Identities like x * 1, x + 0 and - -x are removed
+//  - Branches of if that can never be taken (constant condition) are removed
+// Returns the number of elements that were removed. Malformed expressions are left untouched.
+u64 optimize_postfix(DynamicArray<ExpressionElement>& expression);
+
+} // namespace Calculator
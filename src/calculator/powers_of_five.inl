@@ -0,0 +1,656 @@
+// Generated table, don't edit by hand.
+// 128 bit approximations of 5^q for q from -342 to 308, normalized so the top bit is set. Powers
+// with negative exponents are rounded up and the rest are truncated (see Eisel-Lemire).
+static constexpr u64 powers_of_five[] = {
+    0xEEF453D6923BD65AUi64, 0x113FAA2906A13B3FUi64,   // 5^-342
+    0x9558B4661B6565F8Ui64, 0x4AC7CA59A424C507Ui64,   // 5^-341
+    0xBAAEE17FA23EBF76Ui64, 0x5D79BCF00D2DF649Ui64,   // 5^-340
+    0xE95A99DF8ACE6F53Ui64, 0xF4D82C2C107973DCUi64,   // 5^-339
+    0x91D8A02BB6C10594Ui64, 0x79071B9B8A4BE869Ui64,   // 5^-338
+    0xB64EC836A47146F9Ui64, 0x9748E2826CDEE284Ui64,   // 5^-337
+    0xE3E27A444D8D98B7Ui64, 0xFD1B1B2308169B25Ui64,   // 5^-336
+    0x8E6D8C6AB0787F72Ui64, 0xFE30F0F5E50E20F7Ui64,   // 5^-335
+    0xB208EF855C969F4FUi64, 0xBDBD2D335E51A935Ui64,   // 5^-334
+    0xDE8B2B66B3BC4723Ui64, 0xAD2C788035E61382Ui64,   // 5^-333
+    0x8B16FB203055AC76Ui64, 0x4C3BCB5021AFCC31Ui64,   // 5^-332
+    0xADDCB9E83C6B1793Ui64, 0xDF4ABE242A1BBF3DUi64,   // 5^-331
+    0xD953E8624B85DD78Ui64, 0xD71D6DAD34A2AF0DUi64,   // 5^-330
+    0x87D4713D6F33AA6BUi64, 0x8672648C40E5AD68Ui64,   // 5^-329
+    0xA9C98D8CCB009506Ui64, 0x680EFDAF511F18C2Ui64,   // 5^-328
+    0xD43BF0EFFDC0BA48Ui64, 0x0212BD1B2566DEF2Ui64,   // 5^-327
+    0x84A57695FE98746DUi64, 0x014BB630F7604B57Ui64,   // 5^-326
+    0xA5CED43B7E3E9188Ui64, 0x419EA3BD35385E2DUi64,   // 5^-325
+    0xCF42894A5DCE35EAUi64, 0x52064CAC828675B9Ui64,   // 5^-324
+    0x818995CE7AA0E1B2Ui64, 0x7343EFEBD1940993Ui64,   // 5^-323
+    0xA1EBFB4219491A1FUi64, 0x1014EBE6C5F90BF8Ui64,   // 5^-322
+    0xCA66FA129F9B60A6Ui64, 0xD41A26E077774EF6Ui64,   // 5^-321
+    0xFD00B897478238D0Ui64, 0x8920B098955522B4Ui64,   // 5^-320
+    0x9E20735E8CB16382Ui64, 0x55B46E5F5D5535B0Ui64,   // 5^-319
+    0xC5A890362FDDBC62Ui64, 0xEB2189F734AA831DUi64,   // 5^-318
+    0xF712B443BBD52B7BUi64, 0xA5E9EC7501D523E4Ui64,   // 5^-317
+    0x9A6BB0AA55653B2DUi64, 0x47B233C92125366EUi64,   // 5^-316
+    0xC1069CD4EABE89F8Ui64, 0x999EC0BB696E840AUi64,   // 5^-315
+    0xF148440A256E2C76Ui64, 0xC00670EA43CA250DUi64,   // 5^-314
+    0x96CD2A865764DBCAUi64, 0x380406926A5E5728Ui64,   // 5^-313
+    0xBC807527ED3E12BCUi64, 0xC605083704F5ECF2Ui64,   // 5^-312
+    0xEBA09271E88D976BUi64, 0xF7864A44C633682EUi64,   // 5^-311
+    0x93445B8731587EA3Ui64, 0x7AB3EE6AFBE0211DUi64,   // 5^-310
+    0xB8157268FDAE9E4CUi64, 0x5960EA05BAD82964Ui64,   // 5^-309
+    0xE61ACF033D1A45DFUi64, 0x6FB92487298E33BDUi64,   // 5^-308
+    0x8FD0C16206306BABUi64, 0xA5D3B6D479F8E056Ui64,   // 5^-307
+    0xB3C4F1BA87BC8696Ui64, 0x8F48A4899877186CUi64,   // 5^-306
+    0xE0B62E2929ABA83CUi64, 0x331ACDABFE94DE87Ui64,   // 5^-305
+    0x8C71DCD9BA0B4925Ui64, 0x9FF0C08B7F1D0B14Ui64,   // 5^-304
+    0xAF8E5410288E1B6FUi64, 0x07ECF0AE5EE44DD9Ui64,   // 5^-303
+    0xDB71E91432B1A24AUi64, 0xC9E82CD9F69D6150Ui64,   // 5^-302
+    0x892731AC9FAF056EUi64, 0xBE311C083A225CD2Ui64,   // 5^-301
+    0xAB70FE17C79AC6CAUi64, 0x6DBD630A48AAF406Ui64,   // 5^-300
+    0xD64D3D9DB981787DUi64, 0x092CBBCCDAD5B108Ui64,   // 5^-299
+    0x85F0468293F0EB4EUi64, 0x25BBF56008C58EA5Ui64,   // 5^-298
+    0xA76C582338ED2621Ui64, 0xAF2AF2B80AF6F24EUi64,   // 5^-297
+    0xD1476E2C07286FAAUi64, 0x1AF5AF660DB4AEE1Ui64,   // 5^-296
+    0x82CCA4DB847945CAUi64, 0x50D98D9FC890ED4DUi64,   // 5^-295
+    0xA37FCE126597973CUi64, 0xE50FF107BAB528A0Ui64,   // 5^-294
+    0xCC5FC196FEFD7D0CUi64, 0x1E53ED49A96272C8Ui64,   // 5^-293
+    0xFF77B1FCBEBCDC4FUi64, 0x25E8E89C13BB0F7AUi64,   // 5^-292
+    0x9FAACF3DF73609B1Ui64, 0x77B191618C54E9ACUi64,   // 5^-291
+    0xC795830D75038C1DUi64, 0xD59DF5B9EF6A2417Ui64,   // 5^-290
+    0xF97AE3D0D2446F25Ui64, 0x4B0573286B44AD1DUi64,   // 5^-289
+    0x9BECCE62836AC577Ui64, 0x4EE367F9430AEC32Ui64,   // 5^-288
+    0xC2E801FB244576D5Ui64, 0x229C41F793CDA73FUi64,   // 5^-287
+    0xF3A20279ED56D48AUi64, 0x6B43527578C1110FUi64,   // 5^-286
+    0x9845418C345644D6Ui64, 0x830A13896B78AAA9Ui64,   // 5^-285
+    0xBE5691EF416BD60CUi64, 0x23CC986BC656D553Ui64,   // 5^-284
+    0xEDEC366B11C6CB8FUi64, 0x2CBFBE86B7EC8AA8Ui64,   // 5^-283
+    0x94B3A202EB1C3F39Ui64, 0x7BF7D71432F3D6A9Ui64,   // 5^-282
+    0xB9E08A83A5E34F07Ui64, 0xDAF5CCD93FB0CC53Ui64,   // 5^-281
+    0xE858AD248F5C22C9Ui64, 0xD1B3400F8F9CFF68Ui64,   // 5^-280
+    0x91376C36D99995BEUi64, 0x23100809B9C21FA1Ui64,   // 5^-279
+    0xB58547448FFFFB2DUi64, 0xABD40A0C2832A78AUi64,   // 5^-278
+    0xE2E69915B3FFF9F9Ui64, 0x16C90C8F323F516CUi64,   // 5^-277
+    0x8DD01FAD907FFC3BUi64, 0xAE3DA7D97F6792E3Ui64,   // 5^-276
+    0xB1442798F49FFB4AUi64, 0x99CD11CFDF41779CUi64,   // 5^-275
+    0xDD95317F31C7FA1DUi64, 0x40405643D711D583Ui64,   // 5^-274
+    0x8A7D3EEF7F1CFC52Ui64, 0x482835EA666B2572Ui64,   // 5^-273
+    0xAD1C8EAB5EE43B66Ui64, 0xDA3243650005EECFUi64,   // 5^-272
+    0xD863B256369D4A40Ui64, 0x90BED43E40076A82Ui64,   // 5^-271
+    0x873E4F75E2224E68Ui64, 0x5A7744A6E804A291Ui64,   // 5^-270
+    0xA90DE3535AAAE202Ui64, 0x711515D0A205CB36Ui64,   // 5^-269
+    0xD3515C2831559A83Ui64, 0x0D5A5B44CA873E03Ui64,   // 5^-268
+    0x8412D9991ED58091Ui64, 0xE858790AFE9486C2Ui64,   // 5^-267
+    0xA5178FFF668AE0B6Ui64, 0x626E974DBE39A872Ui64,   // 5^-266
+    0xCE5D73FF402D98E3Ui64, 0xFB0A3D212DC8128FUi64,   // 5^-265
+    0x80FA687F881C7F8EUi64, 0x7CE66634BC9D0B99Ui64,   // 5^-264
+    0xA139029F6A239F72Ui64, 0x1C1FFFC1EBC44E80Ui64,   // 5^-263
+    0xC987434744AC874EUi64, 0xA327FFB266B56220Ui64,   // 5^-262
+    0xFBE9141915D7A922Ui64, 0x4BF1FF9F0062BAA8Ui64,   // 5^-261
+    0x9D71AC8FADA6C9B5Ui64, 0x6F773FC3603DB4A9Ui64,   // 5^-260
+    0xC4CE17B399107C22Ui64, 0xCB550FB4384D21D3Ui64,   // 5^-259
+    0xF6019DA07F549B2BUi64, 0x7E2A53A146606A48Ui64,   // 5^-258
+    0x99C102844F94E0FBUi64, 0x2EDA7444CBFC426DUi64,   // 5^-257
+    0xC0314325637A1939Ui64, 0xFA911155FEFB5308Ui64,   // 5^-256
+    0xF03D93EEBC589F88Ui64, 0x793555AB7EBA27CAUi64,   // 5^-255
+    0x96267C7535B763B5Ui64, 0x4BC1558B2F3458DEUi64,   // 5^-254
+    0xBBB01B9283253CA2Ui64, 0x9EB1AAEDFB016F16Ui64,   // 5^-253
+    0xEA9C227723EE8BCBUi64, 0x465E15A979C1CADCUi64,   // 5^-252
+    0x92A1958A7675175FUi64, 0x0BFACD89EC191EC9Ui64,   // 5^-251
+    0xB749FAED14125D36Ui64, 0xCEF980EC671F667BUi64,   // 5^-250
+    0xE51C79A85916F484Ui64, 0x82B7E12780E7401AUi64,   // 5^-249
+    0x8F31CC0937AE58D2Ui64, 0xD1B2ECB8B0908810Ui64,   // 5^-248
+    0xB2FE3F0B8599EF07Ui64, 0x861FA7E6DCB4AA15Ui64,   // 5^-247
+    0xDFBDCECE67006AC9Ui64, 0x67A791E093E1D49AUi64,   // 5^-246
+    0x8BD6A141006042BDUi64, 0xE0C8BB2C5C6D24E0Ui64,   // 5^-245
+    0xAECC49914078536DUi64, 0x58FAE9F773886E18Ui64,   // 5^-244
+    0xDA7F5BF590966848Ui64, 0xAF39A475506A899EUi64,   // 5^-243
+    0x888F99797A5E012DUi64, 0x6D8406C952429603Ui64,   // 5^-242
+    0xAAB37FD7D8F58178Ui64, 0xC8E5087BA6D33B83Ui64,   // 5^-241
+    0xD5605FCDCF32E1D6Ui64, 0xFB1E4A9A90880A64Ui64,   // 5^-240
+    0x855C3BE0A17FCD26Ui64, 0x5CF2EEA09A55067FUi64,   // 5^-239
+    0xA6B34AD8C9DFC06FUi64, 0xF42FAA48C0EA481EUi64,   // 5^-238
+    0xD0601D8EFC57B08BUi64, 0xF13B94DAF124DA26Ui64,   // 5^-237
+    0x823C12795DB6CE57Ui64, 0x76C53D08D6B70858Ui64,   // 5^-236
+    0xA2CB1717B52481EDUi64, 0x54768C4B0C64CA6EUi64,   // 5^-235
+    0xCB7DDCDDA26DA268Ui64, 0xA9942F5DCF7DFD09Ui64,   // 5^-234
+    0xFE5D54150B090B02Ui64, 0xD3F93B35435D7C4CUi64,   // 5^-233
+    0x9EFA548D26E5A6E1Ui64, 0xC47BC5014A1A6DAFUi64,   // 5^-232
+    0xC6B8E9B0709F109AUi64, 0x359AB6419CA1091BUi64,   // 5^-231
+    0xF867241C8CC6D4C0Ui64, 0xC30163D203C94B62Ui64,   // 5^-230
+    0x9B407691D7FC44F8Ui64, 0x79E0DE63425DCF1DUi64,   // 5^-229
+    0xC21094364DFB5636Ui64, 0x985915FC12F542E4Ui64,   // 5^-228
+    0xF294B943E17A2BC4Ui64, 0x3E6F5B7B17B2939DUi64,   // 5^-227
+    0x979CF3CA6CEC5B5AUi64, 0xA705992CEECF9C42Ui64,   // 5^-226
+    0xBD8430BD08277231Ui64, 0x50C6FF782A838353Ui64,   // 5^-225
+    0xECE53CEC4A314EBDUi64, 0xA4F8BF5635246428Ui64,   // 5^-224
+    0x940F4613AE5ED136Ui64, 0x871B7795E136BE99Ui64,   // 5^-223
+    0xB913179899F68584Ui64, 0x28E2557B59846E3FUi64,   // 5^-222
+    0xE757DD7EC07426E5Ui64, 0x331AEADA2FE589CFUi64,   // 5^-221
+    0x9096EA6F3848984FUi64, 0x3FF0D2C85DEF7621Ui64,   // 5^-220
+    0xB4BCA50B065ABE63Ui64, 0x0FED077A756B53A9Ui64,   // 5^-219
+    0xE1EBCE4DC7F16DFBUi64, 0xD3E8495912C62894Ui64,   // 5^-218
+    0x8D3360F09CF6E4BDUi64, 0x64712DD7ABBBD95CUi64,   // 5^-217
+    0xB080392CC4349DECUi64, 0xBD8D794D96AACFB3Ui64,   // 5^-216
+    0xDCA04777F541C567Ui64, 0xECF0D7A0FC5583A0Ui64,   // 5^-215
+    0x89E42CAAF9491B60Ui64, 0xF41686C49DB57244Ui64,   // 5^-214
+    0xAC5D37D5B79B6239Ui64, 0x311C2875C522CED5Ui64,   // 5^-213
+    0xD77485CB25823AC7Ui64, 0x7D633293366B828BUi64,   // 5^-212
+    0x86A8D39EF77164BCUi64, 0xAE5DFF9C02033197Ui64,   // 5^-211
+    0xA8530886B54DBDEBUi64, 0xD9F57F830283FDFCUi64,   // 5^-210
+    0xD267CAA862A12D66Ui64, 0xD072DF63C324FD7BUi64,   // 5^-209
+    0x8380DEA93DA4BC60Ui64, 0x4247CB9E59F71E6DUi64,   // 5^-208
+    0xA46116538D0DEB78Ui64, 0x52D9BE85F074E608Ui64,   // 5^-207
+    0xCD795BE870516656Ui64, 0x67902E276C921F8BUi64,   // 5^-206
+    0x806BD9714632DFF6Ui64, 0x00BA1CD8A3DB53B6Ui64,   // 5^-205
+    0xA086CFCD97BF97F3Ui64, 0x80E8A40ECCD228A4Ui64,   // 5^-204
+    0xC8A883C0FDAF7DF0Ui64, 0x6122CD128006B2CDUi64,   // 5^-203
+    0xFAD2A4B13D1B5D6CUi64, 0x796B805720085F81Ui64,   // 5^-202
+    0x9CC3A6EEC6311A63Ui64, 0xCBE3303674053BB0Ui64,   // 5^-201
+    0xC3F490AA77BD60FCUi64, 0xBEDBFC4411068A9CUi64,   // 5^-200
+    0xF4F1B4D515ACB93BUi64, 0xEE92FB5515482D44Ui64,   // 5^-199
+    0x991711052D8BF3C5Ui64, 0x751BDD152D4D1C4AUi64,   // 5^-198
+    0xBF5CD54678EEF0B6Ui64, 0xD262D45A78A0635DUi64,   // 5^-197
+    0xEF340A98172AACE4Ui64, 0x86FB897116C87C34Ui64,   // 5^-196
+    0x9580869F0E7AAC0EUi64, 0xD45D35E6AE3D4DA0Ui64,   // 5^-195
+    0xBAE0A846D2195712Ui64, 0x8974836059CCA109Ui64,   // 5^-194
+    0xE998D258869FACD7Ui64, 0x2BD1A438703FC94BUi64,   // 5^-193
+    0x91FF83775423CC06Ui64, 0x7B6306A34627DDCFUi64,   // 5^-192
+    0xB67F6455292CBF08Ui64, 0x1A3BC84C17B1D542Ui64,   // 5^-191
+    0xE41F3D6A7377EECAUi64, 0x20CABA5F1D9E4A93Ui64,   // 5^-190
+    0x8E938662882AF53EUi64, 0x547EB47B7282EE9CUi64,   // 5^-189
+    0xB23867FB2A35B28DUi64, 0xE99E619A4F23AA43Ui64,   // 5^-188
+    0xDEC681F9F4C31F31Ui64, 0x6405FA00E2EC94D4Ui64,   // 5^-187
+    0x8B3C113C38F9F37EUi64, 0xDE83BC408DD3DD04Ui64,   // 5^-186
+    0xAE0B158B4738705EUi64, 0x9624AB50B148D445Ui64,   // 5^-185
+    0xD98DDAEE19068C76Ui64, 0x3BADD624DD9B0957Ui64,   // 5^-184
+    0x87F8A8D4CFA417C9Ui64, 0xE54CA5D70A80E5D6Ui64,   // 5^-183
+    0xA9F6D30A038D1DBCUi64, 0x5E9FCF4CCD211F4CUi64,   // 5^-182
+    0xD47487CC8470652BUi64, 0x7647C3200069671FUi64,   // 5^-181
+    0x84C8D4DFD2C63F3BUi64, 0x29ECD9F40041E073Ui64,   // 5^-180
+    0xA5FB0A17C777CF09Ui64, 0xF468107100525890Ui64,   // 5^-179
+    0xCF79CC9DB955C2CCUi64, 0x7182148D4066EEB4Ui64,   // 5^-178
+    0x81AC1FE293D599BFUi64, 0xC6F14CD848405530Ui64,   // 5^-177
+    0xA21727DB38CB002FUi64, 0xB8ADA00E5A506A7CUi64,   // 5^-176
+    0xCA9CF1D206FDC03BUi64, 0xA6D90811F0E4851CUi64,   // 5^-175
+    0xFD442E4688BD304AUi64, 0x908F4A166D1DA663Ui64,   // 5^-174
+    0x9E4A9CEC15763E2EUi64, 0x9A598E4E043287FEUi64,   // 5^-173
+    0xC5DD44271AD3CDBAUi64, 0x40EFF1E1853F29FDUi64,   // 5^-172
+    0xF7549530E188C128Ui64, 0xD12BEE59E68EF47CUi64,   // 5^-171
+    0x9A94DD3E8CF578B9Ui64, 0x82BB74F8301958CEUi64,   // 5^-170
+    0xC13A148E3032D6E7Ui64, 0xE36A52363C1FAF01Ui64,   // 5^-169
+    0xF18899B1BC3F8CA1Ui64, 0xDC44E6C3CB279AC1Ui64,   // 5^-168
+    0x96F5600F15A7B7E5Ui64, 0x29AB103A5EF8C0B9Ui64,   // 5^-167
+    0xBCB2B812DB11A5DEUi64, 0x7415D448F6B6F0E7Ui64,   // 5^-166
+    0xEBDF661791D60F56Ui64, 0x111B495B3464AD21Ui64,   // 5^-165
+    0x936B9FCEBB25C995Ui64, 0xCAB10DD900BEEC34Ui64,   // 5^-164
+    0xB84687C269EF3BFBUi64, 0x3D5D514F40EEA742Ui64,   // 5^-163
+    0xE65829B3046B0AFAUi64, 0x0CB4A5A3112A5112Ui64,   // 5^-162
+    0x8FF71A0FE2C2E6DCUi64, 0x47F0E785EABA72ABUi64,   // 5^-161
+    0xB3F4E093DB73A093Ui64, 0x59ED216765690F56Ui64,   // 5^-160
+    0xE0F218B8D25088B8Ui64, 0x306869C13EC3532CUi64,   // 5^-159
+    0x8C974F7383725573Ui64, 0x1E414218C73A13FBUi64,   // 5^-158
+    0xAFBD2350644EEACFUi64, 0xE5D1929EF90898FAUi64,   // 5^-157
+    0xDBAC6C247D62A583Ui64, 0xDF45F746B74ABF39Ui64,   // 5^-156
+    0x894BC396CE5DA772Ui64, 0x6B8BBA8C328EB783Ui64,   // 5^-155
+    0xAB9EB47C81F5114FUi64, 0x066EA92F3F326564Ui64,   // 5^-154
+    0xD686619BA27255A2Ui64, 0xC80A537B0EFEFEBDUi64,   // 5^-153
+    0x8613FD0145877585Ui64, 0xBD06742CE95F5F36Ui64,   // 5^-152
+    0xA798FC4196E952E7Ui64, 0x2C48113823B73704Ui64,   // 5^-151
+    0xD17F3B51FCA3A7A0Ui64, 0xF75A15862CA504C5Ui64,   // 5^-150
+    0x82EF85133DE648C4Ui64, 0x9A984D73DBE722FBUi64,   // 5^-149
+    0xA3AB66580D5FDAF5Ui64, 0xC13E60D0D2E0EBBAUi64,   // 5^-148
+    0xCC963FEE10B7D1B3Ui64, 0x318DF905079926A8Ui64,   // 5^-147
+    0xFFBBCFE994E5C61FUi64, 0xFDF17746497F7052Ui64,   // 5^-146
+    0x9FD561F1FD0F9BD3Ui64, 0xFEB6EA8BEDEFA633Ui64,   // 5^-145
+    0xC7CABA6E7C5382C8Ui64, 0xFE64A52EE96B8FC0Ui64,   // 5^-144
+    0xF9BD690A1B68637BUi64, 0x3DFDCE7AA3C673B0Ui64,   // 5^-143
+    0x9C1661A651213E2DUi64, 0x06BEA10CA65C084EUi64,   // 5^-142
+    0xC31BFA0FE5698DB8Ui64, 0x486E494FCFF30A62Ui64,   // 5^-141
+    0xF3E2F893DEC3F126Ui64, 0x5A89DBA3C3EFCCFAUi64,   // 5^-140
+    0x986DDB5C6B3A76B7Ui64, 0xF89629465A75E01CUi64,   // 5^-139
+    0xBE89523386091465Ui64, 0xF6BBB397F1135823Ui64,   // 5^-138
+    0xEE2BA6C0678B597FUi64, 0x746AA07DED582E2CUi64,   // 5^-137
+    0x94DB483840B717EFUi64, 0xA8C2A44EB4571CDCUi64,   // 5^-136
+    0xBA121A4650E4DDEBUi64, 0x92F34D62616CE413Ui64,   // 5^-135
+    0xE896A0D7E51E1566Ui64, 0x77B020BAF9C81D17Ui64,   // 5^-134
+    0x915E2486EF32CD60Ui64, 0x0ACE1474DC1D122EUi64,   // 5^-133
+    0xB5B5ADA8AAFF80B8Ui64, 0x0D819992132456BAUi64,   // 5^-132
+    0xE3231912D5BF60E6Ui64, 0x10E1FFF697ED6C69Ui64,   // 5^-131
+    0x8DF5EFABC5979C8FUi64, 0xCA8D3FFA1EF463C1Ui64,   // 5^-130
+    0xB1736B96B6FD83B3Ui64, 0xBD308FF8A6B17CB2Ui64,   // 5^-129
+    0xDDD0467C64BCE4A0Ui64, 0xAC7CB3F6D05DDBDEUi64,   // 5^-128
+    0x8AA22C0DBEF60EE4Ui64, 0x6BCDF07A423AA96BUi64,   // 5^-127
+    0xAD4AB7112EB3929DUi64, 0x86C16C98D2C953C6Ui64,   // 5^-126
+    0xD89D64D57A607744Ui64, 0xE871C7BF077BA8B7Ui64,   // 5^-125
+    0x87625F056C7C4A8BUi64, 0x11471CD764AD4972Ui64,   // 5^-124
+    0xA93AF6C6C79B5D2DUi64, 0xD598E40D3DD89BCFUi64,   // 5^-123
+    0xD389B47879823479Ui64, 0x4AFF1D108D4EC2C3Ui64,   // 5^-122
+    0x843610CB4BF160CBUi64, 0xCEDF722A585139BAUi64,   // 5^-121
+    0xA54394FE1EEDB8FEUi64, 0xC2974EB4EE658828Ui64,   // 5^-120
+    0xCE947A3DA6A9273EUi64, 0x733D226229FEEA32Ui64,   // 5^-119
+    0x811CCC668829B887Ui64, 0x0806357D5A3F525FUi64,   // 5^-118
+    0xA163FF802A3426A8Ui64, 0xCA07C2DCB0CF26F7Ui64,   // 5^-117
+    0xC9BCFF6034C13052Ui64, 0xFC89B393DD02F0B5Ui64,   // 5^-116
+    0xFC2C3F3841F17C67Ui64, 0xBBAC2078D443ACE2Ui64,   // 5^-115
+    0x9D9BA7832936EDC0Ui64, 0xD54B944B84AA4C0DUi64,   // 5^-114
+    0xC5029163F384A931Ui64, 0x0A9E795E65D4DF11Ui64,   // 5^-113
+    0xF64335BCF065D37DUi64, 0x4D4617B5FF4A16D5Ui64,   // 5^-112
+    0x99EA0196163FA42EUi64, 0x504BCED1BF8E4E45Ui64,   // 5^-111
+    0xC06481FB9BCF8D39Ui64, 0xE45EC2862F71E1D6Ui64,   // 5^-110
+    0xF07DA27A82C37088Ui64, 0x5D767327BB4E5A4CUi64,   // 5^-109
+    0x964E858C91BA2655Ui64, 0x3A6A07F8D510F86FUi64,   // 5^-108
+    0xBBE226EFB628AFEAUi64, 0x890489F70A55368BUi64,   // 5^-107
+    0xEADAB0ABA3B2DBE5Ui64, 0x2B45AC74CCEA842EUi64,   // 5^-106
+    0x92C8AE6B464FC96FUi64, 0x3B0B8BC90012929DUi64,   // 5^-105
+    0xB77ADA0617E3BBCBUi64, 0x09CE6EBB40173744Ui64,   // 5^-104
+    0xE55990879DDCAABDUi64, 0xCC420A6A101D0515Ui64,   // 5^-103
+    0x8F57FA54C2A9EAB6Ui64, 0x9FA946824A12232DUi64,   // 5^-102
+    0xB32DF8E9F3546564Ui64, 0x47939822DC96ABF9Ui64,   // 5^-101
+    0xDFF9772470297EBDUi64, 0x59787E2B93BC56F7Ui64,   // 5^-100
+    0x8BFBEA76C619EF36Ui64, 0x57EB4EDB3C55B65AUi64,   // 5^-99
+    0xAEFAE51477A06B03Ui64, 0xEDE622920B6B23F1Ui64,   // 5^-98
+    0xDAB99E59958885C4Ui64, 0xE95FAB368E45ECEDUi64,   // 5^-97
+    0x88B402F7FD75539BUi64, 0x11DBCB0218EBB414Ui64,   // 5^-96
+    0xAAE103B5FCD2A881Ui64, 0xD652BDC29F26A119Ui64,   // 5^-95
+    0xD59944A37C0752A2Ui64, 0x4BE76D3346F0495FUi64,   // 5^-94
+    0x857FCAE62D8493A5Ui64, 0x6F70A4400C562DDBUi64,   // 5^-93
+    0xA6DFBD9FB8E5B88EUi64, 0xCB4CCD500F6BB952Ui64,   // 5^-92
+    0xD097AD07A71F26B2Ui64, 0x7E2000A41346A7A7Ui64,   // 5^-91
+    0x825ECC24C873782FUi64, 0x8ED400668C0C28C8Ui64,   // 5^-90
+    0xA2F67F2DFA90563BUi64, 0x728900802F0F32FAUi64,   // 5^-89
+    0xCBB41EF979346BCAUi64, 0x4F2B40A03AD2FFB9Ui64,   // 5^-88
+    0xFEA126B7D78186BCUi64, 0xE2F610C84987BFA8Ui64,   // 5^-87
+    0x9F24B832E6B0F436Ui64, 0x0DD9CA7D2DF4D7C9Ui64,   // 5^-86
+    0xC6EDE63FA05D3143Ui64, 0x91503D1C79720DBBUi64,   // 5^-85
+    0xF8A95FCF88747D94Ui64, 0x75A44C6397CE912AUi64,   // 5^-84
+    0x9B69DBE1B548CE7CUi64, 0xC986AFBE3EE11ABAUi64,   // 5^-83
+    0xC24452DA229B021BUi64, 0xFBE85BADCE996168Ui64,   // 5^-82
+    0xF2D56790AB41C2A2Ui64, 0xFAE27299423FB9C3Ui64,   // 5^-81
+    0x97C560BA6B0919A5Ui64, 0xDCCD879FC967D41AUi64,   // 5^-80
+    0xBDB6B8E905CB600FUi64, 0x5400E987BBC1C920Ui64,   // 5^-79
+    0xED246723473E3813Ui64, 0x290123E9AAB23B68Ui64,   // 5^-78
+    0x9436C0760C86E30BUi64, 0xF9A0B6720AAF6521Ui64,   // 5^-77
+    0xB94470938FA89BCEUi64, 0xF808E40E8D5B3E69Ui64,   // 5^-76
+    0xE7958CB87392C2C2Ui64, 0xB60B1D1230B20E04Ui64,   // 5^-75
+    0x90BD77F3483BB9B9Ui64, 0xB1C6F22B5E6F48C2Ui64,   // 5^-74
+    0xB4ECD5F01A4AA828Ui64, 0x1E38AEB6360B1AF3Ui64,   // 5^-73
+    0xE2280B6C20DD5232Ui64, 0x25C6DA63C38DE1B0Ui64,   // 5^-72
+    0x8D590723948A535FUi64, 0x579C487E5A38AD0EUi64,   // 5^-71
+    0xB0AF48EC79ACE837Ui64, 0x2D835A9DF0C6D851Ui64,   // 5^-70
+    0xDCDB1B2798182244Ui64, 0xF8E431456CF88E65Ui64,   // 5^-69
+    0x8A08F0F8BF0F156BUi64, 0x1B8E9ECB641B58FFUi64,   // 5^-68
+    0xAC8B2D36EED2DAC5Ui64, 0xE272467E3D222F3FUi64,   // 5^-67
+    0xD7ADF884AA879177Ui64, 0x5B0ED81DCC6ABB0FUi64,   // 5^-66
+    0x86CCBB52EA94BAEAUi64, 0x98E947129FC2B4E9Ui64,   // 5^-65
+    0xA87FEA27A539E9A5Ui64, 0x3F2398D747B36224Ui64,   // 5^-64
+    0xD29FE4B18E88640EUi64, 0x8EEC7F0D19A03AADUi64,   // 5^-63
+    0x83A3EEEEF9153E89Ui64, 0x1953CF68300424ACUi64,   // 5^-62
+    0xA48CEAAAB75A8E2BUi64, 0x5FA8C3423C052DD7Ui64,   // 5^-61
+    0xCDB02555653131B6Ui64, 0x3792F412CB06794DUi64,   // 5^-60
+    0x808E17555F3EBF11Ui64, 0xE2BBD88BBEE40BD0Ui64,   // 5^-59
+    0xA0B19D2AB70E6ED6Ui64, 0x5B6ACEAEAE9D0EC4Ui64,   // 5^-58
+    0xC8DE047564D20A8BUi64, 0xF245825A5A445275Ui64,   // 5^-57
+    0xFB158592BE068D2EUi64, 0xEED6E2F0F0D56712Ui64,   // 5^-56
+    0x9CED737BB6C4183DUi64, 0x55464DD69685606BUi64,   // 5^-55
+    0xC428D05AA4751E4CUi64, 0xAA97E14C3C26B886Ui64,   // 5^-54
+    0xF53304714D9265DFUi64, 0xD53DD99F4B3066A8Ui64,   // 5^-53
+    0x993FE2C6D07B7FABUi64, 0xE546A8038EFE4029Ui64,   // 5^-52
+    0xBF8FDB78849A5F96Ui64, 0xDE98520472BDD033Ui64,   // 5^-51
+    0xEF73D256A5C0F77CUi64, 0x963E66858F6D4440Ui64,   // 5^-50
+    0x95A8637627989AADUi64, 0xDDE7001379A44AA8Ui64,   // 5^-49
+    0xBB127C53B17EC159Ui64, 0x5560C018580D5D52Ui64,   // 5^-48
+    0xE9D71B689DDE71AFUi64, 0xAAB8F01E6E10B4A6Ui64,   // 5^-47
+    0x9226712162AB070DUi64, 0xCAB3961304CA70E8Ui64,   // 5^-46
+    0xB6B00D69BB55C8D1Ui64, 0x3D607B97C5FD0D22Ui64,   // 5^-45
+    0xE45C10C42A2B3B05Ui64, 0x8CB89A7DB77C506AUi64,   // 5^-44
+    0x8EB98A7A9A5B04E3Ui64, 0x77F3608E92ADB242Ui64,   // 5^-43
+    0xB267ED1940F1C61CUi64, 0x55F038B237591ED3Ui64,   // 5^-42
+    0xDF01E85F912E37A3Ui64, 0x6B6C46DEC52F6688Ui64,   // 5^-41
+    0x8B61313BBABCE2C6Ui64, 0x2323AC4B3B3DA015Ui64,   // 5^-40
+    0xAE397D8AA96C1B77Ui64, 0xABEC975E0A0D081AUi64,   // 5^-39
+    0xD9C7DCED53C72255Ui64, 0x96E7BD358C904A21Ui64,   // 5^-38
+    0x881CEA14545C7575Ui64, 0x7E50D64177DA2E54Ui64,   // 5^-37
+    0xAA242499697392D2Ui64, 0xDDE50BD1D5D0B9E9Ui64,   // 5^-36
+    0xD4AD2DBFC3D07787Ui64, 0x955E4EC64B44E864Ui64,   // 5^-35
+    0x84EC3C97DA624AB4Ui64, 0xBD5AF13BEF0B113EUi64,   // 5^-34
+    0xA6274BBDD0FADD61Ui64, 0xECB1AD8AEACDD58EUi64,   // 5^-33
+    0xCFB11EAD453994BAUi64, 0x67DE18EDA5814AF2Ui64,   // 5^-32
+    0x81CEB32C4B43FCF4Ui64, 0x80EACF948770CED7Ui64,   // 5^-31
+    0xA2425FF75E14FC31Ui64, 0xA1258379A94D028DUi64,   // 5^-30
+    0xCAD2F7F5359A3B3EUi64, 0x096EE45813A04330Ui64,   // 5^-29
+    0xFD87B5F28300CA0DUi64, 0x8BCA9D6E188853FCUi64,   // 5^-28
+    0x9E74D1B791E07E48Ui64, 0x775EA264CF55347EUi64,   // 5^-27
+    0xC612062576589DDAUi64, 0x95364AFE032A819EUi64,   // 5^-26
+    0xF79687AED3EEC551Ui64, 0x3A83DDBD83F52205Ui64,   // 5^-25
+    0x9ABE14CD44753B52Ui64, 0xC4926A9672793543Ui64,   // 5^-24
+    0xC16D9A0095928A27Ui64, 0x75B7053C0F178294Ui64,   // 5^-23
+    0xF1C90080BAF72CB1Ui64, 0x5324C68B12DD6339Ui64,   // 5^-22
+    0x971DA05074DA7BEEUi64, 0xD3F6FC16EBCA5E04Ui64,   // 5^-21
+    0xBCE5086492111AEAUi64, 0x88F4BB1CA6BCF585Ui64,   // 5^-20
+    0xEC1E4A7DB69561A5Ui64, 0x2B31E9E3D06C32E6Ui64,   // 5^-19
+    0x9392EE8E921D5D07Ui64, 0x3AFF322E62439FD0Ui64,   // 5^-18
+    0xB877AA3236A4B449Ui64, 0x09BEFEB9FAD487C3Ui64,   // 5^-17
+    0xE69594BEC44DE15BUi64, 0x4C2EBE687989A9B4Ui64,   // 5^-16
+    0x901D7CF73AB0ACD9Ui64, 0x0F9D37014BF60A11Ui64,   // 5^-15
+    0xB424DC35095CD80FUi64, 0x538484C19EF38C95Ui64,   // 5^-14
+    0xE12E13424BB40E13Ui64, 0x2865A5F206B06FBAUi64,   // 5^-13
+    0x8CBCCC096F5088CBUi64, 0xF93F87B7442E45D4Ui64,   // 5^-12
+    0xAFEBFF0BCB24AAFEUi64, 0xF78F69A51539D749Ui64,   // 5^-11
+    0xDBE6FECEBDEDD5BEUi64, 0xB573440E5A884D1CUi64,   // 5^-10
+    0x89705F4136B4A597Ui64, 0x31680A88F8953031Ui64,   // 5^-9
+    0xABCC77118461CEFCUi64, 0xFDC20D2B36BA7C3EUi64,   // 5^-8
+    0xD6BF94D5E57A42BCUi64, 0x3D32907604691B4DUi64,   // 5^-7
+    0x8637BD05AF6C69B5Ui64, 0xA63F9A49C2C1B110Ui64,   // 5^-6
+    0xA7C5AC471B478423Ui64, 0x0FCF80DC33721D54Ui64,   // 5^-5
+    0xD1B71758E219652BUi64, 0xD3C36113404EA4A9Ui64,   // 5^-4
+    0x83126E978D4FDF3BUi64, 0x645A1CAC083126EAUi64,   // 5^-3
+    0xA3D70A3D70A3D70AUi64, 0x3D70A3D70A3D70A4Ui64,   // 5^-2
+    0xCCCCCCCCCCCCCCCCUi64, 0xCCCCCCCCCCCCCCCDUi64,   // 5^-1
+    0x8000000000000000Ui64, 0x0000000000000000Ui64,   // 5^0
+    0xA000000000000000Ui64, 0x0000000000000000Ui64,   // 5^1
+    0xC800000000000000Ui64, 0x0000000000000000Ui64,   // 5^2
+    0xFA00000000000000Ui64, 0x0000000000000000Ui64,   // 5^3
+    0x9C40000000000000Ui64, 0x0000000000000000Ui64,   // 5^4
+    0xC350000000000000Ui64, 0x0000000000000000Ui64,   // 5^5
+    0xF424000000000000Ui64, 0x0000000000000000Ui64,   // 5^6
+    0x9896800000000000Ui64, 0x0000000000000000Ui64,   // 5^7
+    0xBEBC200000000000Ui64, 0x0000000000000000Ui64,   // 5^8
+    0xEE6B280000000000Ui64, 0x0000000000000000Ui64,   // 5^9
+    0x9502F90000000000Ui64, 0x0000000000000000Ui64,   // 5^10
+    0xBA43B74000000000Ui64, 0x0000000000000000Ui64,   // 5^11
+    0xE8D4A51000000000Ui64, 0x0000000000000000Ui64,   // 5^12
+    0x9184E72A00000000Ui64, 0x0000000000000000Ui64,   // 5^13
+    0xB5E620F480000000Ui64, 0x0000000000000000Ui64,   // 5^14
+    0xE35FA931A0000000Ui64, 0x0000000000000000Ui64,   // 5^15
+    0x8E1BC9BF04000000Ui64, 0x0000000000000000Ui64,   // 5^16
+    0xB1A2BC2EC5000000Ui64, 0x0000000000000000Ui64,   // 5^17
+    0xDE0B6B3A76400000Ui64, 0x0000000000000000Ui64,   // 5^18
+    0x8AC7230489E80000Ui64, 0x0000000000000000Ui64,   // 5^19
+    0xAD78EBC5AC620000Ui64, 0x0000000000000000Ui64,   // 5^20
+    0xD8D726B7177A8000Ui64, 0x0000000000000000Ui64,   // 5^21
+    0x878678326EAC9000Ui64, 0x0000000000000000Ui64,   // 5^22
+    0xA968163F0A57B400Ui64, 0x0000000000000000Ui64,   // 5^23
+    0xD3C21BCECCEDA100Ui64, 0x0000000000000000Ui64,   // 5^24
+    0x84595161401484A0Ui64, 0x0000000000000000Ui64,   // 5^25
+    0xA56FA5B99019A5C8Ui64, 0x0000000000000000Ui64,   // 5^26
+    0xCECB8F27F4200F3AUi64, 0x0000000000000000Ui64,   // 5^27
+    0x813F3978F8940984Ui64, 0x4000000000000000Ui64,   // 5^28
+    0xA18F07D736B90BE5Ui64, 0x5000000000000000Ui64,   // 5^29
+    0xC9F2C9CD04674EDEUi64, 0xA400000000000000Ui64,   // 5^30
+    0xFC6F7C4045812296Ui64, 0x4D00000000000000Ui64,   // 5^31
+    0x9DC5ADA82B70B59DUi64, 0xF020000000000000Ui64,   // 5^32
+    0xC5371912364CE305Ui64, 0x6C28000000000000Ui64,   // 5^33
+    0xF684DF56C3E01BC6Ui64, 0xC732000000000000Ui64,   // 5^34
+    0x9A130B963A6C115CUi64, 0x3C7F400000000000Ui64,   // 5^35
+    0xC097CE7BC90715B3Ui64, 0x4B9F100000000000Ui64,   // 5^36
+    0xF0BDC21ABB48DB20Ui64, 0x1E86D40000000000Ui64,   // 5^37
+    0x96769950B50D88F4Ui64, 0x1314448000000000Ui64,   // 5^38
+    0xBC143FA4E250EB31Ui64, 0x17D955A000000000Ui64,   // 5^39
+    0xEB194F8E1AE525FDUi64, 0x5DCFAB0800000000Ui64,   // 5^40
+    0x92EFD1B8D0CF37BEUi64, 0x5AA1CAE500000000Ui64,   // 5^41
+    0xB7ABC627050305ADUi64, 0xF14A3D9E40000000Ui64,   // 5^42
+    0xE596B7B0C643C719Ui64, 0x6D9CCD05D0000000Ui64,   // 5^43
+    0x8F7E32CE7BEA5C6FUi64, 0xE4820023A2000000Ui64,   // 5^44
+    0xB35DBF821AE4F38BUi64, 0xDDA2802C8A800000Ui64,   // 5^45
+    0xE0352F62A19E306EUi64, 0xD50B2037AD200000Ui64,   // 5^46
+    0x8C213D9DA502DE45Ui64, 0x4526F422CC340000Ui64,   // 5^47
+    0xAF298D050E4395D6Ui64, 0x9670B12B7F410000Ui64,   // 5^48
+    0xDAF3F04651D47B4CUi64, 0x3C0CDD765F114000Ui64,   // 5^49
+    0x88D8762BF324CD0FUi64, 0xA5880A69FB6AC800Ui64,   // 5^50
+    0xAB0E93B6EFEE0053Ui64, 0x8EEA0D047A457A00Ui64,   // 5^51
+    0xD5D238A4ABE98068Ui64, 0x72A4904598D6D880Ui64,   // 5^52
+    0x85A36366EB71F041Ui64, 0x47A6DA2B7F864750Ui64,   // 5^53
+    0xA70C3C40A64E6C51Ui64, 0x999090B65F67D924Ui64,   // 5^54
+    0xD0CF4B50CFE20765Ui64, 0xFFF4B4E3F741CF6DUi64,   // 5^55
+    0x82818F1281ED449FUi64, 0xBFF8F10E7A8921A4Ui64,   // 5^56
+    0xA321F2D7226895C7Ui64, 0xAFF72D52192B6A0DUi64,   // 5^57
+    0xCBEA6F8CEB02BB39Ui64, 0x9BF4F8A69F764490Ui64,   // 5^58
+    0xFEE50B7025C36A08Ui64, 0x02F236D04753D5B4Ui64,   // 5^59
+    0x9F4F2726179A2245Ui64, 0x01D762422C946590Ui64,   // 5^60
+    0xC722F0EF9D80AAD6Ui64, 0x424D3AD2B7B97EF5Ui64,   // 5^61
+    0xF8EBAD2B84E0D58BUi64, 0xD2E0898765A7DEB2Ui64,   // 5^62
+    0x9B934C3B330C8577Ui64, 0x63CC55F49F88EB2FUi64,   // 5^63
+    0xC2781F49FFCFA6D5Ui64, 0x3CBF6B71C76B25FBUi64,   // 5^64
+    0xF316271C7FC3908AUi64, 0x8BEF464E3945EF7AUi64,   // 5^65
+    0x97EDD871CFDA3A56Ui64, 0x97758BF0E3CBB5ACUi64,   // 5^66
+    0xBDE94E8E43D0C8ECUi64, 0x3D52EEED1CBEA317Ui64,   // 5^67
+    0xED63A231D4C4FB27Ui64, 0x4CA7AAA863EE4BDDUi64,   // 5^68
+    0x945E455F24FB1CF8Ui64, 0x8FE8CAA93E74EF6AUi64,   // 5^69
+    0xB975D6B6EE39E436Ui64, 0xB3E2FD538E122B44Ui64,   // 5^70
+    0xE7D34C64A9C85D44Ui64, 0x60DBBCA87196B616Ui64,   // 5^71
+    0x90E40FBEEA1D3A4AUi64, 0xBC8955E946FE31CDUi64,   // 5^72
+    0xB51D13AEA4A488DDUi64, 0x6BABAB6398BDBE41Ui64,   // 5^73
+    0xE264589A4DCDAB14Ui64, 0xC696963C7EED2DD1Ui64,   // 5^74
+    0x8D7EB76070A08AECUi64, 0xFC1E1DE5CF543CA2Ui64,   // 5^75
+    0xB0DE65388CC8ADA8Ui64, 0x3B25A55F43294BCBUi64,   // 5^76
+    0xDD15FE86AFFAD912Ui64, 0x49EF0EB713F39EBEUi64,   // 5^77
+    0x8A2DBF142DFCC7ABUi64, 0x6E3569326C784337Ui64,   // 5^78
+    0xACB92ED9397BF996Ui64, 0x49C2C37F07965404Ui64,   // 5^79
+    0xD7E77A8F87DAF7FBUi64, 0xDC33745EC97BE906Ui64,   // 5^80
+    0x86F0AC99B4E8DAFDUi64, 0x69A028BB3DED71A3Ui64,   // 5^81
+    0xA8ACD7C0222311BCUi64, 0xC40832EA0D68CE0CUi64,   // 5^82
+    0xD2D80DB02AABD62BUi64, 0xF50A3FA490C30190Ui64,   // 5^83
+    0x83C7088E1AAB65DBUi64, 0x792667C6DA79E0FAUi64,   // 5^84
+    0xA4B8CAB1A1563F52Ui64, 0x577001B891185938Ui64,   // 5^85
+    0xCDE6FD5E09ABCF26Ui64, 0xED4C0226B55E6F86Ui64,   // 5^86
+    0x80B05E5AC60B6178Ui64, 0x544F8158315B05B4Ui64,   // 5^87
+    0xA0DC75F1778E39D6Ui64, 0x696361AE3DB1C721Ui64,   // 5^88
+    0xC913936DD571C84CUi64, 0x03BC3A19CD1E38E9Ui64,   // 5^89
+    0xFB5878494ACE3A5FUi64, 0x04AB48A04065C723Ui64,   // 5^90
+    0x9D174B2DCEC0E47BUi64, 0x62EB0D64283F9C76Ui64,   // 5^91
+    0xC45D1DF942711D9AUi64, 0x3BA5D0BD324F8394Ui64,   // 5^92
+    0xF5746577930D6500Ui64, 0xCA8F44EC7EE36479Ui64,   // 5^93
+    0x9968BF6ABBE85F20Ui64, 0x7E998B13CF4E1ECBUi64,   // 5^94
+    0xBFC2EF456AE276E8Ui64, 0x9E3FEDD8C321A67EUi64,   // 5^95
+    0xEFB3AB16C59B14A2Ui64, 0xC5CFE94EF3EA101EUi64,   // 5^96
+    0x95D04AEE3B80ECE5Ui64, 0xBBA1F1D158724A12Ui64,   // 5^97
+    0xBB445DA9CA61281FUi64, 0x2A8A6E45AE8EDC97Ui64,   // 5^98
+    0xEA1575143CF97226Ui64, 0xF52D09D71A3293BDUi64,   // 5^99
+    0x924D692CA61BE758Ui64, 0x593C2626705F9C56Ui64,   // 5^100
+    0xB6E0C377CFA2E12EUi64, 0x6F8B2FB00C77836CUi64,   // 5^101
+    0xE498F455C38B997AUi64, 0x0B6DFB9C0F956447Ui64,   // 5^102
+    0x8EDF98B59A373FECUi64, 0x4724BD4189BD5EACUi64,   // 5^103
+    0xB2977EE300C50FE7Ui64, 0x58EDEC91EC2CB657Ui64,   // 5^104
+    0xDF3D5E9BC0F653E1Ui64, 0x2F2967B66737E3EDUi64,   // 5^105
+    0x8B865B215899F46CUi64, 0xBD79E0D20082EE74Ui64,   // 5^106
+    0xAE67F1E9AEC07187Ui64, 0xECD8590680A3AA11Ui64,   // 5^107
+    0xDA01EE641A708DE9Ui64, 0xE80E6F4820CC9495Ui64,   // 5^108
+    0x884134FE908658B2Ui64, 0x3109058D147FDCDDUi64,   // 5^109
+    0xAA51823E34A7EEDEUi64, 0xBD4B46F0599FD415Ui64,   // 5^110
+    0xD4E5E2CDC1D1EA96Ui64, 0x6C9E18AC7007C91AUi64,   // 5^111
+    0x850FADC09923329EUi64, 0x03E2CF6BC604DDB0Ui64,   // 5^112
+    0xA6539930BF6BFF45Ui64, 0x84DB8346B786151CUi64,   // 5^113
+    0xCFE87F7CEF46FF16Ui64, 0xE612641865679A63Ui64,   // 5^114
+    0x81F14FAE158C5F6EUi64, 0x4FCB7E8F3F60C07EUi64,   // 5^115
+    0xA26DA3999AEF7749Ui64, 0xE3BE5E330F38F09DUi64,   // 5^116
+    0xCB090C8001AB551CUi64, 0x5CADF5BFD3072CC5Ui64,   // 5^117
+    0xFDCB4FA002162A63Ui64, 0x73D9732FC7C8F7F6Ui64,   // 5^118
+    0x9E9F11C4014DDA7EUi64, 0x2867E7FDDCDD9AFAUi64,   // 5^119
+    0xC646D63501A1511DUi64, 0xB281E1FD541501B8Ui64,   // 5^120
+    0xF7D88BC24209A565Ui64, 0x1F225A7CA91A4226Ui64,   // 5^121
+    0x9AE757596946075FUi64, 0x3375788DE9B06958Ui64,   // 5^122
+    0xC1A12D2FC3978937Ui64, 0x0052D6B1641C83AEUi64,   // 5^123
+    0xF209787BB47D6B84Ui64, 0xC0678C5DBD23A49AUi64,   // 5^124
+    0x9745EB4D50CE6332Ui64, 0xF840B7BA963646E0Ui64,   // 5^125
+    0xBD176620A501FBFFUi64, 0xB650E5A93BC3D898Ui64,   // 5^126
+    0xEC5D3FA8CE427AFFUi64, 0xA3E51F138AB4CEBEUi64,   // 5^127
+    0x93BA47C980E98CDFUi64, 0xC66F336C36B10137Ui64,   // 5^128
+    0xB8A8D9BBE123F017Ui64, 0xB80B0047445D4184Ui64,   // 5^129
+    0xE6D3102AD96CEC1DUi64, 0xA60DC059157491E5Ui64,   // 5^130
+    0x9043EA1AC7E41392Ui64, 0x87C89837AD68DB2FUi64,   // 5^131
+    0xB454E4A179DD1877Ui64, 0x29BABE4598C311FBUi64,   // 5^132
+    0xE16A1DC9D8545E94Ui64, 0xF4296DD6FEF3D67AUi64,   // 5^133
+    0x8CE2529E2734BB1DUi64, 0x1899E4A65F58660CUi64,   // 5^134
+    0xB01AE745B101E9E4Ui64, 0x5EC05DCFF72E7F8FUi64,   // 5^135
+    0xDC21A1171D42645DUi64, 0x76707543F4FA1F73Ui64,   // 5^136
+    0x899504AE72497EBAUi64, 0x6A06494A791C53A8Ui64,   // 5^137
+    0xABFA45DA0EDBDE69Ui64, 0x0487DB9D17636892Ui64,   // 5^138
+    0xD6F8D7509292D603Ui64, 0x45A9D2845D3C42B6Ui64,   // 5^139
+    0x865B86925B9BC5C2Ui64, 0x0B8A2392BA45A9B2Ui64,   // 5^140
+    0xA7F26836F282B732Ui64, 0x8E6CAC7768D7141EUi64,   // 5^141
+    0xD1EF0244AF2364FFUi64, 0x3207D795430CD926Ui64,   // 5^142
+    0x8335616AED761F1FUi64, 0x7F44E6BD49E807B8Ui64,   // 5^143
+    0xA402B9C5A8D3A6E7Ui64, 0x5F16206C9C6209A6Ui64,   // 5^144
+    0xCD036837130890A1Ui64, 0x36DBA887C37A8C0FUi64,   // 5^145
+    0x802221226BE55A64Ui64, 0xC2494954DA2C9789Ui64,   // 5^146
+    0xA02AA96B06DEB0FDUi64, 0xF2DB9BAA10B7BD6CUi64,   // 5^147
+    0xC83553C5C8965D3DUi64, 0x6F92829494E5ACC7Ui64,   // 5^148
+    0xFA42A8B73ABBF48CUi64, 0xCB772339BA1F17F9Ui64,   // 5^149
+    0x9C69A97284B578D7Ui64, 0xFF2A760414536EFBUi64,   // 5^150
+    0xC38413CF25E2D70DUi64, 0xFEF5138519684ABAUi64,   // 5^151
+    0xF46518C2EF5B8CD1Ui64, 0x7EB258665FC25D69Ui64,   // 5^152
+    0x98BF2F79D5993802Ui64, 0xEF2F773FFBD97A61Ui64,   // 5^153
+    0xBEEEFB584AFF8603Ui64, 0xAAFB550FFACFD8FAUi64,   // 5^154
+    0xEEAABA2E5DBF6784Ui64, 0x95BA2A53F983CF38Ui64,   // 5^155
+    0x952AB45CFA97A0B2Ui64, 0xDD945A747BF26183Ui64,   // 5^156
+    0xBA756174393D88DFUi64, 0x94F971119AEEF9E4Ui64,   // 5^157
+    0xE912B9D1478CEB17Ui64, 0x7A37CD5601AAB85DUi64,   // 5^158
+    0x91ABB422CCB812EEUi64, 0xAC62E055C10AB33AUi64,   // 5^159
+    0xB616A12B7FE617AAUi64, 0x577B986B314D6009Ui64,   // 5^160
+    0xE39C49765FDF9D94Ui64, 0xED5A7E85FDA0B80BUi64,   // 5^161
+    0x8E41ADE9FBEBC27DUi64, 0x14588F13BE847307Ui64,   // 5^162
+    0xB1D219647AE6B31CUi64, 0x596EB2D8AE258FC8Ui64,   // 5^163
+    0xDE469FBD99A05FE3Ui64, 0x6FCA5F8ED9AEF3BBUi64,   // 5^164
+    0x8AEC23D680043BEEUi64, 0x25DE7BB9480D5854Ui64,   // 5^165
+    0xADA72CCC20054AE9Ui64, 0xAF561AA79A10AE6AUi64,   // 5^166
+    0xD910F7FF28069DA4Ui64, 0x1B2BA1518094DA04Ui64,   // 5^167
+    0x87AA9AFF79042286Ui64, 0x90FB44D2F05D0842Ui64,   // 5^168
+    0xA99541BF57452B28Ui64, 0x353A1607AC744A53Ui64,   // 5^169
+    0xD3FA922F2D1675F2Ui64, 0x42889B8997915CE8Ui64,   // 5^170
+    0x847C9B5D7C2E09B7Ui64, 0x69956135FEBADA11Ui64,   // 5^171
+    0xA59BC234DB398C25Ui64, 0x43FAB9837E699095Ui64,   // 5^172
+    0xCF02B2C21207EF2EUi64, 0x94F967E45E03F4BBUi64,   // 5^173
+    0x8161AFB94B44F57DUi64, 0x1D1BE0EEBAC278F5Ui64,   // 5^174
+    0xA1BA1BA79E1632DCUi64, 0x6462D92A69731732Ui64,   // 5^175
+    0xCA28A291859BBF93Ui64, 0x7D7B8F7503CFDCFEUi64,   // 5^176
+    0xFCB2CB35E702AF78Ui64, 0x5CDA735244C3D43EUi64,   // 5^177
+    0x9DEFBF01B061ADABUi64, 0x3A0888136AFA64A7Ui64,   // 5^178
+    0xC56BAEC21C7A1916Ui64, 0x088AAA1845B8FDD0Ui64,   // 5^179
+    0xF6C69A72A3989F5BUi64, 0x8AAD549E57273D45Ui64,   // 5^180
+    0x9A3C2087A63F6399Ui64, 0x36AC54E2F678864BUi64,   // 5^181
+    0xC0CB28A98FCF3C7FUi64, 0x84576A1BB416A7DDUi64,   // 5^182
+    0xF0FDF2D3F3C30B9FUi64, 0x656D44A2A11C51D5Ui64,   // 5^183
+    0x969EB7C47859E743Ui64, 0x9F644AE5A4B1B325Ui64,   // 5^184
+    0xBC4665B596706114Ui64, 0x873D5D9F0DDE1FEEUi64,   // 5^185
+    0xEB57FF22FC0C7959Ui64, 0xA90CB506D155A7EAUi64,   // 5^186
+    0x9316FF75DD87CBD8Ui64, 0x09A7F12442D588F2Ui64,   // 5^187
+    0xB7DCBF5354E9BECEUi64, 0x0C11ED6D538AEB2FUi64,   // 5^188
+    0xE5D3EF282A242E81Ui64, 0x8F1668C8A86DA5FAUi64,   // 5^189
+    0x8FA475791A569D10Ui64, 0xF96E017D694487BCUi64,   // 5^190
+    0xB38D92D760EC4455Ui64, 0x37C981DCC395A9ACUi64,   // 5^191
+    0xE070F78D3927556AUi64, 0x85BBE253F47B1417Ui64,   // 5^192
+    0x8C469AB843B89562Ui64, 0x93956D7478CCEC8EUi64,   // 5^193
+    0xAF58416654A6BABBUi64, 0x387AC8D1970027B2Ui64,   // 5^194
+    0xDB2E51BFE9D0696AUi64, 0x06997B05FCC0319EUi64,   // 5^195
+    0x88FCF317F22241E2Ui64, 0x441FECE3BDF81F03Ui64,   // 5^196
+    0xAB3C2FDDEEAAD25AUi64, 0xD527E81CAD7626C3Ui64,   // 5^197
+    0xD60B3BD56A5586F1Ui64, 0x8A71E223D8D3B074Ui64,   // 5^198
+    0x85C7056562757456Ui64, 0xF6872D5667844E49Ui64,   // 5^199
+    0xA738C6BEBB12D16CUi64, 0xB428F8AC016561DBUi64,   // 5^200
+    0xD106F86E69D785C7Ui64, 0xE13336D701BEBA52Ui64,   // 5^201
+    0x82A45B450226B39CUi64, 0xECC0024661173473Ui64,   // 5^202
+    0xA34D721642B06084Ui64, 0x27F002D7F95D0190Ui64,   // 5^203
+    0xCC20CE9BD35C78A5Ui64, 0x31EC038DF7B441F4Ui64,   // 5^204
+    0xFF290242C83396CEUi64, 0x7E67047175A15271Ui64,   // 5^205
+    0x9F79A169BD203E41Ui64, 0x0F0062C6E984D386Ui64,   // 5^206
+    0xC75809C42C684DD1Ui64, 0x52C07B78A3E60868Ui64,   // 5^207
+    0xF92E0C3537826145Ui64, 0xA7709A56CCDF8A82Ui64,   // 5^208
+    0x9BBCC7A142B17CCBUi64, 0x88A66076400BB691Ui64,   // 5^209
+    0xC2ABF989935DDBFEUi64, 0x6ACFF893D00EA435Ui64,   // 5^210
+    0xF356F7EBF83552FEUi64, 0x0583F6B8C4124D43Ui64,   // 5^211
+    0x98165AF37B2153DEUi64, 0xC3727A337A8B704AUi64,   // 5^212
+    0xBE1BF1B059E9A8D6Ui64, 0x744F18C0592E4C5CUi64,   // 5^213
+    0xEDA2EE1C7064130CUi64, 0x1162DEF06F79DF73Ui64,   // 5^214
+    0x9485D4D1C63E8BE7Ui64, 0x8ADDCB5645AC2BA8Ui64,   // 5^215
+    0xB9A74A0637CE2EE1Ui64, 0x6D953E2BD7173692Ui64,   // 5^216
+    0xE8111C87C5C1BA99Ui64, 0xC8FA8DB6CCDD0437Ui64,   // 5^217
+    0x910AB1D4DB9914A0Ui64, 0x1D9C9892400A22A2Ui64,   // 5^218
+    0xB54D5E4A127F59C8Ui64, 0x2503BEB6D00CAB4BUi64,   // 5^219
+    0xE2A0B5DC971F303AUi64, 0x2E44AE64840FD61DUi64,   // 5^220
+    0x8DA471A9DE737E24Ui64, 0x5CEAECFED289E5D2Ui64,   // 5^221
+    0xB10D8E1456105DADUi64, 0x7425A83E872C5F47Ui64,   // 5^222
+    0xDD50F1996B947518Ui64, 0xD12F124E28F77719Ui64,   // 5^223
+    0x8A5296FFE33CC92FUi64, 0x82BD6B70D99AAA6FUi64,   // 5^224
+    0xACE73CBFDC0BFB7BUi64, 0x636CC64D1001550BUi64,   // 5^225
+    0xD8210BEFD30EFA5AUi64, 0x3C47F7E05401AA4EUi64,   // 5^226
+    0x8714A775E3E95C78Ui64, 0x65ACFAEC34810A71Ui64,   // 5^227
+    0xA8D9D1535CE3B396Ui64, 0x7F1839A741A14D0DUi64,   // 5^228
+    0xD31045A8341CA07CUi64, 0x1EDE48111209A050Ui64,   // 5^229
+    0x83EA2B892091E44DUi64, 0x934AED0AAB460432Ui64,   // 5^230
+    0xA4E4B66B68B65D60Ui64, 0xF81DA84D5617853FUi64,   // 5^231
+    0xCE1DE40642E3F4B9Ui64, 0x36251260AB9D668EUi64,   // 5^232
+    0x80D2AE83E9CE78F3Ui64, 0xC1D72B7C6B426019Ui64,   // 5^233
+    0xA1075A24E4421730Ui64, 0xB24CF65B8612F81FUi64,   // 5^234
+    0xC94930AE1D529CFCUi64, 0xDEE033F26797B627Ui64,   // 5^235
+    0xFB9B7CD9A4A7443CUi64, 0x169840EF017DA3B1Ui64,   // 5^236
+    0x9D412E0806E88AA5Ui64, 0x8E1F289560EE864EUi64,   // 5^237
+    0xC491798A08A2AD4EUi64, 0xF1A6F2BAB92A27E2Ui64,   // 5^238
+    0xF5B5D7EC8ACB58A2Ui64, 0xAE10AF696774B1DBUi64,   // 5^239
+    0x9991A6F3D6BF1765Ui64, 0xACCA6DA1E0A8EF29Ui64,   // 5^240
+    0xBFF610B0CC6EDD3FUi64, 0x17FD090A58D32AF3Ui64,   // 5^241
+    0xEFF394DCFF8A948EUi64, 0xDDFC4B4CEF07F5B0Ui64,   // 5^242
+    0x95F83D0A1FB69CD9Ui64, 0x4ABDAF101564F98EUi64,   // 5^243
+    0xBB764C4CA7A4440FUi64, 0x9D6D1AD41ABE37F1Ui64,   // 5^244
+    0xEA53DF5FD18D5513Ui64, 0x84C86189216DC5EDUi64,   // 5^245
+    0x92746B9BE2F8552CUi64, 0x32FD3CF5B4E49BB4Ui64,   // 5^246
+    0xB7118682DBB66A77Ui64, 0x3FBC8C33221DC2A1Ui64,   // 5^247
+    0xE4D5E82392A40515Ui64, 0x0FABAF3FEAA5334AUi64,   // 5^248
+    0x8F05B1163BA6832DUi64, 0x29CB4D87F2A7400EUi64,   // 5^249
+    0xB2C71D5BCA9023F8Ui64, 0x743E20E9EF511012Ui64,   // 5^250
+    0xDF78E4B2BD342CF6Ui64, 0x914DA9246B255416Ui64,   // 5^251
+    0x8BAB8EEFB6409C1AUi64, 0x1AD089B6C2F7548EUi64,   // 5^252
+    0xAE9672ABA3D0C320Ui64, 0xA184AC2473B529B1Ui64,   // 5^253
+    0xDA3C0F568CC4F3E8Ui64, 0xC9E5D72D90A2741EUi64,   // 5^254
+    0x8865899617FB1871Ui64, 0x7E2FA67C7A658892Ui64,   // 5^255
+    0xAA7EEBFB9DF9DE8DUi64, 0xDDBB901B98FEEAB7Ui64,   // 5^256
+    0xD51EA6FA85785631Ui64, 0x552A74227F3EA565Ui64,   // 5^257
+    0x8533285C936B35DEUi64, 0xD53A88958F87275FUi64,   // 5^258
+    0xA67FF273B8460356Ui64, 0x8A892ABAF368F137Ui64,   // 5^259
+    0xD01FEF10A657842CUi64, 0x2D2B7569B0432D85Ui64,   // 5^260
+    0x8213F56A67F6B29BUi64, 0x9C3B29620E29FC73Ui64,   // 5^261
+    0xA298F2C501F45F42Ui64, 0x8349F3BA91B47B8FUi64,   // 5^262
+    0xCB3F2F7642717713Ui64, 0x241C70A936219A73Ui64,   // 5^263
+    0xFE0EFB53D30DD4D7Ui64, 0xED238CD383AA0110Ui64,   // 5^264
+    0x9EC95D1463E8A506Ui64, 0xF4363804324A40AAUi64,   // 5^265
+    0xC67BB4597CE2CE48Ui64, 0xB143C6053EDCD0D5Ui64,   // 5^266
+    0xF81AA16FDC1B81DAUi64, 0xDD94B7868E94050AUi64,   // 5^267
+    0x9B10A4E5E9913128Ui64, 0xCA7CF2B4191C8326Ui64,   // 5^268
+    0xC1D4CE1F63F57D72Ui64, 0xFD1C2F611F63A3F0Ui64,   // 5^269
+    0xF24A01A73CF2DCCFUi64, 0xBC633B39673C8CECUi64,   // 5^270
+    0x976E41088617CA01Ui64, 0xD5BE0503E085D813Ui64,   // 5^271
+    0xBD49D14AA79DBC82Ui64, 0x4B2D8644D8A74E18Ui64,   // 5^272
+    0xEC9C459D51852BA2Ui64, 0xDDF8E7D60ED1219EUi64,   // 5^273
+    0x93E1AB8252F33B45Ui64, 0xCABB90E5C942B503Ui64,   // 5^274
+    0xB8DA1662E7B00A17Ui64, 0x3D6A751F3B936243Ui64,   // 5^275
+    0xE7109BFBA19C0C9DUi64, 0x0CC512670A783AD4Ui64,   // 5^276
+    0x906A617D450187E2Ui64, 0x27FB2B80668B24C5Ui64,   // 5^277
+    0xB484F9DC9641E9DAUi64, 0xB1F9F660802DEDF6Ui64,   // 5^278
+    0xE1A63853BBD26451Ui64, 0x5E7873F8A0396973Ui64,   // 5^279
+    0x8D07E33455637EB2Ui64, 0xDB0B487B6423E1E8Ui64,   // 5^280
+    0xB049DC016ABC5E5FUi64, 0x91CE1A9A3D2CDA62Ui64,   // 5^281
+    0xDC5C5301C56B75F7Ui64, 0x7641A140CC7810FBUi64,   // 5^282
+    0x89B9B3E11B6329BAUi64, 0xA9E904C87FCB0A9DUi64,   // 5^283
+    0xAC2820D9623BF429Ui64, 0x546345FA9FBDCD44Ui64,   // 5^284
+    0xD732290FBACAF133Ui64, 0xA97C177947AD4095Ui64,   // 5^285
+    0x867F59A9D4BED6C0Ui64, 0x49ED8EABCCCC485DUi64,   // 5^286
+    0xA81F301449EE8C70Ui64, 0x5C68F256BFFF5A74Ui64,   // 5^287
+    0xD226FC195C6A2F8CUi64, 0x73832EEC6FFF3111Ui64,   // 5^288
+    0x83585D8FD9C25DB7Ui64, 0xC831FD53C5FF7EABUi64,   // 5^289
+    0xA42E74F3D032F525Ui64, 0xBA3E7CA8B77F5E55Ui64,   // 5^290
+    0xCD3A1230C43FB26FUi64, 0x28CE1BD2E55F35EBUi64,   // 5^291
+    0x80444B5E7AA7CF85Ui64, 0x7980D163CF5B81B3Ui64,   // 5^292
+    0xA0555E361951C366Ui64, 0xD7E105BCC332621FUi64,   // 5^293
+    0xC86AB5C39FA63440Ui64, 0x8DD9472BF3FEFAA7Ui64,   // 5^294
+    0xFA856334878FC150Ui64, 0xB14F98F6F0FEB951Ui64,   // 5^295
+    0x9C935E00D4B9D8D2Ui64, 0x6ED1BF9A569F33D3Ui64,   // 5^296
+    0xC3B8358109E84F07Ui64, 0x0A862F80EC4700C8Ui64,   // 5^297
+    0xF4A642E14C6262C8Ui64, 0xCD27BB612758C0FAUi64,   // 5^298
+    0x98E7E9CCCFBD7DBDUi64, 0x8038D51CB897789CUi64,   // 5^299
+    0xBF21E44003ACDD2CUi64, 0xE0470A63E6BD56C3Ui64,   // 5^300
+    0xEEEA5D5004981478Ui64, 0x1858CCFCE06CAC74Ui64,   // 5^301
+    0x95527A5202DF0CCBUi64, 0x0F37801E0C43EBC8Ui64,   // 5^302
+    0xBAA718E68396CFFDUi64, 0xD30560258F54E6BAUi64,   // 5^303
+    0xE950DF20247C83FDUi64, 0x47C6B82EF32A2069Ui64,   // 5^304
+    0x91D28B7416CDD27EUi64, 0x4CDC331D57FA5441Ui64,   // 5^305
+    0xB6472E511C81471DUi64, 0xE0133FE4ADF8E952Ui64,   // 5^306
+    0xE3D8F9E563A198E5Ui64, 0x58180FDDD97723A6Ui64,   // 5^307
+    0x8E679C2F5E44FF8FUi64, 0x570F09EAA7EA7648Ui64,   // 5^308
+};
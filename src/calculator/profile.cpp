@@ -0,0 +1,118 @@
+#include "profile.h"
+
+#include <cstdlib>
+#include "containers/string.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "keywords.h"
+#include "token.h"
+
+namespace Calculator
+{
+
+void add(OperatorProfile& total, const OperatorProfile& profile)
+{
+    for (u32 i = 0; i < (u32) OperatorCode::COUNT; i++)
+    {
+        total.invocations[i] += profile.invocations[i];
+        total.cycles[i]      += profile.cycles[i];
+    }
+}
+
+// Cycles between two reads of the counter with nothing in between (the fewest seen, the rest are interrupts)
+static u64 measure_counter_overhead()
+{
+    u64 overhead = ~0Ui64;
+    for (u32 i = 0; i < 1000; i++)
+    {
+        const u64 start = read_cycle_counter();
+        const u64 end = read_cycle_counter();
+        overhead = min(overhead, end - start);
+    }
+
+    return overhead;
+}
+
+// Negation has the same keyword as subtraction, so it gets a name of its own
+static String profile_name(OperatorCode code)
+{
+    return (code == OperatorCode::NEG) ? ref("neg") : operator_name(code);
+}
+
+struct ProfileEntry
+{
+    OperatorCode code;
+    u64 invocations;
+    u64 cycles;
+};
+
+static int compare_entries(const void* a, const void* b)
+{
+    const ProfileEntry& x = *(const ProfileEntry*) a;
+    const ProfileEntry& y = *(const ProfileEntry*) b;
+    return (x.cycles < y.cycles) - (x.cycles > y.cycles);   // Most cycles first
+}
+
+// Fills entries with the operators that were called, sorted by cycles. Returns how many there are.
+static u32 sorted_entries(const OperatorProfile& profile, u64 counter_overhead, ProfileEntry entries[])
+{
+    u32 count = 0;
+    for (u32 i = 0; i < (u32) OperatorCode::COUNT; i++)
+    {
+        if (profile.invocations[i] == 0)
+            continue;
+
+        const u64 overhead = counter_overhead * profile.invocations[i];
+        const u64 cycles = (profile.cycles[i] > overhead) ? profile.cycles[i] - overhead : 0;
+        entries[count++] = { (OperatorCode) i, profile.invocations[i], cycles };
+    }
+
+    qsort(entries, count, sizeof(ProfileEntry), compare_entries);
+    return count;
+}
+
+void print_profile(FILE* file, const OperatorProfile& profile)
+{
+    const u64 counter_overhead = measure_counter_overhead();
+
+    ProfileEntry entries[(u32) OperatorCode::COUNT];
+    const u32 count = sorted_entries(profile, counter_overhead, entries);
+
+    u64 total_cycles = 0;
+    for (u32 i = 0; i < count; i++)
+        total_cycles += entries[i].cycles;
+
+    print_to_file(file, "Operator profile (% cycles of counter overhead taken out of every call)\n", counter_overhead);
+    fprintf(file, "%-10s %14s %16s %12s %7s\n", "operator", "calls", "cycles", "cycles/call", "share");
+
+    for (u32 i = 0; i < count; i++)
+    {
+        const ProfileEntry& entry = entries[i];
+        const String name = profile_name(entry.code);
+        const f64 share = (total_cycles > 0) ? 100.0 * entry.cycles / total_cycles : 0.0;
+
+        fprintf(file, "%-10.*s %14llu %16llu %12.1f %6.1f%%\n", (int) name.size, name.data,
+                (unsigned long long) entry.invocations, (unsigned long long) entry.cycles,
+                (f64) entry.cycles / entry.invocations, share);
+    }
+}
+
+void print_profile_json(FILE* file, const OperatorProfile& profile)
+{
+    const u64 counter_overhead = measure_counter_overhead();
+
+    ProfileEntry entries[(u32) OperatorCode::COUNT];
+    const u32 count = sorted_entries(profile, counter_overhead, entries);
+
+    print_to_file(file, "{ \"counter_overhead\": %, \"operators\": [", counter_overhead);
+
+    for (u32 i = 0; i < count; i++)
+    {
+        print_to_file(file, "%{ \"name\": \"%\", \"invocations\": %, \"cycles\": % }", (i > 0) ? ", " : "",
+                      profile_name(entries[i].code), entries[i].invocations, entries[i].cycles);
+    }
+
+    print_to_file(file, "] }\n");
+}
+
+} // namespace Calculator
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdio>
+#include "core/compiler_utils.h"
+#include "core/types.h"
+#include "token.h"
+
+#if defined(GN_COMPILER_MSVC)
+    #include <intrin.h>
+#else
+    #include <x86intrin.h>
+#endif
+
+namespace Calculator
+{
+
+// How many times each operator was called and the cycles (rdtsc) spent in it, indexed by OperatorCode.
+// Only the call to the operation is timed, so popping operands and pushing the result isn't counted.
+struct OperatorProfile
+{
+    u64 invocations[(u32) OperatorCode::COUNT];
+    u64 cycles[(u32) OperatorCode::COUNT];
+};
+
+GN_FORCE_INLINE static u64 read_cycle_counter()
+{
+    return __rdtsc();
+}
+
+// Adds the invocations and cycles of profile to total (to merge the profiles of threads)
+void add(OperatorProfile& total, const OperatorProfile& profile);
+
+// Prints the operators that were called, the ones with the most cycles first. Every call also pays for
+// reading the cycle counter, that overhead is measured and taken out of the cycles.
+void print_profile(FILE* file, const OperatorProfile& profile);
+
+// Same as print_profile but as a JSON object:
+// { "counter_overhead": 18, "operators": [{ "name": "sin", "invocations": 100, "cycles": 4500 }, ...] }
+void print_profile_json(FILE* file, const OperatorProfile& profile);
+
+} // namespace Calculator
@@ -0,0 +1,342 @@
+#include "server.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "containers/darray.h"
+#include "containers/string.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "platform/platform.h"
+#include "batch.h"
+#include "error.h"
+#include "expression_cache.h"
+
+namespace Calculator
+{
+
+// Sockets are read this many bytes at a time
+constexpr u64 SERVER_READ_SIZE = 64 * 1024;
+
+struct ServerConnection
+{
+    PlatformSocket socket;
+    void* thread;
+    ExpressionCache* cache;     // Shared by all the clients
+    u32 precision;
+
+    std::atomic<bool> finished;
+};
+
+inline static u32 read_frame_size(const char* bytes)
+{
+    const u8* size = (const u8*) bytes;
+    return (u32) size[0] | ((u32) size[1] << 8) | ((u32) size[2] << 16) | ((u32) size[3] << 24);
+}
+
+inline static void write_frame_size(char* bytes, u32 size)
+{
+    bytes[0] = (char) (size & 0xFF);
+    bytes[1] = (char) ((size >> 8) & 0xFF);
+    bytes[2] = (char) ((size >> 16) & 0xFF);
+    bytes[3] = (char) ((size >> 24) & 0xFF);
+}
+
+// Returns false if the socket was closed or failed
+static bool read_more(PlatformSocket socket, DynamicArray<char>& buffer)
+{
+    if (buffer.capacity - buffer.size < SERVER_READ_SIZE)
+        resize(buffer, buffer.size + SERVER_READ_SIZE);
+
+    const s64 bytes_read = platform_socket_read(socket, buffer.data + buffer.size, buffer.capacity - buffer.size);
+    if (bytes_read <= 0)
+        return false;
+
+    buffer.size += bytes_read;
+    return true;
+}
+
+// Moves the partially read frame at the end of the buffer to the start
+static void discard_front(DynamicArray<char>& buffer, u64 byte_count)
+{
+    memmove(buffer.data, buffer.data + byte_count, buffer.size - byte_count);
+    buffer.size -= byte_count;
+}
+
+static void serve_connection(void* data)
+{
+    ServerConnection& connection = *(ServerConnection*) data;
+
+    BatchScratch scratch = make_batch_scratch(connection.cache);
+    DynamicArray<char> input  = make<DynamicArray<char>>(SERVER_READ_SIZE);
+    DynamicArray<char> output = make<DynamicArray<char>>(SERVER_READ_SIZE);
+
+    while (read_more(connection.socket, input))
+    {
+        // Every complete request in the buffer is solved and all of their responses are sent together
+        u64 offset = 0;
+        bool bad_frame = false;
+
+        while (input.size - offset >= sizeof(u32))
+        {
+            const u32 frame_size = read_frame_size(input.data + offset);
+            if (frame_size > SERVER_MAX_FRAME_SIZE)
+            {
+                bad_frame = true;
+                break;
+            }
+
+            if (input.size - offset - sizeof(u32) < frame_size)
+                break;
+
+            f64 result;
+            ExpressionError error;
+            const LineResult line_result = solve_line(ref(input.data + offset + sizeof(u32), (u64) frame_size), scratch, result, error);
+
+            // Size of the response is filled in after the result is written
+            const u64 size_offset = output.size;
+            append_many(output, "\0\0\0\0", sizeof(u32));
+            append_result(output, line_result, result, connection.precision);
+            write_frame_size(output.data + size_offset, (u32) (output.size - size_offset - sizeof(u32)));
+
+            offset += sizeof(u32) + frame_size;
+        }
+
+        if (output.size > 0 && !platform_socket_write(connection.socket, output.data, output.size))
+            break;
+
+        clear(output);
+
+        if (bad_frame)
+        {
+            print_error("Request is larger than % bytes, closing the connection!\n", SERVER_MAX_FRAME_SIZE);
+            break;
+        }
+
+        discard_front(input, offset);
+    }
+
+    platform_close_socket(connection.socket);
+
+    free(output);
+    free(input);
+    free(scratch);
+
+    connection.finished.store(true, std::memory_order_release);
+}
+
+// Joins the threads of clients that disconnected
+static void reap_connections(DynamicArray<ServerConnection*>& connections)
+{
+    for (u64 i = 0; i < connections.size;)
+    {
+        ServerConnection* connection = connections[i];
+        if (!connection->finished.load(std::memory_order_acquire))
+        {
+            i++;
+            continue;
+        }
+
+        platform_join_thread(connection->thread);
+        connection->~ServerConnection();
+        platform_free(connection);
+
+        remove_swap(connections, i);
+    }
+}
+
+void run_server(const char* socket_path, const BatchOptions& options)
+{
+    const PlatformSocket listener = platform_listen_local_socket(socket_path);
+    if (listener == PLATFORM_INVALID_SOCKET)
+    {
+        print_error("Could not listen on \"%\"!\n", socket_path);
+        return;
+    }
+
+    print_error("Listening on \"%\"\n", socket_path);
+
+    ExpressionCache cache;
+    if (options.cache_memory > 0)
+        init_expression_cache(cache, options.cache_memory);
+
+    DynamicArray<ServerConnection*> connections = make<DynamicArray<ServerConnection*>>(16Ui64);
+
+    while (true)
+    {
+        const PlatformSocket client = platform_accept_socket(listener);
+        if (client == PLATFORM_INVALID_SOCKET)
+        {
+            print_error("Could not accept a client on \"%\"!\n", socket_path);
+            break;
+        }
+
+        reap_connections(connections);
+
+        ServerConnection* connection = (ServerConnection*) platform_allocate(sizeof(ServerConnection));
+        new (connection) ServerConnection();
+        connection->socket = client;
+        connection->cache = (options.cache_memory > 0) ? &cache : nullptr;
+        connection->precision = options.precision;
+        connection->thread = platform_create_thread(serve_connection, connection);
+
+        if (!connection->thread)
+        {
+            print_error("Could not start a thread for the client!\n");
+            platform_close_socket(client);
+
+            connection->~ServerConnection();
+            platform_free(connection);
+            continue;
+        }
+
+        append(connections, connection);
+    }
+
+    // Clients are served until they disconnect
+    for (u64 i = 0; i < connections.size; i++)
+    {
+        platform_join_thread(connections[i]->thread);
+        connections[i]->~ServerConnection();
+        platform_free(connections[i]);
+    }
+
+    if (options.cache_memory > 0)
+    {
+        print_error("Expression cache: % hits, % misses, % evictions\n", cache.hit_count, cache.miss_count, cache.eviction_count);
+        free(cache);
+    }
+
+    free(connections);
+    platform_close_socket(listener);
+}
+
+static int compare_f64(const void* a, const void* b)
+{
+    const f64 x = *(const f64*) a;
+    const f64 y = *(const f64*) b;
+    return (x > y) - (x < y);
+}
+
+static f64 percentile(const DynamicArray<f64>& sorted, f64 fraction)
+{
+    u64 index = (u64) (fraction * sorted.size);
+    if (index >= sorted.size)
+        index = sorted.size - 1;
+
+    return sorted[index];
+}
+
+bool run_load_client(const char* socket_path, const String expression, u64 request_count, u32 pipeline_depth)
+{
+    if (request_count == 0 || pipeline_depth == 0)
+    {
+        print_error("Request count and pipeline depth should be more than 0!\n");
+        return false;
+    }
+
+    if (expression.size > SERVER_MAX_FRAME_SIZE)
+    {
+        print_error("Expression is larger than % bytes!\n", SERVER_MAX_FRAME_SIZE);
+        return false;
+    }
+
+    const PlatformSocket socket = platform_connect_local_socket(socket_path);
+    if (socket == PLATFORM_INVALID_SOCKET)
+    {
+        print_error("Could not connect to \"%\"!\n", socket_path);
+        return false;
+    }
+
+    DynamicArray<char> request = make<DynamicArray<char>>(expression.size + sizeof(u32));
+    request.size = sizeof(u32);
+    write_frame_size(request.data, (u32) expression.size);
+    append_many(request, expression.data, expression.size);
+
+    DynamicArray<char> input  = make<DynamicArray<char>>(SERVER_READ_SIZE);
+    DynamicArray<char> output = make<DynamicArray<char>>(pipeline_depth * request.size);
+    DynamicArray<char> first_response = make<DynamicArray<char>>(64Ui64);
+
+    DynamicArray<f64> send_times = make<DynamicArray<f64>>(request_count);
+    DynamicArray<f64> latencies  = make<DynamicArray<f64>>(request_count);
+    send_times.size = request_count;
+
+    u64 sent_count = 0;
+    u64 received_count = 0;
+    bool success = true;
+
+    const f64 start_time = platform_get_time_absolute();
+
+    while (received_count < request_count)
+    {
+        // Keep the pipeline full
+        const f64 send_time = platform_get_time_absolute();
+        while (sent_count < request_count && sent_count - received_count < pipeline_depth)
+        {
+            append_many(output, request.data, request.size);
+            send_times[sent_count++] = send_time;
+        }
+
+        if (output.size > 0 && !platform_socket_write(socket, output.data, output.size))
+        {
+            print_error("Could not send requests to the server!\n");
+            success = false;
+            break;
+        }
+
+        clear(output);
+
+        if (!read_more(socket, input))
+        {
+            print_error("Server closed the connection after % responses!\n", received_count);
+            success = false;
+            break;
+        }
+
+        const f64 receive_time = platform_get_time_absolute();
+
+        u64 offset = 0;
+        while (input.size - offset >= sizeof(u32))
+        {
+            const u32 frame_size = read_frame_size(input.data + offset);
+            if (input.size - offset - sizeof(u32) < frame_size)
+                break;
+
+            if (received_count == 0)
+                append_many(first_response, input.data + offset + sizeof(u32), frame_size);
+
+            append(latencies, receive_time - send_times[received_count++]);
+            offset += sizeof(u32) + frame_size;
+        }
+
+        discard_front(input, offset);
+    }
+
+    const f64 seconds = platform_get_time_absolute() - start_time;
+
+    if (success)
+    {
+        qsort(latencies.data, latencies.size, sizeof(f64), compare_f64);
+
+        print("Response: %\n", ref(first_response.data, first_response.size));
+        print("Sent % requests (pipeline depth %) in % s (% requests/s)\n",
+              request_count, pipeline_depth, seconds, request_count / seconds);
+        print("Latency p50: % us, p99: % us, max: % us\n",
+              percentile(latencies, 0.5) * 1000000.0, percentile(latencies, 0.99) * 1000000.0,
+              latencies[latencies.size - 1] * 1000000.0);
+    }
+
+    platform_close_socket(socket);
+
+    free(latencies);
+    free(send_times);
+    free(first_response);
+    free(output);
+    free(input);
+    free(request);
+
+    return success;
+}
+
+} // namespace Calculator
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "containers/string.h"
+#include "core/types.h"
+#include "batch.h"
+
+namespace Calculator
+{
+
+// Requests and responses are framed as a little endian u32 byte count followed by that many bytes.
+// A request is an expression and its response is the result as batch mode prints it ("error" if it
+// couldn't be solved). Clients can send requests without waiting, responses come back in order.
+constexpr u32 SERVER_MAX_FRAME_SIZE = 1024 * 1024;
+
+// Accepts clients on a Unix domain socket, each client is served on its own thread with its own
+// scratch memory. Expressions are cached for all the clients if the cache memory isn't 0.
+// Runs until the socket can't be opened or stops accepting clients, so returning always means it
+// failed (the reason is printed).
+void run_server(const char* socket_path, const BatchOptions& options);
+
+// Sends the expression request_count times with up to pipeline_depth requests in flight and
+// prints the throughput and latency percentiles.
+bool run_load_client(const char* socket_path, const String expression, u64 request_count, u32 pipeline_depth);
+
+} // namespace Calculator
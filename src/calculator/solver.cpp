@@ -1,8 +1,11 @@
 #include "solver.h"
 
+#include <cmath>
 #include "containers/darray.h"
 #include "core/logger.h"
 #include "core/types.h"
+#include "error.h"
+#include "profile.h"
 #include "token.h"
 
 namespace Calculator
@@ -13,8 +16,39 @@ using Stack = DynamicArray<T>;
 
 f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression)
 {
-    Stack<f64> number_stack = make<Stack<f64>>(expression.size / 4);
-    
+    Stack<f64> number_stack = make<Stack<f64>>(max(2Ui64, expression.size / 4));
+
+    const f64 result = solve_postfix_data(expression, number_stack);
+
+    free(number_stack);
+
+    return result;
+}
+
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, Stack<f64>& number_stack)
+{
+    return solve_postfix_data(expression, number_stack, nullptr);
+}
+
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, Stack<f64>& number_stack, const f64 variables[])
+{
+    ExpressionError error;
+    const f64 result = solve_postfix_data(expression, number_stack, variables, error);
+
+    if (error.code != ErrorCode::NONE)
+        print_error("Could not solve expression: % (element %)\n", error_message(error.code), error.offset);
+
+    return result;
+}
+
+// Operators are only timed when PROFILE is set, so the solver without a profile doesn't pay for it
+template <bool PROFILE>
+static f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, Stack<f64>& number_stack, const f64 variables[],
+                              ExpressionError& error, OperatorProfile* profile)
+{
+    clear(number_stack);
+    error.code = ErrorCode::NONE;
+
     f64 operands[3];    // Max operand count in functions is 3
 
     for (u32 i = 0; i < expression.size; i++)
@@ -25,33 +59,87 @@ f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression)
             {
                 append(number_stack, expression[i].value);
             } break;
+
+            case ExpressionElement::Type::VARIABLE:
+            {
+                gn_assert_with_message(variables, "Expression uses variables but no values were given for them! (variable index: %)", expression[i].variable.index);
+                append(number_stack, variables[expression[i].variable.index]);
+            } break;
             
             case ExpressionElement::Type::OPERATOR:
             {
-                const Operator op = expression[i].op_data;
+                const Operator& op = get_operator(expression[i].op_code);
 
                 if (op.operand_count > number_stack.size)
                 {
-                    // TODO: Show which operator the error is for
-                    print_error("Not enough operators for operator!");
+                    error = ExpressionError { ErrorCode::MISSING_OPERAND, i, op.code };
+                    return NAN;
                 }
 
                 u32 operand_count = op.operand_count;
                 while (operand_count--)
                     operands[operand_count] = pop(number_stack);
                 
-                const f64 result = op.operation(operands);
+                f64 result;
+                if constexpr (PROFILE)
+                {
+                    const u64 start_cycles = read_cycle_counter();
+                    result = op.operation(operands);
+                    profile->cycles[(u32) op.code] += read_cycle_counter() - start_cycles;
+                    profile->invocations[(u32) op.code]++;
+                }
+                else
+                    result = op.operation(operands);
+
                 append(number_stack, result);
             } break;
         }
     }
 
-    gn_assert_with_message(number_stack.size == 1, "Number stack has extra values! (numbers left: %)", number_stack.size);
+    if (number_stack.size != 1)
+    {
+        const ErrorCode code = (number_stack.size == 0) ? ErrorCode::EMPTY_EXPRESSION : ErrorCode::EXTRA_VALUES;
+        error = ExpressionError { code, (u32) expression.size, OperatorCode::COUNT };
+        return NAN;
+    }
 
-    f64 result = pop(number_stack);
-    free(number_stack);
+    return pop(number_stack);
+}
 
-    return result;
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, Stack<f64>& number_stack, const f64 variables[],
+                       ExpressionError& error)
+{
+    return solve_postfix_data<false>(expression, number_stack, variables, error, nullptr);
+}
+
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, Stack<f64>& number_stack, const f64 variables[],
+                       ExpressionError& error, OperatorProfile& profile)
+{
+    return solve_postfix_data<true>(expression, number_stack, variables, error, &profile);
+}
+
+u32 max_stack_depth(const DynamicArray<ExpressionElement>& expression)
+{
+    s64 depth = 0;
+    s64 max_depth = 0;
+
+    for (u64 i = 0; i < expression.size; i++)
+    {
+        if (expression[i].type == ExpressionElement::Type::OPERATOR)
+        {
+            const s64 operand_count = get_operator(expression[i].op_code).operand_count;
+            if (operand_count > depth)
+                return 0;
+
+            depth -= operand_count - 1;
+        }
+        else
+            depth++;
+
+        max_depth = max(max_depth, depth);
+    }
+
+    return (depth == 1) ? (u32) max_depth : 0;
 }
 
-} // namespace Calculator
+} // namespace Calculator
\ No newline at end of file
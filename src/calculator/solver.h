@@ -2,6 +2,8 @@
 
 #include "containers/darray.h"
 #include "core/types.h"
+#include "error.h"
+#include "profile.h"
 #include "token.h"
 
 namespace Calculator
@@ -9,4 +11,22 @@ namespace Calculator
 
 f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression);
 
+// Uses the given number stack as scratch space so it can be reused across calls
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, DynamicArray<f64>& number_stack);
+
+// Variable elements are read from the variables array (indexed by the variable slot)
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, DynamicArray<f64>& number_stack, const f64 variables[]);
+
+// Same as above, but malformed expressions return NaN and say why in error instead of printing it
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, DynamicArray<f64>& number_stack, const f64 variables[],
+                       ExpressionError& error);
+
+// Same as above, but also adds the calls and cycles of every operator to the profile
+f64 solve_postfix_data(const DynamicArray<ExpressionElement>& expression, DynamicArray<f64>& number_stack, const f64 variables[],
+                       ExpressionError& error, OperatorProfile& profile);
+
+// Returns the most values that will be on the number stack at once while solving the expression.
+// Returns 0 if the expression is malformed (not enough operands for an operator or values left over).
+u32 max_stack_depth(const DynamicArray<ExpressionElement>& expression);
+
 } // namespace Calculator
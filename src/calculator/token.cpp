@@ -1,43 +1,379 @@
 #include "token.h"
 
+#include <cstring>
 #include "containers/darray.h"
 #include "containers/string.h"
-#include "containers/hash.h"
+#include "platform/platform.h"
+#include "error.h"
+#include "float_parser.h"
 #include "keywords.h"
 
 namespace Calculator
 {
 
-struct OperatorOrBracket
-{
-    bool is_bracket;
-    Operator op_data;
-};
-
 inline static bool is_digit(char ch)
 {
     return (ch >= '0') && (ch <= '9');
 }
 
-inline static bool greater_precedence(const Operator& op1, const Operator& op2)
+// Binary operators up to the logical ones are written between their operands ("1 + 2", "x and y"),
+// the other operators are prefix operators or functions ("-x", "max(x, y)")
+inline static bool is_infix(const Operator& op)
 {
-    return op1.operand_count > op2.operand_count || op1.precedence >= op2.precedence;
+    return op.operand_count == 2 && op.precedence <= 4;
 }
 
-bool infix_expression_to_postfix(const String expression, DynamicArray<ExpressionElement>& elements)
+// Prefix operators are applied to their operands before any infix operator that follows them
+inline static bool greater_precedence(const Operator& op, const OperatorOrBracket& top)
 {
-    clear(elements);
-    resize(elements, max(2Ui64, expression.size / 4));
+    return top.is_prefix || op.precedence >= top.op_data.precedence;
+}
 
+bool infix_expression_to_postfix(const String expression, DynamicArray<ExpressionElement>& elements)
+{
     DynamicArray<OperatorOrBracket> temp_op_stack = make<DynamicArray<OperatorOrBracket>>(32Ui64);
 
-    Hasher<String> string_hasher;
+    const bool success = infix_expression_to_postfix(expression, elements, temp_op_stack);
+
+    free(temp_op_stack);
+
+    return success;
+}
+
+inline static bool is_identifier_start(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+}
+
+inline static bool is_identifier_char(char ch)
+{
+    return is_identifier_start(ch) || is_digit(ch);
+}
+
+// Returns the index of the first element of the operand that ends right before end, elements.size if it is incomplete
+static u64 find_operand_start(const DynamicArray<ExpressionElement>& elements, u64 end)
+{
+    u64 needed = 1;
+    while (needed > 0)
+    {
+        if (end == 0)
+            return elements.size;
+
+        end--;
+        needed--;
+
+        if (elements[end].type == ExpressionElement::Type::OPERATOR)
+            needed += get_operator(elements[end].op_code).operand_count;
+    }
+
+    return end;
+}
+
+// Caller owned buffers can't be reallocated, adding to a full one fails instead
+template <bool can_grow, typename T>
+inline static bool push(DynamicArray<T>& array, const T& value)
+{
+    if constexpr (!can_grow)
+    {
+        if (array.size == array.capacity)
+            return false;
+    }
+
+    append(array, value);
+    return true;
+}
+
+template <bool can_grow, typename T>
+inline static bool push_many(DynamicArray<T>& array, const T* values, u64 count)
+{
+    if (array.capacity - array.size < count)
+    {
+        if constexpr (!can_grow)
+            return false;
+
+        resize(array, max(2 * array.capacity, array.size + count));
+    }
+
+    platform_copy_memory(array.data + array.size, values, count * sizeof(T));
+    array.size += count;
+    return true;
+}
+
+// Records the error, always returns false so failing paths can return it directly
+inline static bool fail(ExpressionError& error, ErrorCode code, u64 offset, OperatorCode op = OperatorCode::COUNT)
+{
+    error = ExpressionError { code, (u32) offset, op };
+    return false;
+}
+
+// Replaces the arguments at the end of elements with the body of the function, the parameters in the body
+// are replaced with copies of the arguments. Fails with TOO_LARGE if that adds more than USER_FUNCTION_MAX_GROWTH
+// elements, since nested calls would otherwise grow exponentially.
+template <bool can_grow>
+static ErrorCode inline_user_function(DynamicArray<ExpressionElement>& elements, const UserFunction& function)
+{
+    u64 argument_starts[USER_FUNCTION_MAX_PARAMETERS + 1];
+    argument_starts[function.parameter_count] = elements.size;
+
+    for (u32 i = function.parameter_count; i > 0; i--)
+    {
+        argument_starts[i - 1] = find_operand_start(elements, argument_starts[i]);
+        if (argument_starts[i - 1] == elements.size)
+            return ErrorCode::MISSING_OPERAND;
+    }
+
+    const u64 arguments_start = argument_starts[0];
+    const u64 arguments_size = elements.size - arguments_start;
+
+    u64 body_size = 0;
+    for (u64 i = 0; i < function.body.size; i++)
+    {
+        const ExpressionElement& element = function.body[i];
+        body_size += (element.type == ExpressionElement::Type::VARIABLE)
+                   ? argument_starts[element.variable.index + 1] - argument_starts[element.variable.index]
+                   : 1;
+    }
+
+    if (body_size > arguments_size + USER_FUNCTION_MAX_GROWTH)
+        return ErrorCode::TOO_LARGE;
+
+    // The arguments are moved to the end of the buffer while the body is written over them
+    const u64 needed_capacity = arguments_start + body_size + arguments_size;
+    if (elements.capacity < needed_capacity)
+    {
+        if constexpr (!can_grow)
+            return ErrorCode::BUFFER_FULL;
+
+        resize(elements, needed_capacity);
+    }
+
+    ExpressionElement* arguments = elements.data + elements.capacity - arguments_size;
+    memmove(arguments, elements.data + arguments_start, arguments_size * sizeof(ExpressionElement));
+    elements.size = arguments_start;
+
+    for (u64 i = 0; i < function.body.size; i++)
+    {
+        const ExpressionElement& element = function.body[i];
+        if (element.type != ExpressionElement::Type::VARIABLE)
+        {
+            elements.data[elements.size++] = element;
+            continue;
+        }
+
+        const u32 parameter = element.variable.index;
+        const u64 argument_size = argument_starts[parameter + 1] - argument_starts[parameter];
+
+        platform_copy_memory(elements.data + elements.size, arguments + argument_starts[parameter] - arguments_start,
+                             argument_size * sizeof(ExpressionElement));
+        elements.size += argument_size;
+    }
+
+    return ErrorCode::NONE;
+}
+
+// Moves an operator from the stack to the output, offset is where the error is reported.
+// stack_depth is the number of values the output leaves on the number stack.
+template <bool can_grow>
+inline static bool pop_operator(DynamicArray<ExpressionElement>& elements, DynamicArray<OperatorOrBracket>& temp_op_stack,
+                                u32& stack_depth, ExpressionError& error, u64 offset)
+{
+    const OperatorOrBracket top = pop(temp_op_stack);
+
+    // Aggregates are expanded at their closing bracket, so this one wasn't called with brackets
+    if (top.aggregate != Aggregate::NONE)
+        return fail(error, ErrorCode::MISSING_OPERAND, offset);
+
+    if (stack_depth < top.op_data.operand_count)
+        return fail(error, ErrorCode::MISSING_OPERAND, offset, top.op_data.code);
+
+    stack_depth += 1 - top.op_data.operand_count;
+
+    if (top.function)
+    {
+        const ErrorCode code = inline_user_function<can_grow>(elements, *top.function);
+        return (code == ErrorCode::NONE) || fail(error, code, offset);
+    }
+
+    return push<can_grow>(elements, ExpressionElement(top.op_data.code)) || fail(error, ErrorCode::BUFFER_FULL, offset, top.op_data.code);
+}
+
+// Called at a comma or closing bracket, every argument has to leave exactly one value on the number stack
+inline static bool finish_argument(OperatorOrBracket& bracket, u32 stack_depth, ExpressionError& error, u64 offset)
+{
+    const u32 expected_depth = bracket.stack_depth + bracket.value_count + 1;
+    if (stack_depth != expected_depth)
+    {
+        const ErrorCode code = (stack_depth < expected_depth) ? ErrorCode::MISSING_OPERAND : ErrorCode::EXTRA_VALUES;
+        return fail(error, code, offset, bracket.op_data.code);
+    }
+
+    bracket.argument_count++;
+    bracket.value_count++;
+    return true;
+}
+
+// Sums are added up pairwise like a binary counter: after the nth value as many of the last partial
+// sums are added as n has trailing zero bits, so partial sums only get added to ones of the same size.
+inline static u32 trailing_zeros(u32 n)
+{
+    u32 count = 0;
+    for (; n != 0 && (n & 1) == 0; n >>= 1)
+        count++;
+
+    return count;
+}
+
+// Partial sums left after n values, added up once there are no more values
+inline static u32 set_bits(u32 n)
+{
+    u32 count = 0;
+    for (; n != 0; n >>= 1)
+        count += n & 1;
+
+    return count;
+}
+
+template <bool can_grow>
+inline static bool push_additions(DynamicArray<ExpressionElement>& elements, u32 count)
+{
+    for (u32 i = 0; i < count; i++)
+    {
+        if (!push<can_grow>(elements, ExpressionElement(OperatorCode::ADD)))
+            return false;
+    }
+
+    return true;
+}
+
+// Called after every argument of a sum (or mean), so arguments are added up without moving any elements
+template <bool can_grow>
+static bool add_finished_argument(DynamicArray<ExpressionElement>& elements, OperatorOrBracket& bracket, u32& stack_depth)
+{
+    const u32 additions = trailing_zeros(bracket.argument_count);
+
+    bracket.value_count -= additions;
+    stack_depth -= additions;
+
+    return push_additions<can_grow>(elements, additions);
+}
+
+constexpr u32 DOT_MAX_ARGUMENTS = 2 * USER_FUNCTION_MAX_PARAMETERS;
+
+// Replaces the arguments of dot at the end of elements with the sum of the products of the first half
+// of the arguments with the second half. Arguments are moved around like in inline_user_function.
+template <bool can_grow>
+static ErrorCode expand_dot(DynamicArray<ExpressionElement>& elements, u32 argument_count)
+{
+    if (argument_count % 2 != 0)
+        return ErrorCode::MISSING_OPERAND;
+
+    if (argument_count > DOT_MAX_ARGUMENTS)
+        return ErrorCode::EXTRA_VALUES;
+
+    // Arguments are already known to be complete
+    u64 argument_starts[DOT_MAX_ARGUMENTS + 1];
+    argument_starts[argument_count] = elements.size;
+
+    for (u32 i = argument_count; i > 0; i--)
+        argument_starts[i - 1] = find_operand_start(elements, argument_starts[i]);
+
+    const u32 half = argument_count / 2;
+    const u64 arguments_start = argument_starts[0];
+    const u64 arguments_size = elements.size - arguments_start;
+
+    // One multiplication for each pair and the products are added up
+    const u64 needed_capacity = arguments_start + 2 * arguments_size + argument_count;
+    if (elements.capacity < needed_capacity)
+    {
+        if constexpr (!can_grow)
+            return ErrorCode::BUFFER_FULL;
+
+        resize(elements, needed_capacity);
+    }
+
+    ExpressionElement* arguments = elements.data + elements.capacity - arguments_size;
+    memmove(arguments, elements.data + arguments_start, arguments_size * sizeof(ExpressionElement));
+    elements.size = arguments_start;
+
+    const auto copy_argument = [&](u32 index)
+    {
+        const u64 argument_size = argument_starts[index + 1] - argument_starts[index];
+        platform_copy_memory(elements.data + elements.size, arguments + argument_starts[index] - arguments_start,
+                             argument_size * sizeof(ExpressionElement));
+        elements.size += argument_size;
+    };
+
+    for (u32 i = 0; i < half; i++)
+    {
+        copy_argument(i);
+        copy_argument(half + i);
+        elements.data[elements.size++] = ExpressionElement(OperatorCode::MULTIPLY);
+
+        for (u32 j = trailing_zeros(i + 1); j > 0; j--)
+            elements.data[elements.size++] = ExpressionElement(OperatorCode::ADD);
+    }
+
+    for (u32 j = set_bits(half); j > 1; j--)
+        elements.data[elements.size++] = ExpressionElement(OperatorCode::ADD);
 
-    // Keeps track if '-' is unary or binary
+    return ErrorCode::NONE;
+}
+
+// Called at the closing bracket of an aggregate, leaves a single value for all the arguments
+template <bool can_grow>
+static ErrorCode expand_aggregate(DynamicArray<ExpressionElement>& elements, const OperatorOrBracket& bracket, u32& stack_depth)
+{
+    const u32 argument_count = bracket.argument_count;
+
+    if (bracket.aggregate == Aggregate::DOT)
+    {
+        stack_depth -= argument_count - 1;
+        return expand_dot<can_grow>(elements, argument_count);
+    }
+
+    // The arguments are already added up to one partial sum for each set bit of the argument count
+    const u32 additions = bracket.value_count - 1;
+    stack_depth -= additions;
+
+    if (!push_additions<can_grow>(elements, additions))
+        return ErrorCode::BUFFER_FULL;
+
+    if (bracket.aggregate == Aggregate::MEAN)
+    {
+        if (!push<can_grow>(elements, ExpressionElement((f64) argument_count)) ||
+            !push<can_grow>(elements, ExpressionElement(OperatorCode::DIVIDE)))
+            return ErrorCode::BUFFER_FULL;
+    }
+
+    return ErrorCode::NONE;
+}
+
+// Arrays are only grown if can_grow is true, otherwise running out of space is an error
+template <bool can_grow>
+static bool tokenize(const String expression, DynamicArray<ExpressionElement>& elements, DynamicArray<OperatorOrBracket>& temp_op_stack,
+                     ExpressionError& error, const String variable_names[], u32 variable_count, bool keep_sources)
+{
+    clear(elements);
+    clear(temp_op_stack);
+
+    // Only grow the array so reused arrays don't get reallocated every call
+    const u64 expected_size = max(2Ui64, expression.size / 4);
+    if (can_grow && elements.capacity < expected_size)
+        resize(elements, expected_size);
+
+    // Set while an operand is expected (at the start, after an operator or an opening bracket or comma) and
+    // cleared while an infix operator is expected (after a value or closing bracket). Also decides if '-' is unary.
     bool allow_neg = true;
     u64 current_index = 0;
 
-    bool encountered_error = false;
+    // Values the postfix expression leaves on the number stack so far, so operands are checked without solving it
+    u32 stack_depth = 0;
+
+    // Set right after a prefix operator, a bracket following it holds its arguments
+    bool after_prefix = false;
+
+    // Identifiers only have to be read whole if they can be variables or user functions
+    const bool read_identifiers = variable_count > 0 || user_function_count() > 0;
 
     while (true)
     {
@@ -59,143 +395,338 @@ bool infix_expression_to_postfix(const String expression, DynamicArray<Expressio
 
             case '(':
             {
-                OperatorOrBracket elem = OperatorOrBracket { true };
-                append(temp_op_stack, elem);
+                // A bracket right after a value ("2 (3)")
+                if (!allow_neg)
+                    return fail(error, ErrorCode::EXTRA_VALUES, current_index);
+
+                OperatorOrBracket bracket = { true };
+                bracket.stack_depth = stack_depth;
+                bracket.argument_count = 0;
+                bracket.value_count = 0;
+                bracket.offset = (u32) current_index;
+
+                if (after_prefix)
+                {
+                    const OperatorOrBracket& function = temp_op_stack[temp_op_stack.size - 1];
+                    bracket.op_data = function.op_data;
+                    bracket.aggregate = function.aggregate;
+                }
+                else
+                {
+                    bracket.op_data.operand_count = 1;
+                    bracket.op_data.code = OperatorCode::COUNT;
+                }
+
+                if (!push<can_grow>(temp_op_stack, bracket))
+                    return fail(error, ErrorCode::BUFFER_FULL, current_index);
+
+                allow_neg = true;
+                after_prefix = false;
+                current_index++;
+            } break;
+
+            // Function arguments are separated by commas
+            case ',':
+            {
+                // Finish the previous argument
+                while (temp_op_stack.size != 0 && !temp_op_stack[temp_op_stack.size - 1].is_bracket)
+                {
+                    if (!pop_operator<can_grow>(elements, temp_op_stack, stack_depth, error, current_index))
+                        return false;
+                }
+
+                if (temp_op_stack.size != 0)
+                {
+                    OperatorOrBracket& bracket = temp_op_stack[temp_op_stack.size - 1];
+                    if (!finish_argument(bracket, stack_depth, error, current_index))
+                        return false;
+
+                    // Arguments of sums are added up as they are finished
+                    const bool adds_arguments = bracket.aggregate != Aggregate::NONE && bracket.aggregate != Aggregate::DOT;
+                    if (adds_arguments && !add_finished_argument<can_grow>(elements, bracket, stack_depth))
+                        return fail(error, ErrorCode::BUFFER_FULL, current_index);
+                }
+
+                // '-' at the start of an argument is unary
+                allow_neg = true;
+                after_prefix = false;
+
                 current_index++;
             } break;
 
             case ')':
             {
-                while (!temp_op_stack[temp_op_stack.size - 1].is_bracket)
-                    append(elements, ExpressionElement(pop(temp_op_stack).op_data));
-                
+                while (temp_op_stack.size != 0 && !temp_op_stack[temp_op_stack.size - 1].is_bracket)
+                {
+                    if (!pop_operator<can_grow>(elements, temp_op_stack, stack_depth, error, current_index))
+                        return false;
+                }
+
+                // Closing bracket without an opening one
+                if (temp_op_stack.size == 0)
+                    return fail(error, ErrorCode::UNBALANCED_BRACKETS, current_index);
+
                 // Pop bracket
-                pop(temp_op_stack);
-                
+                OperatorOrBracket& bracket = temp_op_stack[temp_op_stack.size - 1];
+                if (!finish_argument(bracket, stack_depth, error, current_index))
+                    return false;
+
+                if (bracket.aggregate != Aggregate::NONE)
+                {
+                    if (bracket.aggregate != Aggregate::DOT && !add_finished_argument<can_grow>(elements, bracket, stack_depth))
+                        return fail(error, ErrorCode::BUFFER_FULL, current_index);
+
+                    const ErrorCode code = expand_aggregate<can_grow>(elements, bracket, stack_depth);
+                    if (code != ErrorCode::NONE)
+                        return fail(error, code, current_index);
+
+                    // The aggregate is done as well, it doesn't wait for its operands like other prefix operators
+                    pop(temp_op_stack);
+                    pop(temp_op_stack);
+                }
+                else if (bracket.argument_count != bracket.op_data.operand_count)
+                {
+                    const ErrorCode code = (bracket.argument_count < bracket.op_data.operand_count) ? ErrorCode::MISSING_OPERAND : ErrorCode::EXTRA_VALUES;
+                    return fail(error, code, current_index, bracket.op_data.code);
+                }
+                else
+                {
+                    pop(temp_op_stack);
+                }
+
                 // '-' after closing bracket is binary
                 allow_neg = false;
+                after_prefix = false;
 
                 current_index++;
             } break;
             
-            // Number (integer or float)
+            // Number (integer, float or hex)
             case '.':
             case '0': case '1': case '2': case '3': case '4':
             case '5': case '6': case '7': case '8': case '9':
             {
-                bool encountered_dot = (expression[current_index] == '.');
-                u64  number_size = 1;
-
-                while (true)
-                {
-                    const u64 index = current_index + number_size;
-                    
-                    // Reached end of expression
-                    if (index >= expression.size)
-                        break;
-                    
-                    if (!is_digit(expression[index]))
-                        break;
-
-                    if (expression[index] == '.')
-                    {
-                        // There should be only 1 dot in a number
-                        if (encountered_dot)
-                        {
-                            encountered_error = true;
-                            break;
-                        }
+                f64 value;
+                const u64 number_size = parse_f64(expression.data + current_index, expression.size - current_index, value);
 
-                        encountered_dot = true;
-                    }
+                // A point without digits
+                if (number_size == 0)
+                    return fail(error, ErrorCode::INVALID_NUMBER, current_index);
 
-                    number_size++;
-                }
+                if (!allow_neg)
+                    return fail(error, ErrorCode::EXTRA_VALUES, current_index);
 
-                const String substring = ref(expression.data + current_index, number_size);
-                const f64 value = atof(substring.data);
-                append(elements, ExpressionElement(value));
+                if (!push<can_grow>(elements, ExpressionElement(value, keep_sources ? (u32) current_index + 1 : 0)))
+                    return fail(error, ErrorCode::BUFFER_FULL, current_index);
 
                 current_index += number_size;
+                stack_depth++;
 
                 // '-' after a number is binary
                 allow_neg = false;
+                after_prefix = false;
             } break;
 
             default:
             {
-                // Loop over all keywords to find best match (longest match)
-                u32 keyword_index = keyword_table_size - 1;
-                for (u32 i = 0; i < keyword_table_size; i++)
+                if (read_identifiers && is_identifier_start(expression[current_index]))
                 {
-                    const KeywordData& current_keyword = keyword_table[i];
+                    // Variables have to match the whole identifier so they don't eat into keywords
+                    u64 identifier_size = 1;
+                    while (current_index + identifier_size < expression.size &&
+                           is_identifier_char(expression[current_index + identifier_size]))
+                        identifier_size++;
 
-                    // Don't check for negation if allow_neg is false
-                    if (current_keyword.type == KeywordData::Type::OPERATOR &&
-                        !allow_neg &&
-                        current_keyword.op_data.precedence == 0)
-                        continue;
+                    const String identifier = get_substring(expression, current_index, identifier_size);
 
-                    const u64 length = current_keyword.str.size;
-                    const String sub_string = get_substring(expression, current_index, length);
-                    const Hash hash = string_hasher(sub_string);
+                    u32 variable_index = variable_count;
+                    for (u32 i = 0; i < variable_count; i++)
+                    {
+                        if (identifier == variable_names[i])
+                        {
+                            variable_index = i;
+                            break;
+                        }
+                    }
+
+                    // Variables, named values and calls are all values, so they need an operator before them
+                    const bool is_known = variable_index < variable_count || find_user_function(identifier);
+                    if (is_known && !allow_neg)
+                        return fail(error, ErrorCode::EXTRA_VALUES, current_index);
+
+                    if (variable_index < variable_count)
+                    {
+                        // Variables are treated like normal numbers
+                        if (!push<can_grow>(elements, ExpressionElement(Variable { variable_index })))
+                            return fail(error, ErrorCode::BUFFER_FULL, current_index);
+
+                        current_index += identifier_size;
+                        stack_depth++;
+                        allow_neg = false;
+                        after_prefix = false;
+                        break;
+                    }
 
-                    if (hash == current_keyword.hash && sub_string == current_keyword.str)
+                    const UserFunction* function = find_user_function(identifier);
+                    if (function)
                     {
-                        // The longest matching substring is considered the correct keyword
-                        const bool is_better_match = keyword_index == (keyword_table_size - 1) || current_keyword.str.size > keyword_table[keyword_index].str.size;
-                        keyword_index = is_better_match ? i : keyword_index;
+                        // Named values are operands, functions are prefix operators like the built in ones
+                        if (function->parameter_count == 0)
+                        {
+                            if (!push_many<can_grow>(elements, function->body.data, function->body.size))
+                                return fail(error, ErrorCode::BUFFER_FULL, current_index);
+
+                            stack_depth++;
+                            allow_neg = false;
+                            after_prefix = false;
+                        }
+                        else
+                        {
+                            Operator call = {};
+                            call.operand_count = function->parameter_count;
+                            call.code = OperatorCode::COUNT;
+
+                            if (!push<can_grow>(temp_op_stack, OperatorOrBracket { false, call, true, function }))
+                                return fail(error, ErrorCode::BUFFER_FULL, current_index);
+
+                            allow_neg = true;
+                            after_prefix = true;
+                        }
+
+                        current_index += identifier_size;
+
+                        break;
                     }
                 }
 
+                // Find best match (longest match)
+                const u32 keyword_index = find_keyword(get_substring(expression, current_index), allow_neg);
+
                 const KeywordData& match = keyword_table[keyword_index];
-                current_index += match.str.size;
+                const u32 source = keep_sources ? (u32) current_index + 1 : 0;
 
                 switch (match.type)
                 {
                     // Constants are treated like normal numbers
                     case KeywordData::Type::CONSTANT:
                     {
-                        append(elements, ExpressionElement(match.value));
+                        if (!allow_neg)
+                            return fail(error, ErrorCode::EXTRA_VALUES, current_index);
+
+                        if (!push<can_grow>(elements, ExpressionElement(match.value, source)))
+                            return fail(error, ErrorCode::BUFFER_FULL, current_index);
+
+                        stack_depth++;
                         allow_neg = false;
+                        after_prefix = false;
                     } break;
 
                     case KeywordData::Type::OPERATOR:
                     {
+                        // Infix operators have to come after an operand, prefix operators and functions before one
+                        // ("* 3 4", "1 2 +" and "2 max 3" are all rejected)
+                        const bool is_prefix = !is_infix(match.op_data);
+                        if (is_prefix != allow_neg)
+                        {
+                            const ErrorCode code = is_prefix ? ErrorCode::EXTRA_VALUES : ErrorCode::MISSING_OPERAND;
+                            return fail(error, code, current_index, match.op_data.code);
+                        }
+
                         // Pop all operators with lower or same precedence till a bracket is encountered
-                        while (temp_op_stack.size != 0 &&
+                        // Prefix operators don't pop anything since their operands haven't been seen yet
+                        while (!is_prefix &&
+                               temp_op_stack.size != 0 &&
                                !temp_op_stack[temp_op_stack.size - 1].is_bracket &&
-                               greater_precedence(match.op_data, temp_op_stack[temp_op_stack.size - 1].op_data))
+                               greater_precedence(match.op_data, temp_op_stack[temp_op_stack.size - 1]))
                         {
-                            append(elements, ExpressionElement(pop(temp_op_stack).op_data));
+                            if (!pop_operator<can_grow>(elements, temp_op_stack, stack_depth, error, current_index))
+                                return false;
                         }
 
                         // Push operator into temp stack
-                        OperatorOrBracket elem = OperatorOrBracket { false, match.op_data };
-                        append(temp_op_stack, elem);
+                        if (!push<can_grow>(temp_op_stack, OperatorOrBracket { false, match.op_data, is_prefix }))
+                            return fail(error, ErrorCode::BUFFER_FULL, current_index, match.op_data.code);
 
                         allow_neg = true;
+                        after_prefix = is_prefix;
                     } break;
 
-                    case KeywordData::Type::EMPTY:
+                    case KeywordData::Type::AGGREGATE:
                     {
-                        // Do nothing right now
-                        // TODO: Maybe add a check for allowed keywords that get ignored (like comma, colon, etc.)
+                        if (!allow_neg)
+                            return fail(error, ErrorCode::EXTRA_VALUES, current_index);
+
+                        // Takes any number of arguments, so the operand count is only known at the closing bracket
+                        Operator call = {};
+                        call.operand_count = 0;
+                        call.code = OperatorCode::COUNT;
+
+                        OperatorOrBracket aggregate = { false, call, true };
+                        aggregate.aggregate = match.aggregate;
+
+                        if (!push<can_grow>(temp_op_stack, aggregate))
+                            return fail(error, ErrorCode::BUFFER_FULL, current_index);
+
+                        allow_neg = true;
+                        after_prefix = true;
                     } break;
+
+                    // Not a keyword, a variable or a user function (like "#" or "x" without variables)
+                    case KeywordData::Type::EMPTY:
+                        return fail(error, ErrorCode::UNKNOWN_SYMBOL, current_index);
                 }
+
+                current_index += match.str.size;
             } break;
         }
     }
 
-    // Add all remaining operators to expression
+    // Add all remaining operators to expression, a bracket left on the stack was never closed
     while (temp_op_stack.size > 0)
     {
-        append(elements, ExpressionElement(pop(temp_op_stack).op_data));
+        const OperatorOrBracket& top = temp_op_stack[temp_op_stack.size - 1];
+        if (top.is_bracket)
+            return fail(error, ErrorCode::UNBALANCED_BRACKETS, top.offset);
+
+        if (!pop_operator<can_grow>(elements, temp_op_stack, stack_depth, error, expression.size))
+            return false;
     }
 
-    free(temp_op_stack);
+    if (stack_depth != 1)
+    {
+        const ErrorCode code = (stack_depth == 0) ? ErrorCode::EMPTY_EXPRESSION : ErrorCode::EXTRA_VALUES;
+        return fail(error, code, expression.size);
+    }
+
+    return true;
+}
+
+bool infix_expression_to_postfix(const String expression, DynamicArray<ExpressionElement>& elements, DynamicArray<OperatorOrBracket>& temp_op_stack,
+                                 const String variable_names[], u32 variable_count)
+{
+    ExpressionError error;
+    return tokenize<true>(expression, elements, temp_op_stack, error, variable_names, variable_count, false);
+}
+
+bool infix_expression_to_postfix(const String expression, DynamicArray<ExpressionElement>& elements, DynamicArray<OperatorOrBracket>& temp_op_stack,
+                                 ExpressionError& error, const String variable_names[], u32 variable_count, bool keep_sources)
+{
+    error.code = ErrorCode::NONE;
+    return tokenize<true>(expression, elements, temp_op_stack, error, variable_names, variable_count, keep_sources);
+}
+
+bool infix_expression_to_postfix(const String expression, TokenBuffers& buffers, ExpressionError& error,
+                                 const String variable_names[], u32 variable_count)
+{
+    // The buffers are only borrowed, these arrays are never resized or freed
+    DynamicArray<ExpressionElement> elements = { buffers.elements, 0, buffers.element_capacity };
+    DynamicArray<OperatorOrBracket> op_stack = { buffers.op_stack, 0, buffers.op_stack_capacity };
+
+    error.code = ErrorCode::NONE;
+    const bool success = tokenize<false>(expression, elements, op_stack, error, variable_names, variable_count, false);
+    buffers.element_count = elements.size;
 
-    return !encountered_error;
+    return success;
 }
 
-} // namespace Calculator
\ No newline at end of file
+} // namespace Calculator
@@ -10,11 +10,79 @@ namespace Calculator
 
 using Operation = Function<f64(f64[])>;
 
+// Identifies the operation an operator performs (one for each function in opdef.h)
+enum struct OperatorCode : u32
+{
+    NEG,
+    MULTIPLY,
+    DIVIDE,
+    REMAINDER,
+    ADD,
+    SUBTRACT,
+    POW,
+    AND,
+    OR,
+    NOT,
+    GREATER,
+    LESSER,
+    GREATER_EQUAL,
+    LESSER_EQUAL,
+    EQUAL,
+    NOT_EQUAL,
+    NATURAL_LOG,
+    LOG,
+    SIN,
+    COS,
+    TAN,
+    SEC,
+    COSEC,
+    COT,
+    SINH,
+    COSH,
+    TANH,
+    SQRT,
+    EXP,
+    MAX,
+    MIN,
+    COND,
+
+    COUNT
+};
+
+// Functions that take any number of arguments. Calls are expanded into additions (and multiplications
+// or a division) of the arguments when tokenizing, so the evaluators never see them.
+enum struct Aggregate : u32
+{
+    NONE,
+    SUM,            // sum(a, b, ...), added pairwise
+    MEAN,           // mean(a, b, ...)
+    DOT,            // dot(a1, a2, ..., b1, b2, ...), the first half of the arguments times the second half
+};
+
 struct Operator
 {
     Operation operation;
     u32 operand_count;
     u32 precedence;
+    OperatorCode code;
+};
+
+// Every operator by its code, built from keyword_table (keywords.cpp) when the program starts
+struct OperatorTable
+{
+    Operator operators[(u32) OperatorCode::COUNT];
+};
+
+extern const OperatorTable operator_table;
+
+inline const Operator& get_operator(OperatorCode code)
+{
+    return operator_table.operators[(u32) code];
+}
+
+struct Variable
+{
+    u32 index;
 };
 
 struct ExpressionElement
@@ -23,23 +91,32 @@ struct ExpressionElement
     {
         NUMBER,
         OPERATOR,
+        VARIABLE,
     };
 
     Type type;
+    u32 source;     // Numbers only: offset of their text in the expression + 1, 0 if it wasn't kept (see infix_expression_to_postfix)
 
+    // Operators only keep their code so elements stay 16 bytes, the rest is in operator_table
     union
     {
         f64 value;
-        Operator op_data;
+        OperatorCode op_code;
+        Variable variable;
     };
 
-    ExpressionElement(f64 value)
-    :   type(Type::NUMBER), value(value)
+    ExpressionElement(f64 value, u32 source = 0)
+    :   type(Type::NUMBER), source(source), value(value)
     {
     }
 
-    ExpressionElement(Operator op_data)
-    :   type(Type::OPERATOR), op_data(op_data)
+    ExpressionElement(OperatorCode op_code)
+    :   type(Type::OPERATOR), op_code(op_code)
+    {
+    }
+
+    ExpressionElement(Variable variable)
+    :   type(Type::VARIABLE), variable(variable)
     {
     }
 
@@ -55,6 +132,58 @@ struct ExpressionElement
     }
 };
 
+static_assert(sizeof(ExpressionElement) == 16, "Expression elements should stay small, they are what evaluators loop over!");
+
+struct UserFunction;
+struct ExpressionError;
+
+struct OperatorOrBracket
+{
+    bool is_bracket;
+    Operator op_data;   // For brackets this is the function the arguments are for (operand_count of 1 and code COUNT otherwise,
+                        // 0 for aggregates since they take any number of arguments)
+    bool is_prefix;     // Functions and unary operators come before their operands
+    const UserFunction* function;   // Call to a user function, the body is inlined when it is popped
+    Aggregate aggregate;            // Call to an aggregate, expanded once its closing bracket is reached
+
+    // Only used by brackets to check that every argument is a single value
+    u32 stack_depth;    // Values on the number stack before the bracket
+    u32 argument_count; // Arguments finished so far
+    u32 value_count;    // Values the finished arguments left on the stack (fewer than the arguments once a sum adds them up)
+    u32 offset;         // Where the bracket is in the expression
+};
+
 bool infix_expression_to_postfix(const String expression, DynamicArray<ExpressionElement>& elements);
 
+// Uses the given operator stack as scratch space so it can be reused across calls.
+// Identifiers matching one of the variable names are turned into variable slots (index into variable_names).
+// Calls to user functions (see define_function) are replaced with their bodies.
+// Brackets, operand counts and the argument counts of functions are checked while tokenizing, so the
+// postfix expression can always be solved if this returns true.
+bool infix_expression_to_postfix(const String expression, DynamicArray<ExpressionElement>& elements, DynamicArray<OperatorOrBracket>& temp_op_stack,
+                                 const String variable_names[] = nullptr, u32 variable_count = 0);
+
+// Same as above, but says why the expression couldn't be tokenized (see error.h).
+// With keep_sources the numbers and constants written in the expression remember where their text is, so they can
+// be parsed again with more precision than f64. The offsets are only valid for this text, don't cache those elements.
+bool infix_expression_to_postfix(const String expression, DynamicArray<ExpressionElement>& elements, DynamicArray<OperatorOrBracket>& temp_op_stack,
+                                 ExpressionError& error, const String variable_names[] = nullptr, u32 variable_count = 0,
+                                 bool keep_sources = false);
+
+// Caller owned memory for the tokenizer, it is never reallocated or freed
+struct TokenBuffers
+{
+    ExpressionElement* elements;
+    u64 element_capacity;
+    u64 element_count;          // Set by the tokenizer
+
+    OperatorOrBracket* op_stack;
+    u64 op_stack_capacity;
+};
+
+// Same as above but never allocates memory. Returns false if the expression is malformed or the
+// buffers are too small for it (ErrorCode::BUFFER_FULL).
+bool infix_expression_to_postfix(const String expression, TokenBuffers& buffers, ExpressionError& error,
+                                 const String variable_names[] = nullptr, u32 variable_count = 0);
+
 } // namespace Calculator
@@ -0,0 +1,636 @@
+#include "vector_math.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include "core/compiler_utils.h"
+#include "core/types.h"
+#include "lanes.h"
+
+namespace Calculator
+{
+
+GN_FORCE_INLINE static Lane lane_set_bits(u64 bits)
+{
+    f64 value;
+    memcpy(&value, &bits, sizeof(value));
+    return lane_set(value);
+}
+
+constexpr u64 SIGN_BITS     = 0x8000000000000000Ui64;
+constexpr u64 MANTISSA_BITS = 0x000FFFFFFFFFFFFFUi64;
+constexpr u64 ONE_BITS      = 0x3FF0000000000000Ui64;
+constexpr u64 TWO_52_BITS   = 0x4330000000000000Ui64;
+
+constexpr f64 ROUNDING_MAGIC = 6755399441055744.0;     // 1.5 * 2^52, adding it rounds away the fraction
+
+GN_FORCE_INLINE static Lane lane_abs(Lane a)        { return lane_and(a, lane_set_bits(~SIGN_BITS)); }
+GN_FORCE_INLINE static Lane lane_sign(Lane a)       { return lane_and(a, lane_set_bits(SIGN_BITS)); }
+GN_FORCE_INLINE static Lane lane_is_nan(Lane a)     { return lane_not_equal(a, a); }
+GN_FORCE_INLINE static Lane lane_not(Lane mask)     { return lane_xor(mask, lane_set_bits(~0Ui64)); }
+
+// Rounds to the nearest integer (ties to even), only valid while |a| < 2^51
+GN_FORCE_INLINE static Lane lane_round(Lane a)
+{
+    return lane_sub(lane_add(a, lane_set(ROUNDING_MAGIC)), lane_set(ROUNDING_MAGIC));
+}
+
+GN_FORCE_INLINE static Lane lane_floor(Lane a)
+{
+    const Lane rounded = lane_round(a);
+    return lane_sub(rounded, lane_and(lane_greater(rounded, a), lane_set(1.0)));
+}
+
+// 2^k for integer k in [-1022, 1023], built straight from the exponent bits. Adding the magic number
+// leaves k + 1023 in the low bits of the mantissa and the shift moves them into the exponent.
+GN_FORCE_INLINE static Lane lane_pow2(Lane k)
+{
+    return lane_shift_exponent_up(lane_add(k, lane_set(ROUNDING_MAGIC + 1023.0)));
+}
+
+// Splits positive normal numbers into m * 2^k with m in [sqrt(2)/2, sqrt(2))
+GN_FORCE_INLINE static void lane_split_exponent(Lane x, Lane& m, Lane& k)
+{
+    // The biased exponent is put in the mantissa of 2^52, subtracting 2^52 then gives it as a double
+    const Lane biased = lane_sub(lane_or(lane_shift_exponent_down(x), lane_set_bits(TWO_52_BITS)), lane_set_bits(TWO_52_BITS));
+    m = lane_or(lane_and(x, lane_set_bits(MANTISSA_BITS)), lane_set_bits(ONE_BITS));
+
+    const Lane halve = lane_greater(m, lane_set(1.41421356237309504880));
+    m = lane_select(halve, lane_mul(m, lane_set(0.5)), m);
+    k = lane_add(lane_sub(biased, lane_set(1023.0)), lane_and(halve, lane_set(1.0)));
+}
+
+// The lanes set in special are solved by libm instead, this is rare enough that it doesn't need to be fast
+static Lane solve_special_lanes(Lane result, Lane special, Lane x, f64 (*function)(f64))
+{
+    const u32 bits = lane_mask_bits(special);
+    if (!bits)
+        return result;
+
+    f64 values[LANE_WIDTH], results[LANE_WIDTH];
+    lane_store(values, x);
+    lane_store(results, result);
+
+    for (u64 i = 0; i < LANE_WIDTH; i++)
+    {
+        if (bits & (1 << i))
+            results[i] = function(values[i]);
+    }
+
+    return lane_load(results);
+}
+
+#ifdef CALCULATOR_LANES_AVX   // pow is the only function of two arguments, and it needs AVX (see vector_pow)
+
+static Lane solve_special_lanes(Lane result, Lane special, Lane a, Lane b, f64 (*function)(f64, f64))
+{
+    const u32 bits = lane_mask_bits(special);
+    if (!bits)
+        return result;
+
+    f64 a_values[LANE_WIDTH], b_values[LANE_WIDTH], results[LANE_WIDTH];
+    lane_store(a_values, a);
+    lane_store(b_values, b);
+    lane_store(results, result);
+
+    for (u64 i = 0; i < LANE_WIDTH; i++)
+    {
+        if (bits & (1 << i))
+            results[i] = function(a_values[i], b_values[i]);
+    }
+
+    return lane_load(results);
+}
+
+#endif // CALCULATOR_LANES_AVX
+
+// Error free transformations, the rounding error of the operation ends up in error
+
+GN_FORCE_INLINE static void lane_two_sum(Lane a, Lane b, Lane& sum, Lane& error)
+{
+    sum = lane_add(a, b);
+    const Lane v = lane_sub(sum, a);
+    error = lane_add(lane_sub(a, lane_sub(sum, v)), lane_sub(b, v));
+}
+
+#ifdef CALCULATOR_LANES_AVX   // Only used by pow
+
+GN_FORCE_INLINE static void lane_quick_two_sum(Lane a, Lane b, Lane& sum, Lane& error)  // Only valid when |a| >= |b|
+{
+    sum = lane_add(a, b);
+    error = lane_sub(b, lane_sub(sum, a));
+}
+
+// Same as two_prod in double_double.h. Dekker's product has to be used without FMA, with it the compiler
+// could also fuse the multiplies in Dekker's product and lose the error it's computing.
+GN_FORCE_INLINE static void lane_two_prod(Lane a, Lane b, Lane& product, Lane& error)
+{
+    product = lane_mul(a, b);
+
+#if defined(__FMA__) || defined(__AVX2__)
+    error = _mm256_fmsub_pd(a, b, product);
+#else
+    const Lane splitter = lane_set(134217729.0);    // 2^27 + 1
+
+    const Lane ta = lane_mul(splitter, a);
+    const Lane a_hi = lane_sub(ta, lane_sub(ta, a));
+    const Lane a_lo = lane_sub(a, a_hi);
+
+    const Lane tb = lane_mul(splitter, b);
+    const Lane b_hi = lane_sub(tb, lane_sub(tb, b));
+    const Lane b_lo = lane_sub(b, b_hi);
+
+    error = lane_add(lane_add(lane_add(lane_sub(lane_mul(a_hi, b_hi), product), lane_mul(a_hi, b_lo)), lane_mul(a_lo, b_hi)), lane_mul(a_lo, b_lo));
+#endif
+}
+
+#endif // CALCULATOR_LANES_AVX
+
+// Exponential (fdlibm e_exp.c and s_expm1.c)
+
+constexpr f64 LN2_HI  = 6.93147180369123816490e-01;    // Top 32 bits of ln(2), k * LN2_HI is exact
+constexpr f64 LN2_LO  = 1.90821492927058770002e-10;
+constexpr f64 INV_LN2 = 1.44269504088896338700e+00;
+
+// ln(2) rounded to a double and what's left over
+constexpr f64 LN2      = 6.93147180559945286227e-01;
+constexpr f64 LN2_TAIL = 2.31904681384629955842e-17;
+
+// Arguments where the result is a normal number
+constexpr f64 EXP_MAX = 709.0;
+constexpr f64 EXP_MIN = -708.0;
+
+// exp(r) - 1 for r = hi - lo, |r| <= ln(2) / 2
+GN_FORCE_INLINE static Lane exp_kernel(Lane hi, Lane lo)
+{
+    const Lane r = lane_sub(hi, lo);
+    const Lane z = lane_mul(r, r);
+
+    // Remez polynomial of r * (exp(r) + 1) / (exp(r) - 1), error below 2^-59
+    Lane p = lane_set(4.13813679705723846039e-08);
+    p = lane_add(lane_mul(p, z), lane_set(-1.65339022054652515390e-06));
+    p = lane_add(lane_mul(p, z), lane_set(6.61375632143793436117e-05));
+    p = lane_add(lane_mul(p, z), lane_set(-2.77777777770155933842e-03));
+    p = lane_add(lane_mul(p, z), lane_set(1.66666666666666019037e-01));
+    const Lane c = lane_sub(r, lane_mul(z, p));
+
+    // exp(r) - 1 = r + r * c / (2 - c), written so lo is added last
+    return lane_sub(hi, lane_sub(lo, lane_div(lane_mul(r, c), lane_sub(lane_set(2.0), c))));
+}
+
+// Reduces x + tail to k * ln(2) + hi - lo with |hi - lo| <= ln(2) / 2. |tail| has to be much smaller than ulp(x).
+GN_FORCE_INLINE static void reduce_ln2(Lane x, Lane tail, Lane& hi, Lane& lo, Lane& k)
+{
+    k  = lane_round(lane_mul(x, lane_set(INV_LN2)));
+    hi = lane_sub(x, lane_mul(k, lane_set(LN2_HI)));
+    lo = lane_sub(lane_mul(k, lane_set(LN2_LO)), tail);
+}
+
+// exp(x + tail), x has to be in [EXP_MIN, EXP_MAX]
+GN_FORCE_INLINE static Lane exp_with_tail(Lane x, Lane tail)
+{
+    Lane hi, lo, k;
+    reduce_ln2(x, tail, hi, lo, k);
+
+    return lane_mul(lane_add(lane_set(1.0), exp_kernel(hi, lo)), lane_pow2(k));
+}
+
+// exp(x) - 1 without the cancellation around 0, x has to be in [EXP_MIN, EXP_MAX]
+GN_FORCE_INLINE static Lane lane_expm1(Lane x)
+{
+    Lane hi, lo, k;
+    reduce_ln2(x, lane_set(0.0), hi, lo, k);
+
+    // 2^k * (exp(r) - 1) + 2^k - 1, the sum only cancels out when k is 0
+    const Lane scale = lane_pow2(k);
+    return lane_add(lane_mul(scale, exp_kernel(hi, lo)), lane_sub(scale, lane_set(1.0)));
+}
+
+static Lane lane_exp(Lane x)
+{
+    const Lane result  = exp_with_tail(lane_min(lane_max(x, lane_set(EXP_MIN)), lane_set(EXP_MAX)), lane_set(0.0));
+    const Lane special = lane_or(lane_greater(x, lane_set(EXP_MAX)), lane_or(lane_lesser(x, lane_set(EXP_MIN)), lane_is_nan(x)));
+
+    return solve_special_lanes(result, special, x, exp);
+}
+
+// Natural logarithm (fdlibm e_log.c)
+
+static Lane lane_log(Lane x)
+{
+    // Subnormals, zero, negative numbers, infinity and NaN go to libm
+    const Lane special = lane_or(lane_is_nan(x), lane_or(lane_lesser(x, lane_set(DBL_MIN)), lane_equal(x, lane_set(INFINITY))));
+    const Lane normal = lane_select(special, lane_set(1.0), x);
+
+    Lane m, k;
+    lane_split_exponent(normal, m, k);
+
+    // log(m) = log(1 + f) = f - f^2 / 2 + s * (f^2 / 2 + R(s^2)) with s = f / (2 + f)
+    const Lane f    = lane_sub(m, lane_set(1.0));
+    const Lane hfsq = lane_mul(lane_set(0.5), lane_mul(f, f));
+    const Lane s    = lane_div(f, lane_add(lane_set(2.0), f));
+    const Lane z    = lane_mul(s, s);
+    const Lane w    = lane_mul(z, z);
+
+    // Remez polynomial for (log(1 + s) - log(1 - s) - 2s) / s split into even and odd terms, error below 2^-58
+    Lane t1 = lane_set(1.531383769920937332e-01);
+    t1 = lane_add(lane_mul(t1, w), lane_set(2.222219843214978396e-01));
+    t1 = lane_add(lane_mul(t1, w), lane_set(3.999999999940941908e-01));
+    t1 = lane_mul(t1, w);
+
+    Lane t2 = lane_set(1.479819860511658591e-01);
+    t2 = lane_add(lane_mul(t2, w), lane_set(1.818357216161805012e-01));
+    t2 = lane_add(lane_mul(t2, w), lane_set(2.857142874366239149e-01));
+    t2 = lane_add(lane_mul(t2, w), lane_set(6.666666666666735130e-01));
+    t2 = lane_mul(t2, z);
+
+    const Lane r = lane_add(t1, t2);
+
+    // k * LN2_HI - ((hfsq - (s * (hfsq + r) + k * LN2_LO)) - f)
+    const Lane low_terms = lane_add(lane_mul(s, lane_add(hfsq, r)), lane_mul(k, lane_set(LN2_LO)));
+    const Lane result = lane_sub(lane_mul(k, lane_set(LN2_HI)), lane_sub(lane_sub(hfsq, low_terms), f));
+
+    return solve_special_lanes(result, special, x, log);
+}
+
+// Sine, cosine and tangent (fdlibm k_sin.c, k_cos.c and the medium case of e_rem_pio2.c)
+
+constexpr f64 TRIG_MAX = 524288.0;     // 2^19, the quadrant has to fit in 20 bits for the reduction to be exact
+
+// Reduces x to y_hi + y_lo in [-pi/4, pi/4] and the quadrant (x = y + quadrant * pi / 2) mod 4
+GN_FORCE_INLINE static void reduce_half_pi(Lane x, Lane& y_hi, Lane& y_lo, Lane& quadrant)
+{
+    const Lane n = lane_round(lane_mul(x, lane_set(6.36619772367581382433e-01)));
+
+    // pi / 2 is split into three parts of 33 bits, each n * part is exact. Every step keeps track of
+    // its rounding error in w, which gets the reduced argument right to about 150 bits.
+    Lane r = lane_sub(x, lane_mul(n, lane_set(1.57079632673412561417e+00)));
+
+    Lane t = r;
+    Lane w = lane_mul(n, lane_set(6.07710050630396597660e-11));
+    r = lane_sub(t, w);
+    w = lane_sub(lane_mul(n, lane_set(2.02226624879595063154e-21)), lane_sub(lane_sub(t, r), w));
+
+    t = r;
+    w = lane_mul(n, lane_set(2.02226624871116645580e-21));
+    r = lane_sub(t, w);
+    w = lane_sub(lane_mul(n, lane_set(8.47842766036889956997e-32)), lane_sub(lane_sub(t, r), w));
+
+    y_hi = lane_sub(r, w);
+    y_lo = lane_sub(lane_sub(r, y_hi), w);
+
+    quadrant = lane_sub(n, lane_mul(lane_set(4.0), lane_floor(lane_mul(n, lane_set(0.25)))));
+}
+
+// sin(x + y) for |x| <= pi/4 and |y| much smaller than ulp(x)
+GN_FORCE_INLINE static Lane sin_kernel(Lane x, Lane y)
+{
+    const Lane z = lane_mul(x, x);
+    const Lane v = lane_mul(z, x);
+
+    Lane r = lane_set(1.58969099521155010221e-10);
+    r = lane_add(lane_mul(r, z), lane_set(-2.50507602534068634195e-08));
+    r = lane_add(lane_mul(r, z), lane_set(2.75573137070700676789e-06));
+    r = lane_add(lane_mul(r, z), lane_set(-1.98412698298579493134e-04));
+    r = lane_add(lane_mul(r, z), lane_set(8.33333333332248946124e-03));
+
+    // x - ((z * (y / 2 - v * r) - y) - v * S1)
+    const Lane inner = lane_sub(lane_mul(z, lane_sub(lane_mul(lane_set(0.5), y), lane_mul(v, r))), y);
+    return lane_sub(x, lane_sub(inner, lane_mul(v, lane_set(-1.66666666666666324348e-01))));
+}
+
+// cos(x + y) for |x| <= pi/4 and |y| much smaller than ulp(x)
+GN_FORCE_INLINE static Lane cos_kernel(Lane x, Lane y)
+{
+    const Lane z = lane_mul(x, x);
+
+    Lane r = lane_set(-1.13596475577881948265e-11);
+    r = lane_add(lane_mul(r, z), lane_set(2.08757232129817482790e-09));
+    r = lane_add(lane_mul(r, z), lane_set(-2.75573143513906633035e-07));
+    r = lane_add(lane_mul(r, z), lane_set(2.48015872894767294178e-05));
+    r = lane_add(lane_mul(r, z), lane_set(-1.38888888888741095749e-03));
+    r = lane_add(lane_mul(r, z), lane_set(4.16666666666666019037e-02));
+    r = lane_mul(r, z);
+
+    // 1 - z / 2 is rounded to w, the rounding error is added back with the rest of the terms
+    const Lane hz = lane_mul(lane_set(0.5), z);
+    const Lane w  = lane_sub(lane_set(1.0), hz);
+    const Lane rest = lane_add(lane_sub(lane_sub(lane_set(1.0), w), hz), lane_sub(lane_mul(z, r), lane_mul(x, y)));
+
+    return lane_add(w, rest);
+}
+
+// The quadrant swaps sine and cosine and flips their signs
+GN_FORCE_INLINE static Lane sin_quadrant(Lane quadrant, Lane s, Lane c)
+{
+    const Lane swap = lane_or(lane_equal(quadrant, lane_set(1.0)), lane_equal(quadrant, lane_set(3.0)));
+    const Lane negate = lane_greater_equal(quadrant, lane_set(2.0));
+
+    return lane_xor(lane_select(swap, c, s), lane_and(negate, lane_set_bits(SIGN_BITS)));
+}
+
+GN_FORCE_INLINE static Lane cos_quadrant(Lane quadrant, Lane s, Lane c)
+{
+    const Lane swap = lane_or(lane_equal(quadrant, lane_set(1.0)), lane_equal(quadrant, lane_set(3.0)));
+    const Lane negate = lane_or(lane_equal(quadrant, lane_set(1.0)), lane_equal(quadrant, lane_set(2.0)));
+
+    return lane_xor(lane_select(swap, s, c), lane_and(negate, lane_set_bits(SIGN_BITS)));
+}
+
+// Huge arguments need a reduction with many more bits of pi / 2 (infinity and NaN also end up here)
+GN_FORCE_INLINE static Lane trig_special(Lane x)
+{
+    return lane_not(lane_lesser_equal(lane_abs(x), lane_set(TRIG_MAX)));
+}
+
+static Lane lane_sin(Lane x)
+{
+    const Lane special = trig_special(x);
+
+    Lane y_hi, y_lo, quadrant;
+    reduce_half_pi(lane_select(special, lane_set(0.0), x), y_hi, y_lo, quadrant);
+
+    Lane result;
+    if (lane_mask_bits(lane_equal(quadrant, lane_set(0.0))) == (1 << LANE_WIDTH) - 1)
+        result = sin_kernel(y_hi, y_lo);   // Small arguments don't need the cosine
+    else
+        result = sin_quadrant(quadrant, sin_kernel(y_hi, y_lo), cos_kernel(y_hi, y_lo));
+
+    return solve_special_lanes(result, special, x, sin);
+}
+
+static Lane lane_cos(Lane x)
+{
+    const Lane special = trig_special(x);
+
+    Lane y_hi, y_lo, quadrant;
+    reduce_half_pi(lane_select(special, lane_set(0.0), x), y_hi, y_lo, quadrant);
+
+    Lane result;
+    if (lane_mask_bits(lane_equal(quadrant, lane_set(0.0))) == (1 << LANE_WIDTH) - 1)
+        result = cos_kernel(y_hi, y_lo);
+    else
+        result = cos_quadrant(quadrant, sin_kernel(y_hi, y_lo), cos_kernel(y_hi, y_lo));
+
+    return solve_special_lanes(result, special, x, cos);
+}
+
+static Lane lane_tan(Lane x)
+{
+    const Lane special = trig_special(x);
+
+    Lane y_hi, y_lo, quadrant;
+    reduce_half_pi(lane_select(special, lane_set(0.0), x), y_hi, y_lo, quadrant);
+
+    const Lane s = sin_kernel(y_hi, y_lo);
+    const Lane c = cos_kernel(y_hi, y_lo);
+    const Lane result = lane_div(sin_quadrant(quadrant, s, c), cos_quadrant(quadrant, s, c));
+
+    return solve_special_lanes(result, special, x, tan);
+}
+
+// Hyperbolic functions (fdlibm e_sinh.c, e_cosh.c and s_tanh.c)
+
+constexpr f64 HYPERBOLIC_LARGE = 22.0;  // Above this exp(-x) is too small to change the result
+
+// exp(a) / 2 for a in (HYPERBOLIC_LARGE, EXP_MAX], halved before taking exp so it doesn't overflow early.
+// The rounding error of a - ln(2) is passed on as the tail.
+GN_FORCE_INLINE static Lane half_exp(Lane a)
+{
+    Lane x, x_error;
+    lane_two_sum(a, lane_set(-LN2), x, x_error);
+
+    return exp_with_tail(x, lane_sub(x_error, lane_set(LN2_TAIL)));
+}
+
+#ifdef CALCULATOR_LANES_AVX   // Only used by cosh
+
+// cosh(x) for |x| <= 1, Taylor series up to x^20 / 20!
+GN_FORCE_INLINE static Lane cosh_series(Lane x)
+{
+    const Lane z = lane_mul(x, x);
+
+    Lane p = lane_set(4.1103176233121648e-19);
+    p = lane_add(lane_mul(p, z), lane_set(1.5619206968586226e-16));
+    p = lane_add(lane_mul(p, z), lane_set(4.7794773323873853e-14));
+    p = lane_add(lane_mul(p, z), lane_set(1.1470745597729725e-11));
+    p = lane_add(lane_mul(p, z), lane_set(2.0876756987868099e-09));
+    p = lane_add(lane_mul(p, z), lane_set(2.7557319223985891e-07));
+    p = lane_add(lane_mul(p, z), lane_set(2.4801587301587302e-05));
+    p = lane_add(lane_mul(p, z), lane_set(1.3888888888888889e-03));
+    p = lane_add(lane_mul(p, z), lane_set(4.1666666666666667e-02));
+    p = lane_add(lane_mul(p, z), lane_set(0.5));
+
+    return lane_add(lane_set(1.0), lane_mul(z, p));
+}
+
+#endif // CALCULATOR_LANES_AVX
+
+// Arguments past this overflow (or are too close to it for half_exp), infinity and NaN also end up here
+GN_FORCE_INLINE static Lane hyperbolic_special(Lane x)
+{
+    return lane_not(lane_lesser_equal(lane_abs(x), lane_set(EXP_MAX)));
+}
+
+static Lane lane_sinh(Lane x)
+{
+    const Lane special = hyperbolic_special(x);
+    const Lane a = lane_abs(lane_select(special, lane_set(0.0), x));
+
+    // With t = exp(a) - 1, sinh(a) = (t + t / (t + 1)) / 2 = (2t - t^2 / (t + 1)) / 2
+    const Lane t = lane_expm1(lane_min(a, lane_set(HYPERBOLIC_LARGE)));
+    const Lane t_over = lane_div(t, lane_add(t, lane_set(1.0)));
+    const Lane small = lane_sub(lane_add(t, t), lane_mul(t, t_over));
+    const Lane moderate = lane_add(t, t_over);
+
+    Lane result = lane_mul(lane_set(0.5), lane_select(lane_lesser(a, lane_set(1.0)), small, moderate));
+    result = lane_select(lane_greater(a, lane_set(HYPERBOLIC_LARGE)), half_exp(a), result);
+    result = lane_or(result, lane_sign(x));
+
+    return solve_special_lanes(result, special, x, sinh);
+}
+
+#ifdef CALCULATOR_LANES_AVX
+
+static Lane lane_cosh(Lane x)
+{
+    const Lane special = hyperbolic_special(x);
+    const Lane a = lane_abs(lane_select(special, lane_set(0.0), x));
+
+    const Lane e = exp_with_tail(lane_min(a, lane_set(HYPERBOLIC_LARGE)), lane_set(0.0));
+    const Lane moderate = lane_add(lane_mul(lane_set(0.5), e), lane_div(lane_set(0.5), e));
+
+    Lane result = lane_select(lane_lesser(a, lane_set(1.0)), cosh_series(a), moderate);
+    result = lane_select(lane_greater(a, lane_set(HYPERBOLIC_LARGE)), half_exp(a), result);
+
+    return solve_special_lanes(result, special, x, cosh);
+}
+
+#endif // CALCULATOR_LANES_AVX
+
+static Lane lane_tanh(Lane x)
+{
+    const Lane special = lane_is_nan(x);
+    const Lane a = lane_abs(lane_select(special, lane_set(0.0), x));
+
+    // With t = exp(2a) - 1, tanh(a) = t / (t + 2)
+    const Lane t = lane_expm1(lane_min(lane_add(a, a), lane_set(2.0 * HYPERBOLIC_LARGE)));
+
+    Lane result = lane_div(t, lane_add(t, lane_set(2.0)));
+    result = lane_select(lane_greater(a, lane_set(HYPERBOLIC_LARGE)), lane_set(1.0), result);
+    result = lane_or(result, lane_sign(x));
+
+    return solve_special_lanes(result, special, x, tanh);
+}
+
+#ifdef CALCULATOR_LANES_AVX
+
+// Power (exp(exponent * log(base)) with log(base) and the product carried to about 70 bits)
+
+// log(x) as hi + lo for positive normal x
+GN_FORCE_INLINE static void log_double_double(Lane x, Lane& hi, Lane& lo)
+{
+    Lane m, k;
+    lane_split_exponent(x, m, k);
+
+    // log(m) = 2 atanh(s) = 2s + 2s^3 / 3 + 2s^5 / 5 + ... with s = (m - 1) / (m + 1), |s| < 0.172
+    const Lane f = lane_sub(m, lane_set(1.0));
+
+    Lane u, u_error;
+    lane_two_sum(m, lane_set(1.0), u, u_error);
+
+    const Lane s = lane_div(f, u);
+    Lane su, su_error;
+    lane_two_prod(s, u, su, su_error);
+    const Lane s_lo = lane_div(lane_sub(lane_sub(lane_sub(f, su), su_error), lane_mul(s, u_error)), u);
+
+    const Lane z = lane_mul(s, s);
+
+    Lane p = lane_set(2.0 / 23.0);
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 21.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 19.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 17.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 15.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 13.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 11.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 9.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 7.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 5.0));
+    p = lane_add(lane_mul(p, z), lane_set(2.0 / 3.0));
+
+    const Lane tail = lane_mul(lane_mul(s, z), p);
+
+    Lane log_m, log_m_lo;
+    lane_quick_two_sum(lane_add(s, s), lane_add(lane_add(s_lo, s_lo), tail), log_m, log_m_lo);
+
+    // k * ln(2) with ln(2) as a double-double
+    Lane k_ln2, k_ln2_error;
+    lane_two_prod(k, lane_set(LN2), k_ln2, k_ln2_error);
+    k_ln2_error = lane_add(k_ln2_error, lane_mul(k, lane_set(LN2_TAIL)));
+
+    Lane sum, sum_error;
+    lane_two_sum(k_ln2, log_m, sum, sum_error);
+    lane_quick_two_sum(sum, lane_add(sum_error, lane_add(k_ln2_error, log_m_lo)), hi, lo);
+}
+
+static Lane lane_pow(Lane base, Lane exponent)
+{
+    // Bases that aren't positive normal numbers need libm's special cases (negative bases with integer
+    // exponents, zero, infinity), as do non finite exponents
+    Lane special = lane_or(lane_is_nan(base), lane_or(lane_lesser(base, lane_set(DBL_MIN)), lane_equal(base, lane_set(INFINITY))));
+    special = lane_or(special, lane_not(lane_lesser(lane_abs(exponent), lane_set(INFINITY))));
+
+    Lane log_hi, log_lo;
+    log_double_double(lane_select(special, lane_set(1.0), base), log_hi, log_lo);
+
+    const Lane b = lane_select(special, lane_set(0.0), exponent);
+
+    Lane y, y_error;
+    lane_two_prod(b, log_hi, y, y_error);
+    lane_quick_two_sum(y, lane_add(y_error, lane_mul(b, log_lo)), y, y_error);
+
+    // Results that overflow or are subnormal
+    special = lane_or(special, lane_greater(y, lane_set(EXP_MAX)));
+    special = lane_or(special, lane_lesser(y, lane_set(EXP_MIN)));
+
+    const Lane result = exp_with_tail(lane_min(lane_max(y, lane_set(EXP_MIN)), lane_set(EXP_MAX)), y_error);
+    return solve_special_lanes(result, special, base, exponent, pow);
+}
+
+#endif // CALCULATOR_LANES_AVX
+
+// Array versions. The rows that don't fill up a lane are padded so they get the same results as the others.
+
+template <Lane (*function)(Lane)>
+static void apply_lanes(const f64 in[], f64 out[], u64 count)
+{
+    u64 i = 0;
+    for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+        lane_store(out + i, function(lane_load(in + i)));
+
+    if (i < count)
+    {
+        f64 padded[LANE_WIDTH];
+        for (u64 j = 0; j < LANE_WIDTH; j++)
+            padded[j] = (i + j < count) ? in[i + j] : 1.0;
+
+        lane_store(padded, function(lane_load(padded)));
+
+        for (u64 j = 0; i + j < count; j++)
+            out[i + j] = padded[j];
+    }
+}
+
+void vector_exp(const f64 in[], f64 out[], u64 count)   { apply_lanes<lane_exp>(in, out, count); }
+void vector_log(const f64 in[], f64 out[], u64 count)   { apply_lanes<lane_log>(in, out, count); }
+void vector_sin(const f64 in[], f64 out[], u64 count)   { apply_lanes<lane_sin>(in, out, count); }
+void vector_cos(const f64 in[], f64 out[], u64 count)   { apply_lanes<lane_cos>(in, out, count); }
+void vector_tan(const f64 in[], f64 out[], u64 count)   { apply_lanes<lane_tan>(in, out, count); }
+void vector_sinh(const f64 in[], f64 out[], u64 count)  { apply_lanes<lane_sinh>(in, out, count); }
+void vector_tanh(const f64 in[], f64 out[], u64 count)  { apply_lanes<lane_tanh>(in, out, count); }
+
+#ifdef CALCULATOR_LANES_AVX
+
+void vector_cosh(const f64 in[], f64 out[], u64 count)  { apply_lanes<lane_cosh>(in, out, count); }
+
+void vector_pow(const f64 base[], const f64 exponent[], f64 out[], u64 count)
+{
+    u64 i = 0;
+    for (; i + LANE_WIDTH <= count; i += LANE_WIDTH)
+        lane_store(out + i, lane_pow(lane_load(base + i), lane_load(exponent + i)));
+
+    if (i < count)
+    {
+        f64 padded_base[LANE_WIDTH], padded_exponent[LANE_WIDTH];
+        for (u64 j = 0; j < LANE_WIDTH; j++)
+        {
+            padded_base[j]     = (i + j < count) ? base[i + j] : 1.0;
+            padded_exponent[j] = (i + j < count) ? exponent[i + j] : 1.0;
+        }
+
+        lane_store(padded_base, lane_pow(lane_load(padded_base), lane_load(padded_exponent)));
+
+        for (u64 j = 0; i + j < count; j++)
+            out[i + j] = padded_base[j];
+    }
+}
+
+#else
+
+// With two SSE2 lanes the polynomials of cosh and pow are slower than libm (about 0.9x and 0.6x in
+// run_math_check), so every value goes to libm
+void vector_cosh(const f64 in[], f64 out[], u64 count)
+{
+    for (u64 i = 0; i < count; i++)
+        out[i] = cosh(in[i]);
+}
+
+void vector_pow(const f64 base[], const f64 exponent[], f64 out[], u64 count)
+{
+    for (u64 i = 0; i < count; i++)
+        out[i] = pow(base[i], exponent[i]);
+}
+
+#endif // CALCULATOR_LANES_AVX
+
+} // namespace Calculator
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "core/types.h"
+
+namespace Calculator
+{
+
+// Transcendental functions on arrays of values, a SIMD lane at a time (see lanes.h). They use the
+// range reductions and polynomials of fdlibm instead of calling libm for every value, so results can
+// differ from libm in the last bits. The bounds are the largest difference from libm seen by
+// run_math_check, in ulp. Values outside the range of the fast path (infinities, NaNs, results that
+// overflow or are subnormal, huge arguments of sin and friends) are passed to libm, so they match it.
+// out can be the same as the input.
+//
+// cosh and pow are only vectorized with AVX. The default build only has two SSE2 lanes, which makes
+// their polynomials slower than libm, so there they call libm for every value.
+
+void vector_exp(const f64 in[], f64 out[], u64 count);      // 1 ulp
+void vector_log(const f64 in[], f64 out[], u64 count);      // 1 ulp
+void vector_sin(const f64 in[], f64 out[], u64 count);      // 1 ulp, libm above 2^19
+void vector_cos(const f64 in[], f64 out[], u64 count);      // 1 ulp, libm above 2^19
+void vector_tan(const f64 in[], f64 out[], u64 count);      // 3 ulp, libm above 2^19
+void vector_sinh(const f64 in[], f64 out[], u64 count);     // 3 ulp
+void vector_cosh(const f64 in[], f64 out[], u64 count);     // 2 ulp with AVX
+void vector_tanh(const f64 in[], f64 out[], u64 count);     // 4 ulp
+
+// With AVX: 1 ulp while exponent * log(base) is small, the error grows with it up to 4 ulp for the
+// largest results. Bases that aren't positive are passed to libm.
+void vector_pow(const f64 base[], const f64 exponent[], f64 out[], u64 count);
+
+} // namespace Calculator
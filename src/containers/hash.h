@@ -110,10 +110,10 @@ static inline Hash HashCharBuffer(char const* buffer, const u64 length)
         ptr++;
     }
 
-    {   // Hash the remaining chars
+    {   // Hash the remaining chars (the low bytes are the first ones in memory)
         const u32 shift = (4 - rem) * 8;
-        const u32 mask = (shift < 32u) ? (0xFFFFFFFF << shift) : 0u;
-        const Hash val = (*ptr) & mask;
+        const u32 mask = (shift < 32u) ? (0xFFFFFFFF >> shift) : 0u;
+        const Hash val = rem ? ((*ptr) & mask) : 0u;
         
         hash = hash + hash * val * val;
         hash = ((hash & bytes[0]) << 16) |
@@ -0,0 +1,411 @@
+#include "float_format.h"
+
+#include <cstdio>
+#include <cstring>
+#include "core/logger.h"
+#include "core/types.h"
+
+#if defined(GN_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+// Grisu2 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers").
+// The digits always convert back to the same number and are the shortest for almost every input.
+
+struct DiyFp
+{
+    u64 f;      // Value is f * 2^e
+    s32 e;
+};
+
+struct CachedPower
+{
+    u64 f;
+    s32 e;
+};
+
+// 10^k for k = -348, -340, ..., 340, normalized so the top bit is set
+static constexpr CachedPower cached_powers[] = {
+    { 0xFA8FD5A0081C0288Ui64, -1220 },   // 10^-348
+    { 0xBAAEE17FA23EBF76Ui64, -1193 },   // 10^-340
+    { 0x8B16FB203055AC76Ui64, -1166 },   // 10^-332
+    { 0xCF42894A5DCE35EAUi64, -1140 },   // 10^-324
+    { 0x9A6BB0AA55653B2DUi64, -1113 },   // 10^-316
+    { 0xE61ACF033D1A45DFUi64, -1087 },   // 10^-308
+    { 0xAB70FE17C79AC6CAUi64, -1060 },   // 10^-300
+    { 0xFF77B1FCBEBCDC4FUi64, -1034 },   // 10^-292
+    { 0xBE5691EF416BD60CUi64, -1007 },   // 10^-284
+    { 0x8DD01FAD907FFC3CUi64,  -980 },   // 10^-276
+    { 0xD3515C2831559A83Ui64,  -954 },   // 10^-268
+    { 0x9D71AC8FADA6C9B5Ui64,  -927 },   // 10^-260
+    { 0xEA9C227723EE8BCBUi64,  -901 },   // 10^-252
+    { 0xAECC49914078536DUi64,  -874 },   // 10^-244
+    { 0x823C12795DB6CE57Ui64,  -847 },   // 10^-236
+    { 0xC21094364DFB5637Ui64,  -821 },   // 10^-228
+    { 0x9096EA6F3848984FUi64,  -794 },   // 10^-220
+    { 0xD77485CB25823AC7Ui64,  -768 },   // 10^-212
+    { 0xA086CFCD97BF97F4Ui64,  -741 },   // 10^-204
+    { 0xEF340A98172AACE5Ui64,  -715 },   // 10^-196
+    { 0xB23867FB2A35B28EUi64,  -688 },   // 10^-188
+    { 0x84C8D4DFD2C63F3BUi64,  -661 },   // 10^-180
+    { 0xC5DD44271AD3CDBAUi64,  -635 },   // 10^-172
+    { 0x936B9FCEBB25C996Ui64,  -608 },   // 10^-164
+    { 0xDBAC6C247D62A584Ui64,  -582 },   // 10^-156
+    { 0xA3AB66580D5FDAF6Ui64,  -555 },   // 10^-148
+    { 0xF3E2F893DEC3F126Ui64,  -529 },   // 10^-140
+    { 0xB5B5ADA8AAFF80B8Ui64,  -502 },   // 10^-132
+    { 0x87625F056C7C4A8BUi64,  -475 },   // 10^-124
+    { 0xC9BCFF6034C13053Ui64,  -449 },   // 10^-116
+    { 0x964E858C91BA2655Ui64,  -422 },   // 10^-108
+    { 0xDFF9772470297EBDUi64,  -396 },   // 10^-100
+    { 0xA6DFBD9FB8E5B88FUi64,  -369 },   // 10^-92
+    { 0xF8A95FCF88747D94Ui64,  -343 },   // 10^-84
+    { 0xB94470938FA89BCFUi64,  -316 },   // 10^-76
+    { 0x8A08F0F8BF0F156BUi64,  -289 },   // 10^-68
+    { 0xCDB02555653131B6Ui64,  -263 },   // 10^-60
+    { 0x993FE2C6D07B7FACUi64,  -236 },   // 10^-52
+    { 0xE45C10C42A2B3B06Ui64,  -210 },   // 10^-44
+    { 0xAA242499697392D3Ui64,  -183 },   // 10^-36
+    { 0xFD87B5F28300CA0EUi64,  -157 },   // 10^-28
+    { 0xBCE5086492111AEBUi64,  -130 },   // 10^-20
+    { 0x8CBCCC096F5088CCUi64,  -103 },   // 10^-12
+    { 0xD1B71758E219652CUi64,   -77 },   // 10^-4
+    { 0x9C40000000000000Ui64,   -50 },   // 10^4
+    { 0xE8D4A51000000000Ui64,   -24 },   // 10^12
+    { 0xAD78EBC5AC620000Ui64,     3 },   // 10^20
+    { 0x813F3978F8940984Ui64,    30 },   // 10^28
+    { 0xC097CE7BC90715B3Ui64,    56 },   // 10^36
+    { 0x8F7E32CE7BEA5C70Ui64,    83 },   // 10^44
+    { 0xD5D238A4ABE98068Ui64,   109 },   // 10^52
+    { 0x9F4F2726179A2245Ui64,   136 },   // 10^60
+    { 0xED63A231D4C4FB27Ui64,   162 },   // 10^68
+    { 0xB0DE65388CC8ADA8Ui64,   189 },   // 10^76
+    { 0x83C7088E1AAB65DBUi64,   216 },   // 10^84
+    { 0xC45D1DF942711D9AUi64,   242 },   // 10^92
+    { 0x924D692CA61BE758Ui64,   269 },   // 10^100
+    { 0xDA01EE641A708DEAUi64,   295 },   // 10^108
+    { 0xA26DA3999AEF774AUi64,   322 },   // 10^116
+    { 0xF209787BB47D6B85Ui64,   348 },   // 10^124
+    { 0xB454E4A179DD1877Ui64,   375 },   // 10^132
+    { 0x865B86925B9BC5C2Ui64,   402 },   // 10^140
+    { 0xC83553C5C8965D3DUi64,   428 },   // 10^148
+    { 0x952AB45CFA97A0B3Ui64,   455 },   // 10^156
+    { 0xDE469FBD99A05FE3Ui64,   481 },   // 10^164
+    { 0xA59BC234DB398C25Ui64,   508 },   // 10^172
+    { 0xF6C69A72A3989F5CUi64,   534 },   // 10^180
+    { 0xB7DCBF5354E9BECEUi64,   561 },   // 10^188
+    { 0x88FCF317F22241E2Ui64,   588 },   // 10^196
+    { 0xCC20CE9BD35C78A5Ui64,   614 },   // 10^204
+    { 0x98165AF37B2153DFUi64,   641 },   // 10^212
+    { 0xE2A0B5DC971F303AUi64,   667 },   // 10^220
+    { 0xA8D9D1535CE3B396Ui64,   694 },   // 10^228
+    { 0xFB9B7CD9A4A7443CUi64,   720 },   // 10^236
+    { 0xBB764C4CA7A44410Ui64,   747 },   // 10^244
+    { 0x8BAB8EEFB6409C1AUi64,   774 },   // 10^252
+    { 0xD01FEF10A657842CUi64,   800 },   // 10^260
+    { 0x9B10A4E5E9913129Ui64,   827 },   // 10^268
+    { 0xE7109BFBA19C0C9DUi64,   853 },   // 10^276
+    { 0xAC2820D9623BF429Ui64,   880 },   // 10^284
+    { 0x80444B5E7AA7CF85Ui64,   907 },   // 10^292
+    { 0xBF21E44003ACDD2DUi64,   933 },   // 10^300
+    { 0x8E679C2F5E44FF8FUi64,   960 },   // 10^308
+    { 0xD433179D9C8CB841Ui64,   986 },   // 10^316
+    { 0x9E19DB92B4E31BA9Ui64,  1013 },   // 10^324
+    { 0xEB96BF6EBADF77D9Ui64,  1039 },   // 10^332
+    { 0xAF87023B9BF0EE6BUi64,  1066 },   // 10^340
+};
+
+static constexpr u64 powers_of_ten[] = {
+    1Ui64, 10Ui64, 100Ui64, 1000Ui64, 10000Ui64, 100000Ui64, 1000000Ui64, 10000000Ui64, 100000000Ui64,
+    1000000000Ui64, 10000000000Ui64, 100000000000Ui64, 1000000000000Ui64, 10000000000000Ui64,
+    100000000000000Ui64, 1000000000000000Ui64, 10000000000000000Ui64, 100000000000000000Ui64,
+    1000000000000000000Ui64, 10000000000000000000Ui64,
+};
+
+constexpr u64 F64_HIDDEN_BIT    = 0x0010000000000000Ui64;
+constexpr u64 F64_MANTISSA_MASK = 0x000FFFFFFFFFFFFFUi64;
+constexpr s32 F64_EXPONENT_BIAS = 1075;    // Including the mantissa bits
+
+// Rounded high half of the product
+inline static DiyFp multiply(DiyFp a, DiyFp b)
+{
+#if defined(GN_COMPILER_MSVC)
+    u64 high;
+    const u64 low = _umul128(a.f, b.f, &high);
+#else
+    const unsigned __int128 product = (unsigned __int128) a.f * b.f;
+    u64 high = (u64) (product >> 64);
+    const u64 low = (u64) product;
+#endif
+
+    high += (low >> 63);
+    return DiyFp { high, a.e + b.e + 64 };
+}
+
+inline static DiyFp normalize(DiyFp x)
+{
+    while (!(x.f & (1Ui64 << 63)))
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+
+    return x;
+}
+
+// Upper and lower boundaries of the numbers that round to value, with the same exponent
+static void normalized_boundaries(DiyFp value, DiyFp& minus, DiyFp& plus)
+{
+    plus = normalize(DiyFp { (value.f << 1) + 1, value.e - 1 });
+
+    // The gap below powers of 2 is half as big
+    minus = (value.f == F64_HIDDEN_BIT) ? DiyFp { (value.f << 2) - 1, value.e - 2 }
+                                        : DiyFp { (value.f << 1) - 1, value.e - 1 };
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+}
+
+// Finds a power of ten that brings the exponent of a number with exponent e into [-60, -32]
+static DiyFp get_cached_power(s32 e, s32& k)
+{
+    const f64 dk = (-61 - e) * 0.30102999566398114 + 347;   // log10(2)
+    s32 ik = (s32) dk;
+    if (dk - ik > 0.0)
+        ik++;
+
+    const u32 index = (u32) ((ik >> 3) + 1);
+    k = -(-348 + (s32) (index << 3));
+
+    return DiyFp { cached_powers[index].f, cached_powers[index].e };
+}
+
+static void round_last_digit(u8 digits[], u32 length, u64 delta, u64 rest, u64 ten_kappa, u64 distance)
+{
+    // Moves the last digit closer to the exact value while it stays inside the boundaries
+    while (rest < distance && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < distance || distance - rest > rest + ten_kappa - distance))
+    {
+        digits[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static u32 count_digits(u32 n)
+{
+    u32 count = 1;
+    while (count < 10 && n >= powers_of_ten[count])
+        count++;
+
+    return count;
+}
+
+static u32 generate_digits(DiyFp w, DiyFp plus, u64 delta, u8 digits[], s32& k)
+{
+    const DiyFp one = DiyFp { 1Ui64 << -plus.e, plus.e };
+    const u64 distance = plus.f - w.f;
+
+    u32 integral = (u32) (plus.f >> -one.e);
+    u64 fraction = plus.f & (one.f - 1);
+
+    s32 kappa = (s32) count_digits(integral);
+    u32 length = 0;
+
+    while (kappa > 0)
+    {
+        const u32 divisor = (u32) powers_of_ten[kappa - 1];
+        const u32 digit = integral / divisor;
+        integral %= divisor;
+
+        if (digit || length)
+            digits[length++] = (u8) digit;
+
+        kappa--;
+
+        const u64 rest = ((u64) integral << -one.e) + fraction;
+        if (rest <= delta)
+        {
+            k += kappa;
+            round_last_digit(digits, length, delta, rest, powers_of_ten[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    while (true)
+    {
+        fraction *= 10;
+        delta *= 10;
+
+        const u8 digit = (u8) (fraction >> -one.e);
+        if (digit || length)
+            digits[length++] = digit;
+
+        fraction &= one.f - 1;
+        kappa--;
+
+        if (fraction < delta)
+        {
+            k += kappa;
+            const u64 scale = (-kappa < 20) ? powers_of_ten[-kappa] : 0;
+            round_last_digit(digits, length, delta, fraction, one.f, distance * scale);
+            return length;
+        }
+    }
+}
+
+// Rounds half up, carries can add a digit in front
+static u32 round_digits(u8 digits[], u32 length, u32 precision, s32& exponent)
+{
+    if (length <= precision)
+        return length;
+
+    const bool round_up = digits[precision] >= 5;
+    length = precision;
+
+    if (round_up)
+    {
+        s32 i = (s32) length - 1;
+        while (i >= 0 && digits[i] == 9)
+            digits[i--] = 0;
+
+        if (i >= 0)
+        {
+            digits[i]++;
+        }
+        else
+        {
+            digits[0] = 1;
+            exponent++;
+        }
+    }
+
+    while (length > 1 && digits[length - 1] == 0)
+        length--;
+
+    return length;
+}
+
+static u64 copy_chars(const char* str, char buffer[], u64 buffer_size)
+{
+    u64 length = 0;
+    for (; str[length] && length + 1 < buffer_size; length++)
+        buffer[length] = str[length];
+
+    if (buffer_size > 0)
+        buffer[length] = '\0';
+
+    return length;
+}
+
+u64 to_shortest_chars(f64 number, char buffer[], u64 buffer_size, u32 precision)
+{
+    u64 bits;
+    memcpy(&bits, &number, sizeof(f64));
+
+    const bool negative = (bits >> 63) != 0;
+    const u32 biased_exponent = (u32) ((bits >> 52) & 0x7FF);
+    const u64 mantissa = bits & F64_MANTISSA_MASK;
+
+    if (biased_exponent == 0x7FF)
+        return copy_chars(mantissa ? "nan" : (negative ? "-inf" : "inf"), buffer, buffer_size);
+
+    if (biased_exponent == 0 && mantissa == 0)
+    {
+        const u8 zero = 0;
+        return format_digits(&zero, 1, 0, negative, buffer, buffer_size);
+    }
+
+    const DiyFp value = (biased_exponent != 0) ? DiyFp { mantissa + F64_HIDDEN_BIT, (s32) biased_exponent - F64_EXPONENT_BIAS }
+                                               : DiyFp { mantissa, 1 - F64_EXPONENT_BIAS };
+
+    DiyFp minus, plus;
+    normalized_boundaries(value, minus, plus);
+
+    s32 k;
+    const DiyFp power = get_cached_power(plus.e, k);
+
+    const DiyFp w = multiply(normalize(value), power);
+    DiyFp upper = multiply(plus, power);
+    DiyFp lower = multiply(minus, power);
+
+    // Stay inside the boundaries even with the rounding error of the multiplications
+    lower.f++;
+    upper.f--;
+
+    u8 digits[20];
+    const u32 length = generate_digits(w, upper, upper.f - lower.f, digits, k);
+
+    // Position of the point relative to the first digit
+    s32 exponent = (s32) length + k - 1;
+
+    const u32 digit_count = (precision > 0) ? round_digits(digits, length, precision, exponent) : length;
+    return format_digits(digits, digit_count, exponent, negative, buffer, buffer_size);
+}
+
+u64 format_digits(const u8 digits[], u32 digit_count, s32 exponent, bool negative, char buffer[], u64 buffer_size)
+{
+    u64 length = 0;
+    const auto put = [&](char c) { if (length + 1 < buffer_size) buffer[length++] = c; };
+
+    if (negative)
+        put('-');
+
+    if (exponent < -7 || exponent >= 21)
+    {
+        // Scientific notation
+        put((char) ('0' + digits[0]));
+        if (digit_count > 1)
+        {
+            put('.');
+            for (u32 i = 1; i < digit_count; i++)
+                put((char) ('0' + digits[i]));
+        }
+
+        put('e');
+        put((exponent < 0) ? '-' : '+');
+
+        char exponent_digits[16];
+        u32 exponent_length = 0;
+        u32 magnitude = (u32) ((exponent < 0) ? -exponent : exponent);
+        do
+        {
+            exponent_digits[exponent_length++] = (char) ('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+
+        while (exponent_length > 0)
+            put(exponent_digits[--exponent_length]);
+    }
+    else if (exponent < 0)
+    {
+        put('0');
+        put('.');
+        for (s32 i = 1; i < -exponent; i++)
+            put('0');
+
+        for (u32 i = 0; i < digit_count; i++)
+            put((char) ('0' + digits[i]));
+    }
+    else
+    {
+        for (s32 i = 0; i <= exponent || i < (s32) digit_count; i++)
+        {
+            if (i == exponent + 1)
+                put('.');
+
+            put((i < (s32) digit_count) ? (char) ('0' + digits[i]) : '0');
+        }
+    }
+
+    if (buffer_size > 0)
+        buffer[length] = '\0';
+
+    return length;
+}
+
+template <>
+void print_to_file(FILE* file, const ShortestF64& number)
+{
+    char buffer[SHORTEST_F64_MAX_CHARS];
+    to_shortest_chars(number.value, buffer, sizeof(buffer), number.precision);
+    print_to_file(file, buffer);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "core/types.h"
+
+// Enough for any f64 written by to_shortest_chars, including the null terminator
+constexpr u64 SHORTEST_F64_MAX_CHARS = 32;
+
+// Writes the fewest significant digits that convert back to the same number (Grisu2). If precision
+// isn't 0 those digits are rounded to at most precision significant digits. Numbers smaller than 1e-7
+// or from 1e21 up are written in scientific notation. Returns the number of characters written.
+u64 to_shortest_chars(f64 number, char buffer[], u64 buffer_size, u32 precision = 0);
+
+// Writes digits (values 0 to 9, most significant first) as a number with the point after
+// the first digit moved by exponent. Small and large exponents use scientific notation.
+u64 format_digits(const u8 digits[], u32 digit_count, s32 exponent, bool negative, char buffer[], u64 buffer_size);
+
+// Prints through to_shortest_chars, e.g. print("%\n", ShortestF64 { result })
+struct ShortestF64
+{
+    f64 value;
+    u32 precision;  // Significant digits, 0 for as many as needed
+};
@@ -0,0 +1,221 @@
+#include "thread_pool.h"
+
+#include <atomic>
+#include <new>
+#include "containers/darray.h"
+#include "core/logger.h"
+#include "core/types.h"
+#include "platform/platform.h"
+
+struct ThreadWorker
+{
+    ThreadPool* pool;
+    void* thread;
+    u32 index;
+};
+
+// Workers yield for this many empty rounds before they start sleeping
+constexpr u32 THREAD_POOL_SPIN_COUNT = 256;
+
+inline static void lock(TaskQueue& queue)
+{
+    while (queue.lock.test_and_set(std::memory_order_acquire))
+        platform_yield_thread();
+}
+
+inline static void unlock(TaskQueue& queue)
+{
+    queue.lock.clear(std::memory_order_release);
+}
+
+static bool pop_front(TaskQueue& queue, ThreadTask& task)
+{
+    lock(queue);
+
+    const bool found = queue.head < queue.tasks.size;
+    if (found)
+    {
+        task = queue.tasks[queue.head++];
+
+        // Start from the beginning once the queue runs dry so it doesn't keep growing
+        if (queue.head == queue.tasks.size)
+        {
+            clear(queue.tasks);
+            queue.head = 0;
+        }
+    }
+
+    unlock(queue);
+    return found;
+}
+
+static bool steal_back(TaskQueue& queue, ThreadTask& task)
+{
+    lock(queue);
+
+    const bool found = queue.head < queue.tasks.size;
+    if (found)
+    {
+        task = pop(queue.tasks);
+
+        if (queue.head == queue.tasks.size)
+        {
+            clear(queue.tasks);
+            queue.head = 0;
+        }
+    }
+
+    unlock(queue);
+    return found;
+}
+
+// Checks the worker's own queue first and then steals from the others, starting with its neighbour
+static bool find_task(ThreadPool& pool, u32 worker_index, ThreadTask& task)
+{
+    if (worker_index < pool.worker_count && pop_front(pool.queues[worker_index], task))
+        return true;
+
+    for (u32 i = 1; i <= pool.worker_count; i++)
+    {
+        const u32 victim = (worker_index + i) % pool.worker_count;
+        if (victim != worker_index && steal_back(pool.queues[victim], task))
+            return true;
+    }
+
+    return false;
+}
+
+static void run_task(ThreadPool& pool, const ThreadTask& task, u32 worker_index)
+{
+    task.function(task.data, worker_index);
+    pool.pending_count.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+static void worker_main(void* data)
+{
+    ThreadWorker& worker = *(ThreadWorker*) data;
+    ThreadPool& pool = *worker.pool;
+
+    u32 idle_rounds = 0;
+    while (true)
+    {
+        ThreadTask task;
+        if (find_task(pool, worker.index, task))
+        {
+            run_task(pool, task, worker.index);
+            idle_rounds = 0;
+            continue;
+        }
+
+        if (!pool.running.load(std::memory_order_acquire))
+            break;
+
+        if (++idle_rounds < THREAD_POOL_SPIN_COUNT)
+            platform_yield_thread();
+        else
+            platform_sleep(1);
+    }
+}
+
+static void free_thread_pool(ThreadPool& pool)
+{
+    for (u32 i = 0; i < pool.worker_count; i++)
+        free(pool.queues[i].tasks);
+
+    platform_free(pool.queues);
+    platform_free(pool.workers);
+
+    pool.queues = nullptr;
+    pool.workers = nullptr;
+    pool.worker_count = 0;
+}
+
+bool start_thread_pool(ThreadPool& pool, u32 worker_count)
+{
+    if (worker_count == 0)
+        worker_count = platform_get_processor_count();
+
+    if (worker_count == 0)
+        worker_count = 1;
+
+    pool.worker_count = worker_count;
+    pool.next_queue = 0;
+    pool.pending_count.store(0);
+    pool.running.store(true);
+
+    pool.workers = (ThreadWorker*) platform_allocate(worker_count * sizeof(ThreadWorker));
+    pool.queues  = (TaskQueue*) platform_allocate(worker_count * sizeof(TaskQueue));
+
+    for (u32 i = 0; i < worker_count; i++)
+    {
+        new (pool.queues + i) TaskQueue();
+        pool.queues[i].tasks = make<DynamicArray<ThreadTask>>(64Ui64);
+        pool.queues[i].head = 0;
+    }
+
+    for (u32 i = 0; i < worker_count; i++)
+    {
+        ThreadWorker& worker = pool.workers[i];
+        worker.pool = &pool;
+        worker.index = i;
+        worker.thread = platform_create_thread(worker_main, &worker);
+
+        if (!worker.thread)
+        {
+            print_error("Could not start worker thread % of %!\n", i + 1, worker_count);
+
+            // Nothing has been submitted yet so the threads that did start can be stopped right away
+            pool.running.store(false, std::memory_order_release);
+            for (u32 j = 0; j < i; j++)
+                platform_join_thread(pool.workers[j].thread);
+
+            free_thread_pool(pool);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void stop_thread_pool(ThreadPool& pool)
+{
+    if (!pool.workers)
+        return;
+
+    while (pool.pending_count.load(std::memory_order_acquire) > 0)
+    {
+        if (!run_pending_task(pool))
+            platform_yield_thread();
+    }
+
+    pool.running.store(false, std::memory_order_release);
+
+    for (u32 i = 0; i < pool.worker_count; i++)
+        platform_join_thread(pool.workers[i].thread);
+
+    free_thread_pool(pool);
+}
+
+void submit_task(ThreadPool& pool, ThreadTask task)
+{
+    gn_assert_with_message(pool.worker_count > 0, "Submitting a task to a thread pool that hasn't been started!");
+
+    pool.pending_count.fetch_add(1, std::memory_order_acq_rel);
+
+    TaskQueue& queue = pool.queues[pool.next_queue];
+    pool.next_queue = (pool.next_queue + 1) % pool.worker_count;
+
+    lock(queue);
+    append(queue.tasks, task);
+    unlock(queue);
+}
+
+bool run_pending_task(ThreadPool& pool)
+{
+    ThreadTask task;
+    if (!find_task(pool, pool.worker_count, task))
+        return false;
+
+    run_task(pool, task, pool.worker_count);
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include "containers/darray.h"
+#include "core/types.h"
+
+// Tasks get the index of the worker running them so they can use per-worker scratch memory.
+// Workers are indexed from 0 to worker_count - 1, the thread that owns the pool is worker_count.
+struct ThreadTask
+{
+    void (*function)(void* data, u32 worker_index);
+    void* data;
+};
+
+// The owning worker takes the oldest task from the front, other workers steal the newest from the back
+struct TaskQueue
+{
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    DynamicArray<ThreadTask> tasks;
+    u64 head;
+};
+
+struct ThreadWorker;
+
+struct ThreadPool
+{
+    ThreadWorker* workers;
+    TaskQueue*    queues;
+    u32 worker_count;
+    u32 next_queue;     // Tasks are handed out round robin
+
+    std::atomic<u64>  pending_count;
+    std::atomic<bool> running;
+};
+
+// Starts worker_count threads (all the processors if 0). Returns false if no thread could be started.
+bool start_thread_pool(ThreadPool& pool, u32 worker_count = 0);
+
+// Waits for the queued tasks to finish and joins the threads
+void stop_thread_pool(ThreadPool& pool);
+
+// Should only be called from the thread that started the pool
+void submit_task(ThreadPool& pool, ThreadTask task);
+
+// Runs one queued task on the calling thread (the owner of the pool) if there is any.
+// Used to help out while waiting on the workers.
+bool run_pending_task(ThreadPool& pool);
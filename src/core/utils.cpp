@@ -132,12 +132,21 @@ void to_string(String& str, f32 number, u32 after_decimal)
 {
     gn_assert_with_message(str.data, "Destination string for float to string conversion points to null!");
 
-    u64 old_size = str.size;
+    // The sign is written separately so numbers between -1 and 0 keep it and the fraction stays positive
+    const bool negative = number < 0;
+    if (negative)
+        number = -number;
 
     s32 integer = (s32) number;
     f32 fractional = number - (f32) integer;
 
-    to_string(str, integer);
+    String integer_string = { str.data + negative, 0 };
+    to_string(integer_string, integer);
+
+    if (negative)
+        str.data[0] = '-';
+
+    str.size = integer_string.size + negative;
 
     if (after_decimal > 0)
     {
@@ -161,12 +170,21 @@ void to_string(String& str, f64 number, u32 after_decimal)
 {
     gn_assert_with_message(str.data, "Destination string for float to string conversion points to null!");
 
-    u64 old_size = str.size;
+    // The sign is written separately so numbers between -1 and 0 keep it and the fraction stays positive
+    const bool negative = number < 0;
+    if (negative)
+        number = -number;
 
     s64 integer = (s64) number;
     f64 fractional = number - (f64) integer;
 
-    to_string(str, integer);
+    String integer_string = { str.data + negative, 0 };
+    to_string(integer_string, integer);
+
+    if (negative)
+        str.data[0] = '-';
+
+    str.size = integer_string.size + negative;
 
     if (after_decimal > 0)
     {
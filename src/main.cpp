@@ -1,48 +1,597 @@
 #include "platform/platform.h"
-#include "calculator/misc.h"
+#include "calculator/autodiff.h"
+#include "calculator/batch.h"
+#include "calculator/benchmark.h"
+#include "calculator/error.h"
+#include "calculator/interval.h"
+#include "calculator/keywords.h"
+#include "calculator/numeric_solver.h"
+#include "calculator/profile.h"
+#include "calculator/server.h"
 #include "calculator/solver.h"
 #include "calculator/token.h"
 #include "containers/string.h"
+#include "core/float_format.h"
 #include "core/logger.h"
 
 constexpr char help_string[] =
 "Calculate expressions.\n"
-"   usage: % <expression>\n"
+"   usage: % <expression> [--precision <digits>]\n"
+"          % --batch [file] [--stats] [--threads <count>] [--cache <MB>] [--precision <digits>] [--diagnostics]\n"
+"                      [--profile] [--profile-json]\n"
+"          % --csv <expression> [file] [--stats] [--precision <digits>] [--fast-math] [--reduce <sum|mean|cumsum>] [--bounds]\n"
+"          % --numeric <f64|dd|decimal> <expression> [digits]\n"
+"          % --gradient <expression> [<variable>=<value> ...]\n"
+"          % --bounds <expression> [<variable>=<low>:<high> ...]\n"
+"          % --bench <expression> [rows]\n"
+"          % --bench-numeric <expression> [rows]\n"
+"          % --bench-gradient <expression> [rows]\n"
+"          % --check-jit [count]\n"
+"          % --check-parser [count]\n"
+"          % --check-bounds <expression> [boxes]\n"
+"          % --check-allocations [count]\n"
+"          % --check-errors [count]\n"
+"          % --check-math [count]\n"
+"          % --bench-format [count]\n"
+"          % --bench-branches [rows]\n"
+"          % --serve <socket> [--cache <MB>] [--precision <digits>]\n"
+"          % --load <socket> <expression> [requests] [depth]\n"
+"\n"
+"   Any mode also takes --define \"<name>(<parameters>) = <expression>\" (as many as needed) to add a function,\n"
+"   like --define \"hyp(a, b) = sqrt(a*a + b*b)\" or --define \"tau = 2*pi\". Calls are replaced with the\n"
+"   function body before solving so they cost the same as writing the body out\n"
+"\n"
+"   sum and mean take any number of arguments, dot(a1, ..., an, b1, ..., bn) adds up the products of\n"
+"   the first half of its arguments with the second half\n"
+"\n"
+"   --batch     Solve newline separated expressions from file (or stdin) and print one result per line\n"
+"   --csv       Evaluate the expression for every row of a CSV file (or stdin). The column names from\n"
+"               the header can be used as variables in the expression. sum, mean and dot in the expression are\n"
+"               over their arguments in one row, use --reduce to combine the rows\n"
+"   --reduce    Print the sum or mean of the results of all rows once instead of one result per row, or with\n"
+"               cumsum the running sum of the rows. Rows with missing values are left out\n"
+"   --stats     Print the number of expressions solved per second to stderr\n"
+"   --diagnostics\n"
+"               Print why a line couldn't be solved instead of just \"error\" (like \"error: missing operand for sqrt at 4\")\n"
+"   --profile   Time every operator call with the cycle counter and print the calls and cycles of each operator to\n"
+"               stderr once the batch is done, the most expensive first (--profile-json prints them as JSON)\n"
+"   --fast-math Solve exp, log, pow, trigonometric and hyperbolic functions a SIMD lane at a time instead of calling\n"
+"               libm for every row. Results can be off by a few ulp (see --check-math)\n"
+"   --threads   Solve batch input on a pool of threads (0 for one per processor), results keep the input order\n"
+"   --cache     Keep the tokenized expressions in a cache of up to the given size so repeated expressions\n"
+"               aren't tokenized again (the server caches up to 64 MB by default, 0 turns the cache off)\n"
+"   --precision Round results to the given number of significant digits. By default results are printed with\n"
+"               the fewest digits that read back as the same number\n"
+"   --numeric   Solve the expression with f64, double-double (about 32 digits) or decimal numbers with the\n"
+"               given number of significant digits (default 50, at most 300)\n"
+"   --gradient  Solve the expression with the given variable values and print its derivative with respect\n"
+"               to each of them (reverse mode automatic differentiation)\n"
+"   --bounds    Print a range that is guaranteed to contain the result for any values of the variables in their\n"
+"               ranges (interval arithmetic with outward rounding). After --csv it prints the range of every row as\n"
+"               \"low,high\", columns named <variable>_low and <variable>_high are the range of the variable and the\n"
+"               other columns are single values\n"
+"   --bench     Compare the evaluators on the expression with x, y and z set to random values (default 1000000 rows)\n"
+"   --bench-numeric\n"
+"               Compare the numeric types on the expression with x, y and z set to random values (default 10000 rows)\n"
+"   --bench-gradient\n"
+"               Compare finite differences with forward and reverse mode differentiation on the expression with\n"
+"               x, y and z set to random values (default 100000 rows)\n"
+"   --check-jit Check the JIT and the bytecode against the postfix solver on random expressions (default 10000 expressions)\n"
+"   --check-parser\n"
+"               Check the number parser against strtod on random numbers and time it (default 1000000 numbers)\n"
+"   --check-bounds\n"
+"               Check the interval solver on random boxes of x, y and z by sampling points in them (default 100000 boxes)\n"
+"   --check-allocations\n"
+"               Check that tokenizing random expressions into fixed buffers doesn't allocate memory (default 100000 expressions)\n"
+"   --check-errors\n"
+"               Check the errors reported for broken random expressions and time the valid ones with and without\n"
+"               errors (default 100000 expressions)\n"
+"   --check-math\n"
+"               Check the vector math functions (used by --fast-math) against libm and time them (default 1000000 values\n"
+"               for each range)\n"
+"   --bench-format\n"
+"               Check that formatted numbers read back the same and time formatting against printf (default 1000000 numbers)\n"
+"   --bench-branches\n"
+"               Compare evaluating every operand of if, and and or with only evaluating the ones that are needed on a\n"
+"               few formulas with x, y and z set to random values (default 1000000 rows)\n"
+"   --serve     Solve expressions sent to a Unix domain socket. Requests and responses are a little endian\n"
+"               u32 byte count followed by the text, responses are sent in the order of the requests\n"
+"   --load      Send the expression to a server (default 100000 requests with up to 16 in flight) and print\n"
+"               the latency percentiles\n"
 ;
 
+static void print_stats(const Calculator::BatchStats& stats)
+{
+    const f64 throughput = (stats.seconds > 0) ? stats.expression_count / stats.seconds : 0.0;
+    print_error("Solved % expressions (% errors, % bytes) in % s (% expressions/s)\n",
+                stats.expression_count, stats.error_count, stats.byte_count, stats.seconds, throughput);
+
+    if (stats.cache_hit_count + stats.cache_miss_count > 0)
+        print_error("Expression cache: % hits, % misses\n", stats.cache_hit_count, stats.cache_miss_count);
+}
+
+// Parses the argument after --cache (in megabytes), returns false if there is none
+static bool parse_cache_size(int argc, char** argv, int& i, u64& cache_memory)
+{
+    if (i + 1 >= argc)
+    {
+        print_error("Expected a size in megabytes after --cache!\n");
+        return false;
+    }
+
+    cache_memory = strtoull(argv[++i], nullptr, 10) * 1024 * 1024;
+    return true;
+}
+
+static void print_expression_error(const Calculator::ExpressionError& error)
+{
+    if (error.op != Calculator::OperatorCode::COUNT)
+        print_error("Error: % for % (at %)\n", Calculator::error_message(error.code), Calculator::operator_name(error.op), error.offset);
+    else
+        print_error("Error: % (at %)\n", Calculator::error_message(error.code), error.offset);
+}
+
+// Parses the argument after --precision, returns false if there is none or it is out of range
+static bool parse_precision(int argc, char** argv, int& i, u32& precision)
+{
+    if (i + 1 >= argc)
+    {
+        print_error("Expected a number of digits after --precision!\n");
+        return false;
+    }
+
+    const u64 digits = strtoull(argv[++i], nullptr, 10);
+    if (digits < 1 || digits > 17)
+    {
+        print_error("Precision should be between 1 and 17 digits!\n");
+        return false;
+    }
+
+    precision = (u32) digits;
+    return true;
+}
+
+// Expression for csv mode is the first non flag argument
+static int run_batch(int argc, char** argv, bool is_csv)
+{
+    const char* expression = nullptr;
+    const char* filepath = nullptr;
+    bool show_stats = false;
+    bool profile_json = false;
+    Calculator::OperatorProfile profile = {};
+    s64 thread_count = -1;     // Negative means single threaded
+    bool bounds = false;
+    Calculator::BatchOptions options = {};
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (ref("--stats", 7) == ref(argv[i]))
+            show_stats = true;
+        else if (!is_csv && ref("--threads", 9) == ref(argv[i]))
+        {
+            if (i + 1 >= argc)
+            {
+                print_error("Expected a thread count after --threads!\n");
+                return 1;
+            }
+
+            thread_count = strtoll(argv[++i], nullptr, 10);
+        }
+        else if (!is_csv && ref("--cache", 7) == ref(argv[i]))
+        {
+            if (!parse_cache_size(argc, argv, i, options.cache_memory))
+                return 1;
+        }
+        else if (ref("--precision", 11) == ref(argv[i]))
+        {
+            if (!parse_precision(argc, argv, i, options.precision))
+                return 1;
+        }
+        else if (!is_csv && ref("--diagnostics", 13) == ref(argv[i]))
+            options.diagnostics = true;
+        else if (!is_csv && ref("--profile", 9) == ref(argv[i]))
+            options.profile = &profile;
+        else if (!is_csv && ref("--profile-json", 14) == ref(argv[i]))
+        {
+            options.profile = &profile;
+            profile_json = true;
+        }
+        else if (is_csv && ref("--fast-math", 11) == ref(argv[i]))
+            options.fast_math = true;
+        else if (is_csv && ref("--bounds", 8) == ref(argv[i]))
+            bounds = true;
+        else if (is_csv && ref("--reduce", 8) == ref(argv[i]))
+        {
+            if (i + 1 >= argc)
+            {
+                print_error("Expected sum, mean or cumsum after --reduce!\n");
+                return 1;
+            }
+
+            char* reduction = argv[++i];
+            if (ref("sum", 3) == ref(reduction))
+                options.reduction = Calculator::RowReduction::SUM;
+            else if (ref("mean", 4) == ref(reduction))
+                options.reduction = Calculator::RowReduction::MEAN;
+            else if (ref("cumsum", 6) == ref(reduction))
+                options.reduction = Calculator::RowReduction::PREFIX_SUM;
+            else
+            {
+                print_error("Expected sum, mean or cumsum after --reduce!\n");
+                return 1;
+            }
+        }
+        else if (is_csv && !expression)
+            expression = argv[i];
+        else
+            filepath = argv[i];
+    }
+
+    if (is_csv && !expression)
+    {
+        print_error("No expression given for csv mode!\n");
+        return 1;
+    }
+
+    if (bounds && options.reduction != Calculator::RowReduction::NONE)
+    {
+        print_error("Bounds of the rows can't be reduced!\n");
+        return 1;
+    }
+
+    FILE* input = stdin;
+    if (filepath)
+    {
+        input = fopen(filepath, "rb");
+        if (!input)
+        {
+            print_error("Could not open file \"%\"!\n", filepath);
+            return 1;
+        }
+    }
+
+    platform_init_clock();
+    Calculator::BatchStats stats;
+    if (is_csv && bounds)
+        stats = Calculator::solve_csv_bounds(ref((char*) expression), input, stdout);
+    else if (is_csv)
+        stats = Calculator::solve_csv(ref((char*) expression), input, stdout, options);
+    else if (thread_count >= 0)
+    {
+        options.thread_count = (u32) thread_count;
+        stats = Calculator::solve_batch_parallel(input, stdout, options);
+    }
+    else
+        stats = Calculator::solve_batch(input, stdout, options);
+
+    if (filepath)
+        fclose(input);
+
+    if (show_stats)
+        print_stats(stats);
+
+    if (options.profile && profile_json)
+        Calculator::print_profile_json(stderr, profile);
+    else if (options.profile)
+        Calculator::print_profile(stderr, profile);
+
+    return stats.error_count > 0;
+}
+
+// Defines the functions given with --define and removes them from the arguments so the modes don't see them
+static bool parse_definitions(int& argc, char** argv)
+{
+    int kept = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (ref("--define", 8) != ref(argv[i]))
+        {
+            argv[kept++] = argv[i];
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            print_error("Expected a definition after --define!\n");
+            return false;
+        }
+
+        if (!Calculator::define_function(ref(argv[++i])))
+            return false;
+    }
+
+    argc = kept;
+    return true;
+}
+
 int main(int argc, char** argv)
 {
+    if (!parse_definitions(argc, argv))
+        return 1;
+
     // Exit if no string is given
     if (argc < 2 || ref("help", 4) == ref(argv[1]))
     {
-        print(help_string, argv[0]);
+        print(help_string, argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+              argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
         return 0;
     }
-    
-    const String expression = ref(argv[1]);
 
-    {   // Check for balanced brackets
-        s32 diff = Calculator::balanced_brackets(expression);
+    if (ref("--batch", 7) == ref(argv[1]))
+        return run_batch(argc, argv, false);
+
+    if (ref("--csv", 5) == ref(argv[1]))
+        return run_batch(argc, argv, true);
 
-        if (diff > 0)
+    if (ref("--bench", 7) == ref(argv[1]))
+    {
+        if (argc < 3)
         {
-            print_error("Unbalanced brackets! There are more open brackets than closed brackets.\n");
+            print_error("No expression given for benchmark!\n");
             return 1;
         }
-        else if (diff < 0)
+
+        const u64 row_count = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 1000000;
+
+        platform_init_clock();
+        return !Calculator::run_benchmark(ref(argv[2]), row_count);
+    }
+
+    if (ref("--bench-numeric", 15) == ref(argv[1]))
+    {
+        if (argc < 3)
         {
-            print_error("Unbalanced brackets! There are more closed brackets than open brackets.\n");
+            print_error("No expression given for benchmark!\n");
             return 1;
         }
+
+        const u64 row_count = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 10000;
+
+        platform_init_clock();
+        return !Calculator::run_numeric_benchmark(ref(argv[2]), row_count);
     }
 
-    DynamicArray<Calculator::ExpressionElement> elements = {};
-    bool success = Calculator::infix_expression_to_postfix(expression, elements);
-    if (!success)
+    if (ref("--bench-gradient", 16) == ref(argv[1]))
+    {
+        if (argc < 3)
+        {
+            print_error("No expression given for benchmark!\n");
+            return 1;
+        }
+
+        const u64 row_count = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 100000;
+
+        platform_init_clock();
+        return !Calculator::run_gradient_benchmark(ref(argv[2]), row_count);
+    }
+
+    if (ref("--gradient", 10) == ref(argv[1]))
+    {
+        if (argc < 3)
+        {
+            print_error("No expression given for gradient!\n");
+            return 1;
+        }
+
+        DynamicArray<String> names = make<DynamicArray<String>>((u64) argc);
+        DynamicArray<f64> values = make<DynamicArray<f64>>((u64) argc);
+
+        for (int i = 3; i < argc; i++)
+        {
+            char* equals = strchr(argv[i], '=');
+            if (!equals)
+            {
+                print_error("Expected <variable>=<value> instead of \"%\"!\n", argv[i]);
+                free(values);
+                free(names);
+                return 1;
+            }
+
+            append(names, ref(argv[i], (u64) (equals - argv[i])));
+            append(values, strtod(equals + 1, nullptr));
+        }
+
+        const bool success = Calculator::solve_gradient(ref(argv[2]), names.data, values.data, (u32) names.size, stdout);
+
+        free(values);
+        free(names);
+        return !success;
+    }
+
+    if (ref("--bounds", 8) == ref(argv[1]))
+    {
+        if (argc < 3)
+        {
+            print_error("No expression given for bounds!\n");
+            return 1;
+        }
+
+        DynamicArray<String> names = make<DynamicArray<String>>((u64) argc);
+        DynamicArray<Calculator::Interval> ranges = make<DynamicArray<Calculator::Interval>>((u64) argc);
+
+        for (int i = 3; i < argc; i++)
+        {
+            char* equals = strchr(argv[i], '=');
+            char* colon = equals ? strchr(equals, ':') : nullptr;
+            if (!colon)
+            {
+                print_error("Expected <variable>=<low>:<high> instead of \"%\"!\n", argv[i]);
+                free(ranges);
+                free(names);
+                return 1;
+            }
+
+            append(names, ref(argv[i], (u64) (equals - argv[i])));
+            append(ranges, Calculator::Interval { strtod(equals + 1, nullptr), strtod(colon + 1, nullptr) });
+        }
+
+        const bool success = Calculator::solve_bounds(ref(argv[2]), names.data, ranges.data, (u32) names.size, stdout);
+
+        free(ranges);
+        free(names);
+        return !success;
+    }
+
+    if (ref("--check-bounds", 14) == ref(argv[1]))
+    {
+        if (argc < 3)
+        {
+            print_error("No expression given for bounds check!\n");
+            return 1;
+        }
+
+        const u64 box_count = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 100000;
+
+        platform_init_clock();
+        return !Calculator::run_interval_check(ref(argv[2]), box_count);
+    }
+
+    if (ref("--numeric", 9) == ref(argv[1]))
+    {
+        Calculator::NumericType type;
+        if (argc < 4 || !Calculator::parse_numeric_type(ref(argv[2]), type))
+        {
+            print_error("Expected a numeric type (f64, dd or decimal) and an expression!\n");
+            return 1;
+        }
+
+        const u32 digits = (argc > 4) ? (u32) strtoul(argv[4], nullptr, 10) : 50;
+
+        Calculator::ExpressionError error;
+        if (!Calculator::solve_numeric(ref(argv[3]), type, digits, stdout, error))
+        {
+            print_expression_error(error);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    if (ref("--check-jit", 11) == ref(argv[1]))
+    {
+        const u64 expression_count = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 10000;
+        return !Calculator::run_jit_check(expression_count);
+    }
+
+    if (ref("--check-parser", 14) == ref(argv[1]))
+    {
+        const u64 number_count = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+        platform_init_clock();
+        return !Calculator::run_parser_check(number_count);
+    }
+
+    if (ref("--check-allocations", 19) == ref(argv[1]))
+    {
+        const u64 expression_count = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 100000;
+
+        platform_init_clock();
+        return !Calculator::run_allocation_check(expression_count);
+    }
+
+    if (ref("--check-errors", 14) == ref(argv[1]))
+    {
+        const u64 expression_count = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 100000;
+
+        platform_init_clock();
+        return !Calculator::run_error_check(expression_count);
+    }
+
+    if (ref("--check-math", 12) == ref(argv[1]))
+    {
+        const u64 count = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+        platform_init_clock();
+        return !Calculator::run_math_check(count);
+    }
+
+    if (ref("--bench-format", 14) == ref(argv[1]))
+    {
+        const u64 number_count = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+        platform_init_clock();
+        return !Calculator::run_format_benchmark(number_count);
+    }
+
+    if (ref("--bench-branches", 16) == ref(argv[1]))
+    {
+        const u64 row_count = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+        platform_init_clock();
+        return !Calculator::run_branch_benchmark(row_count);
+    }
+
+    if (ref("--serve", 7) == ref(argv[1]))
+    {
+        if (argc < 3)
+        {
+            print_error("No socket path given for server!\n");
+            return 1;
+        }
+
+        Calculator::BatchOptions options = {};
+        options.cache_memory = 64 * 1024 * 1024;
+
+        for (int i = 3; i < argc; i++)
+        {
+            if (ref("--cache", 7) == ref(argv[i]) && !parse_cache_size(argc, argv, i, options.cache_memory))
+                return 1;
+
+            if (ref("--precision", 11) == ref(argv[i]) && !parse_precision(argc, argv, i, options.precision))
+                return 1;
+        }
+
+        // Only returns if the server failed
+        Calculator::run_server(argv[2], options);
         return 1;
+    }
+
+    if (ref("--load", 6) == ref(argv[1]))
+    {
+        if (argc < 4)
+        {
+            print_error("Expected a socket path and an expression!\n");
+            return 1;
+        }
+
+        const u64 request_count = (argc > 4) ? strtoull(argv[4], nullptr, 10) : 100000;
+        const u32 depth = (argc > 5) ? (u32) strtoul(argv[5], nullptr, 10) : 16;
+
+        platform_init_clock();
+        return !Calculator::run_load_client(argv[2], ref(argv[3]), request_count, depth);
+    }
+    
+    const String expression = ref(argv[1]);
+
+    u32 precision = 0;
+    for (int i = 2; i < argc; i++)
+    {
+        if (ref("--precision", 11) == ref(argv[i]) && !parse_precision(argc, argv, i, precision))
+            return 1;
+    }
+
+    DynamicArray<Calculator::ExpressionElement> elements = {};
+    DynamicArray<Calculator::OperatorOrBracket> op_stack = make<DynamicArray<Calculator::OperatorOrBracket>>(32Ui64);
+    DynamicArray<f64> number_stack = make<DynamicArray<f64>>(32Ui64);
+
+    Calculator::ExpressionError error;
+    bool success = Calculator::infix_expression_to_postfix(expression, elements, op_stack, error);
 
-    f64 result = Calculator::solve_postfix_data(elements);
-    print("Result: %\n", result);
+    if (success)
+    {
+        const f64 result = Calculator::solve_postfix_data(elements, number_stack, nullptr, error);
+        success = (error.code == Calculator::ErrorCode::NONE);
+
+        if (success)
+            print("Result: %\n", ShortestF64 { result, precision });
+    }
 
+    if (!success)
+        print_expression_error(error);
+
+    free(number_stack);
+    free(op_stack);
     free(elements);
-}
\ No newline at end of file
+
+    return !success;
+}
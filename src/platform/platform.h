@@ -24,6 +24,7 @@ void platform_set_window_style(WindowStyle style);
 void* platform_allocate(u64 size);                   // TODO: Option for aligned memory
 void* platform_reallocate(void* block, u64 size);    // TODO: Option for aligned memory
 void  platform_free(void* block);                    // TODO: Option for aligned memory
+u64   platform_get_allocation_count();               // Allocations and reallocations made by the calling thread
 
 void* platform_zero_memory(void* block, u64 size);
 void* platform_copy_memory(void* dest, const void* source, u64 size);
@@ -31,6 +32,36 @@ void* platform_set_memory(void* dest, s32 value, u64 size);
 
 bool platform_compare_memory(const void* ptr1, const void* ptr2, u64 size);
 
+// Executable Memory Stuff
+
+void* platform_allocate_executable(u64 size);                   // Memory is writable until it's protected
+bool  platform_protect_executable(void* block, u64 size);       // Makes the memory executable and read only
+void  platform_free_executable(void* block, u64 size);
+
+// Thread Stuff
+
+using ThreadFunction = void (*)(void* data);
+
+void* platform_create_thread(ThreadFunction function, void* data);  // Returns null if the thread couldn't be created
+void  platform_join_thread(void* thread);                           // Waits for the thread to finish and frees the handle
+void  platform_yield_thread();
+void  platform_sleep(u32 milliseconds);
+
+u32 platform_get_processor_count();
+
+// Socket Stuff
+
+using PlatformSocket = u64;
+constexpr PlatformSocket PLATFORM_INVALID_SOCKET = ~0Ui64;
+
+PlatformSocket platform_listen_local_socket(const char* path);     // Unix domain socket, replaces an existing file at path
+PlatformSocket platform_accept_socket(PlatformSocket listener);    // Blocks until a client connects
+PlatformSocket platform_connect_local_socket(const char* path);
+void platform_close_socket(PlatformSocket socket);
+
+s64  platform_socket_read(PlatformSocket socket, void* buffer, u64 size);         // Returns 0 once the other side closes, -1 on errors
+bool platform_socket_write(PlatformSocket socket, const void* data, u64 size);    // Writes all of the data
+
 // Time Stuff
 
 void platform_init_clock();
@@ -2,6 +2,9 @@
 
 #ifdef GN_PLATFORM_WINDOWS
 
+#include <winsock2.h>   // Has to be included before windows.h
+#include <afunix.h>
+
 #include "core/types.h"
 #include "core/input.h"
 #include "core/input_processing.h"
@@ -164,16 +167,25 @@ void platform_set_window_style(WindowStyle style)
 }
 
 // Memory Stuff
+static thread_local u64 allocation_count = 0;
+
 void* platform_allocate(u64 size)
 {
+    allocation_count++;
     return malloc(size);
 }
 
 void* platform_reallocate(void* block, u64 size)
 {
+    allocation_count++;
     return realloc(block, size);
 }
 
+u64 platform_get_allocation_count()
+{
+    return allocation_count;
+}
+
 void platform_free(void* block)
 {
     free(block);
@@ -199,6 +211,185 @@ bool platform_compare_memory(const void* ptr1, const void* ptr2, u64 size)
     return memcmp(ptr1, ptr2, size) == 0;
 }
 
+// Executable Memory Stuff
+
+void* platform_allocate_executable(u64 size)
+{
+    return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+}
+
+bool platform_protect_executable(void* block, u64 size)
+{
+    DWORD old_protection;
+    if (!VirtualProtect(block, size, PAGE_EXECUTE_READ, &old_protection))
+        return false;
+
+    return FlushInstructionCache(GetCurrentProcess(), block, size);
+}
+
+void platform_free_executable(void* block, u64 size)
+{
+    VirtualFree(block, 0, MEM_RELEASE);
+}
+
+// Thread Stuff
+
+struct ThreadStart
+{
+    ThreadFunction function;
+    void* data;
+};
+
+static DWORD WINAPI win32_thread_start(LPVOID parameter)
+{
+    ThreadStart start = *(ThreadStart*) parameter;
+    platform_free(parameter);
+
+    start.function(start.data);
+    return 0;
+}
+
+void* platform_create_thread(ThreadFunction function, void* data)
+{
+    ThreadStart* start = (ThreadStart*) platform_allocate(sizeof(ThreadStart));
+    start->function = function;
+    start->data = data;
+
+    HANDLE thread = CreateThread(nullptr, 0, win32_thread_start, start, 0, nullptr);
+    if (!thread)
+        platform_free(start);
+
+    return thread;
+}
+
+void platform_join_thread(void* thread)
+{
+    WaitForSingleObject((HANDLE) thread, INFINITE);
+    CloseHandle((HANDLE) thread);
+}
+
+void platform_yield_thread()
+{
+    SwitchToThread();
+}
+
+void platform_sleep(u32 milliseconds)
+{
+    Sleep(milliseconds);
+}
+
+u32 platform_get_processor_count()
+{
+    // Counts the processors in all groups, GetSystemInfo stops at 64
+    return (u32) GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+}
+
+// Socket Stuff
+
+static bool win32_init_sockets()
+{
+    static bool initialized = false;
+    if (initialized)
+        return true;
+
+    WSADATA wsa_data;
+    initialized = WSAStartup(MAKEWORD(2, 2), &wsa_data) == 0;
+    return initialized;
+}
+
+// Unix domain sockets need Windows 10 (1803) or later
+static bool win32_make_local_address(const char* path, sockaddr_un& address)
+{
+    const u64 length = strlen(path);
+    if (length >= sizeof(address.sun_path))
+        return false;
+
+    address = {};
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path, length + 1);
+
+    return true;
+}
+
+PlatformSocket platform_listen_local_socket(const char* path)
+{
+    sockaddr_un address;
+    if (!win32_init_sockets() || !win32_make_local_address(path, address))
+        return PLATFORM_INVALID_SOCKET;
+
+    SOCKET listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET)
+        return PLATFORM_INVALID_SOCKET;
+
+    DeleteFileA(path);
+
+    if (bind(listener, (sockaddr*) &address, sizeof(address)) == SOCKET_ERROR ||
+        listen(listener, SOMAXCONN) == SOCKET_ERROR)
+    {
+        closesocket(listener);
+        return PLATFORM_INVALID_SOCKET;
+    }
+
+    return (PlatformSocket) listener;
+}
+
+PlatformSocket platform_accept_socket(PlatformSocket listener)
+{
+    SOCKET client = accept((SOCKET) listener, nullptr, nullptr);
+    return (client == INVALID_SOCKET) ? PLATFORM_INVALID_SOCKET : (PlatformSocket) client;
+}
+
+PlatformSocket platform_connect_local_socket(const char* path)
+{
+    sockaddr_un address;
+    if (!win32_init_sockets() || !win32_make_local_address(path, address))
+        return PLATFORM_INVALID_SOCKET;
+
+    SOCKET client = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client == INVALID_SOCKET)
+        return PLATFORM_INVALID_SOCKET;
+
+    if (connect(client, (sockaddr*) &address, sizeof(address)) == SOCKET_ERROR)
+    {
+        closesocket(client);
+        return PLATFORM_INVALID_SOCKET;
+    }
+
+    return (PlatformSocket) client;
+}
+
+void platform_close_socket(PlatformSocket socket)
+{
+    closesocket((SOCKET) socket);
+}
+
+s64 platform_socket_read(PlatformSocket socket, void* buffer, u64 size)
+{
+    const int max_size = (size > INT_MAX) ? INT_MAX : (int) size;
+    const int bytes_read = recv((SOCKET) socket, (char*) buffer, max_size, 0);
+
+    return (bytes_read == SOCKET_ERROR) ? -1 : bytes_read;
+}
+
+bool platform_socket_write(PlatformSocket socket, const void* data, u64 size)
+{
+    const char* bytes = (const char*) data;
+
+    while (size > 0)
+    {
+        const int chunk_size = (size > INT_MAX) ? INT_MAX : (int) size;
+        const int bytes_written = send((SOCKET) socket, bytes, chunk_size, 0);
+
+        if (bytes_written == SOCKET_ERROR)
+            return false;
+
+        bytes += bytes_written;
+        size  -= bytes_written;
+    }
+
+    return true;
+}
+
 // Time Stuff
 
 void platform_init_clock()